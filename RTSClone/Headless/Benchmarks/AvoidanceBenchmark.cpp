@@ -0,0 +1,142 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Brawl.h"
+#include "Benchmarks/Harness.h"
+#include "Core/PathFinding.h"
+#include <iostream>
+#include <optional>
+#include <vector>
+
+//Four AI factions of fifty units brawling in the middle of the map - units pathing round the nodes every other unit
+//holds against paths that ignore them, with units steering round each other as they move. Reports how many paths
+//were searched, the tick time, how often two units of the same faction stood on top of one another and how often a unit
+//stood on a node scenery or a building covers. Steering has to play out the same way every time
+namespace
+{
+	constexpr int WARMUP_TICKS = 3600;
+	constexpr int BRAWL_TICKS = 1800;
+	constexpr int OVERLAP_SAMPLE_TICKS = 30;
+	constexpr float OVERLAP_DISTANCE = static_cast<float>(Globals::NODE_SIZE) / 2.f;
+	constexpr float DELTA_TIME = 1.0f / 60.0f;
+	constexpr unsigned int SEED = 1;
+
+	struct BrawlResult
+	{
+		size_t pathCount	= 0;
+		Harness::Stats tick;
+		int overlaps		= 0;
+		int blocked			= 0;
+		int unitsLeft		= 0;
+		uint64_t stateHash	= Harness::FNV_OFFSET_BASIS;
+	};
+
+	int getOverlaps(const Level& level)
+	{
+		int overlaps = 0;
+		for (const auto& faction : level.getFactions())
+		{
+			const EntityList& entities = faction->getEntities();
+			for (auto a = entities.cbegin(); a != entities.cend(); ++a)
+			{
+				for (auto b = std::next(a); b != entities.cend(); ++b)
+				{
+					if ((*a)->getEntityType() == eEntityType::Unit && (*b)->getEntityType() == eEntityType::Unit &&
+						Globals::getSqrDistance((*a)->getPosition(), (*b)->getPosition()) < OVERLAP_DISTANCE * OVERLAP_DISTANCE)
+					{
+						++overlaps;
+					}
+				}
+			}
+		}
+
+		return overlaps;
+	}
+
+	int getBlocked(const Level& level)
+	{
+		int blocked = 0;
+		for (const auto& faction : level.getFactions())
+		{
+			for (const Entity* entity : faction->getEntities())
+			{
+				if (entity->getEntityType() == eEntityType::Unit && level.getMap().isPositionOccupied(entity->getPosition()))
+				{
+					++blocked;
+				}
+			}
+		}
+
+		return blocked;
+	}
+
+	std::optional<BrawlResult> playBrawl(bool localAvoidance)
+	{
+		PathFinding::getInstance().setLocalAvoidance(localAvoidance);
+		Globals::setRandomSeed(SEED);
+		const int firstID = Harness::getFirstID();
+		std::optional<Level> level;
+		if (!Harness::startBrawl(level, WARMUP_TICKS, DELTA_TIME))
+		{
+			return {};
+		}
+
+		BrawlResult result;
+		const size_t startingPathCount = PathFinding::getInstance().getPathCount();
+		result.tick = Harness::getStats(Harness::playTicks(*level, BRAWL_TICKS, DELTA_TIME, [&result, &level](int tick)
+		{
+			if (tick % OVERLAP_SAMPLE_TICKS == 0)
+			{
+				result.overlaps += getOverlaps(*level);
+				result.blocked += getBlocked(*level);
+			}
+
+			return true;
+		}));
+		result.pathCount = PathFinding::getInstance().getPathCount() - startingPathCount;
+		result.unitsLeft = Brawl::getUnitCount(*level);
+		for (const auto& faction : level->getFactions())
+		{
+			for (const Entity* entity : faction->getEntities())
+			{
+				Harness::hash(result.stateHash, entity->getID() - firstID);
+				Harness::hash(result.stateHash, entity->getHealth());
+				Harness::hash(result.stateHash, entity->getPosition());
+			}
+		}
+
+		return result;
+	}
+
+	void print(const char* name, const BrawlResult& result)
+	{
+		std::cout << "  " << name << result.pathCount << " paths, ";
+		Harness::print(result.tick, "us");
+		std::cout << ", " << result.overlaps << " overlaps, " << result.blocked << " blocked, "
+			<< result.unitsLeft << " units left\n";
+	}
+}
+
+void Benchmarks::runAvoidance()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	const bool localAvoidance = PathFinding::getInstance().isLocalAvoidance();
+	const std::optional<BrawlResult> reserving = playBrawl(false);
+	const std::optional<BrawlResult> avoiding = playBrawl(true);
+	const std::optional<BrawlResult> avoidingAgain = playBrawl(true);
+	PathFinding::getInstance().setLocalAvoidance(localAvoidance);
+	if (!reserving || !avoiding || !avoidingAgain)
+	{
+		return;
+	}
+
+	std::cout << "Four AI faction brawl, " << BRAWL_TICKS << " ticks (" << Brawl::LEVEL_NAME << "), overlaps sampled every "
+		<< OVERLAP_SAMPLE_TICKS << " ticks\n";
+	print("pathing round units:  ", *reserving);
+	print("steering round units: ", *avoiding);
+	std::cout << "  paths " << (reserving->pathCount > 0 ? static_cast<double>(avoiding->pathCount) / reserving->pathCount : 0.0)
+		<< "x, tick time " << (reserving->tick.mean > 0.0 ? avoiding->tick.mean / reserving->tick.mean : 0.0) << "x\n";
+	std::cout << "  steering state " << (avoiding->stateHash == avoidingAgain->stateHash ? "matches" : "DIFFERS") << "\n";
+}
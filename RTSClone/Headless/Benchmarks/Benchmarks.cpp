@@ -0,0 +1,49 @@
+#include "Benchmarks/Benchmarks.h"
+#include <array>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+	using Benchmark = void(*)();
+
+	const std::array<std::pair<std::string_view, Benchmark>, 21> BENCHMARKS =
+	{
+		std::pair<std::string_view, Benchmark>{ "minheap", Benchmarks::runMinHeap },
+		std::pair<std::string_view, Benchmark>{ "pathfinding", Benchmarks::runPathFinding },
+		std::pair<std::string_view, Benchmark>{ "hierarchical", Benchmarks::runHierarchicalPathFinding },
+		std::pair<std::string_view, Benchmark>{ "groupmove", Benchmarks::runGroupMove },
+		std::pair<std::string_view, Benchmark>{ "paththreads", Benchmarks::runPathThreads },
+		std::pair<std::string_view, Benchmark>{ "occupancy", Benchmarks::runOccupancy },
+		std::pair<std::string_view, Benchmark>{ "targeting", Benchmarks::runTargeting },
+		std::pair<std::string_view, Benchmark>{ "entitylookup", Benchmarks::runEntityLookup },
+		std::pair<std::string_view, Benchmark>{ "movement", Benchmarks::runMovement },
+		std::pair<std::string_view, Benchmark>{ "massdeath", Benchmarks::runMassDeath },
+		std::pair<std::string_view, Benchmark>{ "eventqueue", Benchmarks::runEventQueue },
+		std::pair<std::string_view, Benchmark>{ "messenger", Benchmarks::runMessenger },
+		std::pair<std::string_view, Benchmark>{ "fixedtick", Benchmarks::runFixedTick },
+		std::pair<std::string_view, Benchmark>{ "delayedupdate", Benchmarks::runDelayedUpdate },
+		std::pair<std::string_view, Benchmark>{ "factionthreads", Benchmarks::runFactionThreads },
+		std::pair<std::string_view, Benchmark>{ "projectiles", Benchmarks::runProjectiles },
+		std::pair<std::string_view, Benchmark>{ "lineofsight", Benchmarks::runLineOfSight },
+		std::pair<std::string_view, Benchmark>{ "avoidance", Benchmarks::runAvoidance },
+		std::pair<std::string_view, Benchmark>{ "timers", Benchmarks::runTimers },
+		std::pair<std::string_view, Benchmark>{ "minerals", Benchmarks::runMinerals },
+		std::pair<std::string_view, Benchmark>{ "workercollisions", Benchmarks::runWorkerCollisions }
+	};
+}
+
+bool Benchmarks::run(std::string_view benchmarkName)
+{
+	for (const auto& benchmark : BENCHMARKS)
+	{
+		if (benchmark.first == benchmarkName)
+		{
+			benchmark.second();
+			return true;
+		}
+	}
+
+	std::cout << "Unknown benchmark " << benchmarkName << "\n";
+	return false;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string_view>
+
+namespace Benchmarks
+{
+	bool run(std::string_view benchmarkName);
+
+	void runMinHeap();
+	void runPathFinding();
+	void runHierarchicalPathFinding();
+	void runGroupMove();
+	void runPathThreads();
+	void runOccupancy();
+	void runTargeting();
+	void runEntityLookup();
+	void runMovement();
+	void runMassDeath();
+	void runEventQueue();
+	void runMessenger();
+	void runFixedTick();
+	void runDelayedUpdate();
+	void runFactionThreads();
+	void runProjectiles();
+	void runLineOfSight();
+	void runAvoidance();
+	void runTimers();
+	void runMinerals();
+	void runWorkerCollisions();
+}
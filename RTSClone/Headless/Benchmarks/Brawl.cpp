@@ -0,0 +1,126 @@
+#include "Benchmarks/Brawl.h"
+#include "Core/Map.h"
+#include "Entities/EntitySpawnerBuilding.h"
+#include <algorithm>
+
+namespace
+{
+	constexpr int FACTION_COUNT = 4;
+	constexpr int STARTING_POPULATION = 1000;
+	constexpr int WAVE_SIZE = static_cast<int>(Globals::MAX_UNITS);
+	constexpr float WAVE_START = 0.5f;
+
+	std::vector<int> createWave(Faction& faction, const Map& map, const glm::vec3& center)
+	{
+		std::vector<int> unitIDs;
+		for (const auto& position : Brawl::getFreePositions(map, center, WAVE_SIZE))
+		{
+			EntityToSpawnFromBuilding entityToSpawn;
+			entityToSpawn.position = position;
+			entityToSpawn.type = eEntityType::Unit;
+			if (const Entity* unit = faction.createUnit(entityToSpawn, map))
+			{
+				unitIDs.push_back(unit->getID());
+			}
+		}
+
+		return unitIDs;
+	}
+}
+
+std::optional<LevelDetailsFromFile> Brawl::load()
+{
+	std::optional<LevelDetailsFromFile> levelDetails = Level::load(LEVEL_NAME, Globals::WINDOW_SIZE);
+	if (!levelDetails || levelDetails->factionCount < FACTION_COUNT)
+	{
+		return {};
+	}
+
+	levelDetails->factionStartingPopulation = STARTING_POPULATION;
+	return levelDetails;
+}
+
+std::vector<glm::vec3> Brawl::getFreePositions(const Map& map, const glm::vec3& center, int count)
+{
+	std::vector<glm::vec3> positions;
+	const glm::ivec2 centerOnGrid = Globals::convertToGridPosition(center);
+	for (int ring = 0; ring < map.getSize().x && static_cast<int>(positions.size()) < count; ++ring)
+	{
+		for (int x = -ring; x <= ring; ++x)
+		{
+			for (int y = -ring; y <= ring; ++y)
+			{
+				const glm::ivec2 position = centerOnGrid + glm::ivec2(x, y);
+				if (std::max(std::abs(x), std::abs(y)) == ring && static_cast<int>(positions.size()) < count &&
+					map.isWithinBounds(position) && !map.isPositionOccupied(position) &&
+					map.isPositionOnUnitMapAvailable(position, Globals::INVALID_ENTITY_ID))
+				{
+					positions.push_back(Globals::convertToWorldPosition(position));
+				}
+			}
+		}
+	}
+
+	return positions;
+}
+
+int Brawl::getUnitCount(const Level& level)
+{
+	int unitCount = 0;
+	for (const auto& faction : level.getFactions())
+	{
+		unitCount += static_cast<int>(std::count_if(faction->getEntities().cbegin(), faction->getEntities().cend(), [](const Entity* entity)
+		{
+			return entity->getEntityType() == eEntityType::Unit;
+		}));
+	}
+
+	return unitCount;
+}
+
+bool Brawl::start(Level& level, int warmupTicks, float deltaTime)
+{
+	for (int tick = 0; tick < warmupTicks; ++tick)
+	{
+		level.update(deltaTime);
+	}
+
+	const Map& map = level.getMap();
+	const glm::vec3 center = Globals::convertToWorldPosition(map.getSize() / 2);
+	for (const auto& faction : level.getFactions())
+	{
+		if (!faction || !faction->getMainHeadquarters())
+		{
+			return false;
+		}
+
+		Level::add_event(GameEvent::create<AddFactionResourcesEvent>(
+			{ Globals::UNIT_RESOURCE_COST * WAVE_SIZE, faction->getController() }));
+	}
+	level.update(deltaTime);
+
+	std::vector<std::vector<int>> waveIDs;
+	for (const auto& faction : level.getFactions())
+	{
+		const glm::vec3 headquarters = faction->getMainHeadquarters()->getPosition();
+		waveIDs.push_back(createWave(*faction, map, Globals::convertToWorldPosition(
+			Globals::convertToGridPosition(headquarters + (center - headquarters) * WAVE_START))));
+	}
+
+	//Spawned idle - an AI faction puts them into squads and raises idle events for them the following tick
+	level.update(deltaTime);
+	const std::vector<glm::vec3> destinations = getFreePositions(map, center, WAVE_SIZE * static_cast<int>(waveIDs.size()));
+	for (size_t i = 0; i < destinations.size(); ++i)
+	{
+		const std::vector<int>& wave = waveIDs[i % waveIDs.size()];
+		if (i / waveIDs.size() < wave.size())
+		{
+			if (Entity* unit = level.getFactions()[i % waveIDs.size()]->get_entity(wave[i / waveIDs.size()]))
+			{
+				unit->MoveTo(destinations[i], map, false);
+			}
+		}
+	}
+
+	return true;
+}
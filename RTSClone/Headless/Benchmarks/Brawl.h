@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Core/Level.h"
+#include <optional>
+#include <string_view>
+#include <vector>
+
+//Late game staged on a four faction map - every faction sends a full wave of units into the middle of it.
+//The AI doesn't build units of its own so benchmarks needing combat start one of these
+namespace Brawl
+{
+	constexpr std::string_view LEVEL_NAME = "Level1.txt";
+
+	//Four faction level with enough population for the waves, empty if it can't be loaded
+	std::optional<LevelDetailsFromFile> load();
+
+	//Closest free nodes to the center, ring by ring
+	std::vector<glm::vec3> getFreePositions(const Map& map, const glm::vec3& center, int count);
+	int getUnitCount(const Level& level);
+
+	//Plays the opening at the given step then sends the waves in, each unit to its own node so none of them
+	//search for a way to one another holds
+	bool start(Level& level, int warmupTicks, float deltaTime);
+}
@@ -0,0 +1,103 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Brawl.h"
+#include "Benchmarks/Harness.h"
+#include "Core/PathFinding.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+//Tick times through a late game brawl with every unit's delayed update landing on the same tick of each
+//period, as before, against them spread over every tick of it by ID. Prints a histogram of the tick times
+//and the median of each tick within the period, where the spike shows. Units don't steer round each other, as
+//the avoidance pass every tick pays for would otherwise hide it
+namespace
+{
+	constexpr int WARMUP_TICKS = 3600;
+	constexpr int BRAWL_TICKS = 2400;
+	constexpr float DELTA_TIME = 1.0f / 60.0f;
+	constexpr int DELAYED_UPDATE_TICKS = 6;
+	constexpr int HISTOGRAM_WIDTH = 50;
+	constexpr int HISTOGRAM_BINS = 16;
+	constexpr double HISTOGRAM_FIRST_BOUND = 8.0;
+
+	//Microseconds
+	std::optional<std::vector<double>> play(bool staggered)
+	{
+		std::optional<Level> level;
+		if (!Harness::startBrawl(level, WARMUP_TICKS, DELTA_TIME, [staggered](Level& brawl)
+		{
+			PathFinding::getInstance().setLocalAvoidance(false);
+			brawl.setDelayedUpdateStaggered(staggered);
+		}))
+		{
+			return {};
+		}
+
+		return Harness::playTicks(*level, BRAWL_TICKS, DELTA_TIME);
+	}
+
+	void printTickTimes(const std::vector<double>& tickTimes)
+	{
+		//Doubling bins, the last holds everything over its bound
+		std::array<int, HISTOGRAM_BINS> histogram = {};
+		for (size_t i = 0; i < tickTimes.size(); ++i)
+		{
+			int bin = 0;
+			for (double bound = HISTOGRAM_FIRST_BOUND; bin < HISTOGRAM_BINS - 1 && tickTimes[i] >= bound; bound *= 2.0)
+			{
+				++bin;
+			}
+			++histogram[bin];
+		}
+
+		std::cout << "    ";
+		Harness::print(Harness::getStats(tickTimes), "us");
+		std::cout << "\n";
+		std::cout << "    median by tick of the period:";
+		for (size_t phase = 0; phase < DELAYED_UPDATE_TICKS; ++phase)
+		{
+			std::vector<double> phaseTickTimes;
+			for (size_t i = phase; i < tickTimes.size(); i += DELAYED_UPDATE_TICKS)
+			{
+				phaseTickTimes.push_back(tickTimes[i]);
+			}
+			std::cout << " " << Harness::getStats(std::move(phaseTickTimes)).median;
+		}
+		std::cout << " us\n";
+
+		const int mostTicks = *std::max_element(histogram.cbegin(), histogram.cend());
+		double bound = HISTOGRAM_FIRST_BOUND;
+		for (int i = 0; i < HISTOGRAM_BINS; ++i, bound *= 2.0)
+		{
+			const std::string label = (i < HISTOGRAM_BINS - 1 ? "< " : ">= ") + std::to_string(static_cast<int>(i < HISTOGRAM_BINS - 1 ? bound : bound / 2.0));
+			std::cout << "    " << label << std::string(10 - label.size(), ' ') << " us | "
+				<< std::string(histogram[i] * HISTOGRAM_WIDTH / mostTicks, '#') << " " << histogram[i] << "\n";
+		}
+	}
+}
+
+void Benchmarks::runDelayedUpdate()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	const bool localAvoidance = PathFinding::getInstance().isLocalAvoidance();
+	const std::optional<std::vector<double>> batched = play(false);
+	const std::optional<std::vector<double>> staggered = play(true);
+	PathFinding::getInstance().setLocalAvoidance(localAvoidance);
+	if (!batched || !staggered || batched->empty() || staggered->empty())
+	{
+		return;
+	}
+
+	std::cout << "Tick times, " << BRAWL_TICKS << " ticks of a four way brawl (" << Brawl::LEVEL_NAME << ")\n";
+	std::cout << "  every delayed update on one tick:\n";
+	printTickTimes(*batched);
+	std::cout << "  staggered over " << DELAYED_UPDATE_TICKS << " ticks:\n";
+	printTickTimes(*staggered);
+}
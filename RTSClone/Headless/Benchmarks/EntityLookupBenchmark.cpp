@@ -0,0 +1,114 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Benchmarks/PathFindingProbe.h"
+#include "Core/EntityLookup.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+//Resolving projectile targets by ID from EntityLookup against the previous search over every entity the
+//target faction owns. Each tick every projectile in flight looks its target up to test for a hit, and every
+//hit looks it up again when its TakeDamage event is handled - both have to resolve the same entities
+namespace
+{
+	constexpr int MAP_SIZE = 128;
+	constexpr int TICKS = 2000;
+	constexpr unsigned int SEED = 1;
+	constexpr float HIT_CHANCE = 0.1f;
+	const std::array<int, 3> ENTITY_COUNTS = { 50, 150, 500 };
+	const std::array<int, 2> PROJECTILE_COUNTS = { 100, 500 };
+
+	struct InFlightProjectile
+	{
+		int targetID = 0;
+		bool hit = false;
+	};
+
+	//Previous Faction::get_entity
+	const Entity* getEntityPerEntity(const std::vector<const Entity*>& entities, int ID)
+	{
+		const auto entity = std::find_if(entities.cbegin(), entities.cend(), [ID](const auto& entity)
+		{
+			return entity->getID() == ID;
+		});
+
+		return entity != entities.cend() ? *entity : nullptr;
+	}
+
+	template <typename Function>
+	double getEventsPerSecond(const std::vector<std::vector<InFlightProjectile>>& ticks, Function function, int& checksum)
+	{
+		checksum = 0;
+		int events = 0;
+		const double seconds = Harness::measure([&ticks, &function, &checksum, &events]()
+		{
+			for (const auto& projectiles : ticks)
+			{
+				for (const auto& projectile : projectiles)
+				{
+					const Entity* target = function(projectile.targetID);
+					if (target && projectile.hit && function(projectile.targetID))
+					{
+						checksum += target->getID();
+						++events;
+					}
+				}
+			}
+		});
+		return seconds > 0.0 ? static_cast<double>(events) / seconds / 1000000.0 : 0.0;
+	}
+}
+
+void Benchmarks::runEntityLookup()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	std::cout << "Entity lookup (" << TICKS << " ticks, " << HIT_CHANCE * 100.0f << "% of projectiles hit each tick)\n";
+	for (int entityCount : ENTITY_COUNTS)
+	{
+		std::mt19937 randomEngine(SEED);
+		std::uniform_int_distribution<int> positionDistribution(0, MAP_SIZE - 1);
+		std::uniform_int_distribution<int> entityDistribution(0, entityCount - 1);
+		std::bernoulli_distribution hitDistribution(HIT_CHANCE);
+		std::vector<std::unique_ptr<PathFindingProbe>> probes;
+		std::vector<const Entity*> entities;
+		EntityLookup entityLookup;
+		for (int i = 0; i < entityCount; ++i)
+		{
+			probes.push_back(std::make_unique<PathFindingProbe>());
+			probes.back()->setGridPosition({ positionDistribution(randomEngine), positionDistribution(randomEngine) });
+			entities.push_back(probes.back().get());
+			entityLookup.set(*probes.back());
+		}
+
+		for (int projectileCount : PROJECTILE_COUNTS)
+		{
+			std::vector<std::vector<InFlightProjectile>> ticks(TICKS, std::vector<InFlightProjectile>(projectileCount));
+			for (auto& projectiles : ticks)
+			{
+				for (auto& projectile : projectiles)
+				{
+					projectile.targetID = entities[entityDistribution(randomEngine)]->getID();
+					projectile.hit = hitDistribution(randomEngine);
+				}
+			}
+
+			int perEntityChecksum = 0;
+			int checksum = 0;
+			const double perEntity = getEventsPerSecond(ticks, [&entities](int ID) { return getEntityPerEntity(entities, ID); },
+				perEntityChecksum);
+			const double lookup = getEventsPerSecond(ticks, [&entityLookup](int ID) { return entityLookup.get(ID); }, checksum);
+
+			std::cout << "  " << entityCount << " entities, " << projectileCount << " projectiles in flight\n";
+			std::cout << "    per entity: " << perEntity << " M TakeDamage events/s\n";
+			std::cout << "    lookup:     " << lookup << " M TakeDamage events/s, speedup " << (perEntity > 0.0 ? lookup / perEntity : 0.0)
+				<< (checksum == perEntityChecksum ? "" : " (results differ from per entity)") << "\n";
+		}
+	}
+}
@@ -0,0 +1,186 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Brawl.h"
+#include "Benchmarks/Harness.h"
+#include "Events/GameEventQueue.h"
+#include "Events/GameEvents.h"
+#include <algorithm>
+#include <iostream>
+#include <optional>
+#include <queue>
+#include <random>
+#include <vector>
+
+//Game events in a late game brawl. Reports how many events each frame raises, how many of them are damage and the rate they're handled at.
+//Then the cost of queueing and draining the same stream of events through the previous std::queue against
+//GameEventQueue, without handling them
+namespace
+{
+	constexpr int WAVE_SIZE = static_cast<int>(Globals::MAX_UNITS);
+	constexpr int WARMUP_TICKS = 3600;
+	constexpr int BRAWL_TICKS = 2400;
+	constexpr float DELTA_TIME = 1.0f / 60.0f;
+	constexpr int QUEUE_FRAMES = 10000;
+	constexpr int EVENTS_PER_FRAME = 200;
+	constexpr int DAMAGE = 1;
+	constexpr unsigned int SEED = 1;
+
+	void runBrawl()
+	{
+		std::optional<Level> level;
+		if (!Harness::startBrawl(level, WARMUP_TICKS, DELTA_TIME))
+		{
+			return;
+		}
+
+		//Through the first clash, before the survivors scatter chasing one another
+		const int startingUnitCount = Brawl::getUnitCount(*level);
+		long long handled = 0;
+		long long takeDamage = 0;
+		int maxHandled = 0;
+		double eventMicroseconds = 0.0;
+		const std::vector<double> tickTimes = Harness::playTicks(*level, BRAWL_TICKS, DELTA_TIME,
+			[&handled, &takeDamage, &maxHandled, &eventMicroseconds, &level](int)
+		{
+			const GameEventStats& gameEventStats = level->getGameEventStats();
+			handled += gameEventStats.handled;
+			takeDamage += gameEventStats.takeDamage;
+			maxHandled = std::max(maxHandled, gameEventStats.handled);
+			eventMicroseconds += gameEventStats.microseconds;
+			return true;
+		});
+		const int ticks = static_cast<int>(tickTimes.size());
+
+		std::cout << "Four way brawl, " << startingUnitCount << " units (" << Brawl::LEVEL_NAME << ")\n";
+		std::cout << "  " << startingUnitCount - Brawl::getUnitCount(*level) << " units died in " << ticks << " ticks, tick ";
+		Harness::print(Harness::getStats(tickTimes), "us");
+		std::cout << "\n";
+		std::cout << "  events: " << handled << ", per tick mean: " << (ticks > 0 ? static_cast<double>(handled) / ticks : 0.0)
+			<< ", max: " << maxHandled << ", damage: " << (handled > 0 ? 100.0 * takeDamage / handled : 0.0) << "%\n";
+		std::cout << "  handled: " << (eventMicroseconds > 0.0 ? handled * 1000000.0 / eventMicroseconds : 0.0) << " events/sec, "
+			<< (ticks > 0 ? eventMicroseconds / ticks : 0.0) << " us per tick\n";
+	}
+
+	//Mostly damage spread over four factions, then projectiles, then idle units - as a brawl raises them
+	std::vector<GameEvent> createEventStream(std::mt19937& randomEngine)
+	{
+		std::uniform_int_distribution<int> typeDistribution(0, 9);
+		std::uniform_int_distribution<int> factionDistribution(0, 3);
+		std::uniform_int_distribution<int> IDDistribution(0, WAVE_SIZE * 4);
+		std::vector<GameEvent> gameEvents;
+		gameEvents.reserve(EVENTS_PER_FRAME);
+		for (int i = 0; i < EVENTS_PER_FRAME; ++i)
+		{
+			const int type = typeDistribution(randomEngine);
+			const eFactionController faction = static_cast<eFactionController>(factionDistribution(randomEngine));
+			if (type < 6)
+			{
+				gameEvents.push_back(GameEvent::create<TakeDamageEvent>({ eFactionController::Player, IDDistribution(randomEngine),
+					eEntityType::Unit, faction, IDDistribution(randomEngine), DAMAGE }));
+			}
+			else if (type < 9)
+			{
+				gameEvents.push_back(GameEvent::create<SpawnProjectileEvent>({ eFactionController::Player, IDDistribution(randomEngine),
+					eEntityType::Unit, faction, IDDistribution(randomEngine), eEntityType::Unit, DAMAGE, {}, {} }));
+			}
+			else
+			{
+				gameEvents.push_back(GameEvent::create<EntityIdleEvent>({ IDDistribution(randomEngine), faction }));
+			}
+		}
+
+		return gameEvents;
+	}
+
+	void runQueue()
+	{
+		std::mt19937 randomEngine(SEED);
+		const std::vector<GameEvent> gameEvents = createEventStream(randomEngine);
+
+		//Summed so neither drain is optimized away
+		long long previousSum = 0;
+		std::queue<GameEvent> previousQueue;
+		const double previousDuration = Harness::measure<std::nano>([&gameEvents, &previousSum, &previousQueue]()
+		{
+			for (int frame = 0; frame < QUEUE_FRAMES; ++frame)
+			{
+				for (const auto& gameEvent : gameEvents)
+				{
+					previousQueue.push(gameEvent);
+				}
+
+				const size_t size = previousQueue.size();
+				for (size_t i = 0; i < size; ++i)
+				{
+					const GameEvent& gameEvent = previousQueue.front();
+					switch (gameEvent.type)
+					{
+					case eGameEventType::TakeDamage:
+						previousSum += gameEvent.data.takeDamage.targetID;
+						break;
+					case eGameEventType::SpawnProjectile:
+						previousSum += gameEvent.data.spawnProjectile.targetID;
+						break;
+					case eGameEventType::EntityIdle:
+						previousSum += gameEvent.data.entityIdle.entityID;
+						break;
+					default:
+						break;
+					}
+					previousQueue.pop();
+				}
+			}
+		});
+
+		long long sum = 0;
+		GameEventQueue addQueue;
+		GameEventQueue handleQueue;
+		const double duration = Harness::measure<std::nano>([&gameEvents, &sum, &addQueue, &handleQueue]()
+		{
+			for (int frame = 0; frame < QUEUE_FRAMES; ++frame)
+			{
+				for (const auto& gameEvent : gameEvents)
+				{
+					addQueue.add(gameEvent);
+				}
+
+				handleQueue.swap(addQueue);
+				for (int faction = 0; faction < 4; ++faction)
+				{
+					for (const auto& takeDamageEvent : handleQueue.getTakeDamageEvents(static_cast<eFactionController>(faction)))
+					{
+						sum += takeDamageEvent.targetID;
+					}
+					for (const auto& entityIdleEvent : handleQueue.getEntityIdleEvents(static_cast<eFactionController>(faction)))
+					{
+						sum += entityIdleEvent.entityID;
+					}
+				}
+				for (const auto& spawnProjectileEvent : handleQueue.getSpawnProjectileEvents())
+				{
+					sum += spawnProjectileEvent.targetID;
+				}
+				handleQueue.clear();
+			}
+		});
+
+		const double eventCount = static_cast<double>(QUEUE_FRAMES) * EVENTS_PER_FRAME;
+		const double previousNanoseconds = previousDuration / eventCount;
+		const double nanoseconds = duration / eventCount;
+		std::cout << "Queueing " << EVENTS_PER_FRAME << " events a frame (" << QUEUE_FRAMES << " frames)\n";
+		std::cout << "  std::queue:     " << previousNanoseconds << " ns/event\n";
+		std::cout << "  GameEventQueue: " << nanoseconds << " ns/event, speedup "
+			<< (nanoseconds > 0.0 ? previousNanoseconds / nanoseconds : 0.0)
+			<< (sum == previousSum ? "" : " (events differ from std::queue)") << "\n";
+	}
+}
+
+void Benchmarks::runEventQueue()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	runBrawl();
+	runQueue();
+}
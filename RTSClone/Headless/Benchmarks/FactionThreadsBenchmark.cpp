@@ -0,0 +1,194 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Brawl.h"
+#include "Benchmarks/Harness.h"
+#include "Core/MovementCore.h"
+#include "Core/PathFinding.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+//Factions handed to the path thread pool. First a late game brawl between four AI factions played in turn, as it
+//is below the level's parallel movement threshold, and then handed to a growing number of threads, each faction moved
+//and searched for the units in range of it by a job of its own - each has to end in the same state as playing it in
+//turn. Then the movement pass alone for four factions of growing size, to show where moving them at once starts to
+//pay for handing the factions to the pool
+namespace
+{
+	constexpr int WARMUP_TICKS = 3600;
+	constexpr int BRAWL_TICKS = 1200;
+	constexpr float DELTA_TIME = 1.0f / 60.0f;
+	constexpr int FACTION_COUNT = 4;
+	constexpr int MAP_SIZE = 128;
+	constexpr int PATH_LENGTH = 64;
+	constexpr int MOVEMENT_TICKS = 1000;
+	constexpr float MOVEMENT_SPEED = 10.f;
+	constexpr unsigned int SEED = 1;
+	const std::array<int, 3> THREAD_COUNTS = { 1, 2, 4 };
+	const std::array<int, 5> ENTITIES_PER_FACTION = { 50, 250, 1000, 4000, 16000 };
+
+	struct BrawlResult
+	{
+		Harness::Stats tick;
+		uint64_t stateHash	= Harness::FNV_OFFSET_BASIS;
+	};
+
+	uint64_t getStateHash(const Level& level, int firstID)
+	{
+		uint64_t stateHash = Harness::FNV_OFFSET_BASIS;
+		for (const auto& faction : level.getFactions())
+		{
+			Harness::hash(stateHash, faction->getController());
+			Harness::hash(stateHash, faction->getCurrentResourceAmount());
+			for (const Entity* entity : faction->getEntities())
+			{
+				Harness::hash(stateHash, entity->getID() - firstID);
+				Harness::hash(stateHash, entity->getHealth());
+				Harness::hash(stateHash, entity->getPosition());
+				Harness::hash(stateHash, entity->getRotation());
+			}
+		}
+
+		return stateHash;
+	}
+
+	//Handed to the pool once the level holds parallelMovementEntities
+	std::optional<BrawlResult> playBrawl(size_t parallelMovementEntities, int threadCount)
+	{
+		PathFinding::getInstance().setThreadCount(threadCount);
+		Globals::setRandomSeed(SEED);
+		const int firstID = Harness::getFirstID();
+		std::optional<Level> level;
+		if (!Harness::startBrawl(level, WARMUP_TICKS, DELTA_TIME, [parallelMovementEntities](Level& level)
+		{
+			level.setParallelMovementEntities(parallelMovementEntities);
+		}))
+		{
+			return {};
+		}
+
+		BrawlResult result;
+		result.tick = Harness::getStats(Harness::playTicks(*level, BRAWL_TICKS, DELTA_TIME));
+		result.stateHash = getStateHash(*level, firstID);
+
+		return result;
+	}
+
+	bool runBrawls()
+	{
+		const std::optional<BrawlResult> inTurn = playBrawl(std::numeric_limits<size_t>::max(), 1);
+		if (!inTurn)
+		{
+			return false;
+		}
+
+		std::cout << "Four AI faction brawl, " << BRAWL_TICKS << " ticks (" << Brawl::LEVEL_NAME << ")\n";
+		std::cout << "  in turn:            ";
+		Harness::print(inTurn->tick, "us");
+		std::cout << "\n";
+		bool matching = true;
+		for (int threadCount : THREAD_COUNTS)
+		{
+			const std::optional<BrawlResult> result = playBrawl(0, threadCount);
+			matching = matching && result && result->stateHash == inTurn->stateHash;
+			if (result)
+			{
+				std::cout << "  at once, " << threadCount << " threads: ";
+				Harness::print(result->tick, "us");
+				std::cout << " (" << (result->tick.mean > 0.0 ? inTurn->tick.mean / result->tick.mean : 0.0) << "x)" << (result->stateHash == inTurn->stateHash ? "" : " (state differs)") << "\n";
+			}
+		}
+
+		std::cout << "  state " << (matching ? "matches" : "DIFFERS") << "\n";
+		return matching;
+	}
+
+	//Random walks over neighbouring nodes, long enough that nothing arrives
+	void addMovingEntities(MovementCore& movementCore, int entityCount, std::mt19937& randomEngine)
+	{
+		std::uniform_int_distribution<int> positionDistribution(0, MAP_SIZE - 1);
+		std::uniform_int_distribution<int> directionDistribution(-1, 1);
+		std::vector<glm::vec3> path;
+		for (int i = 0; i < entityCount; ++i)
+		{
+			glm::ivec2 position(positionDistribution(randomEngine), positionDistribution(randomEngine));
+			const glm::vec3 startingPosition = Globals::convertToWorldPosition(position);
+			path.clear();
+			for (int waypoint = 0; waypoint < PATH_LENGTH; ++waypoint)
+			{
+				glm::ivec2 direction(directionDistribution(randomEngine), directionDistribution(randomEngine));
+				position += direction == glm::ivec2(0) ? glm::ivec2(1, 0) : direction;
+				path.push_back(Globals::convertToWorldPosition(position));
+			}
+
+			std::reverse(path.begin(), path.end());
+			movementCore.setPath(movementCore.add(startingPosition, MOVEMENT_SPEED), startingPosition, 0.0f, path);
+		}
+	}
+
+	double getMovementMicroseconds(int entitiesPerFaction, int threadCount)
+	{
+		std::mt19937 randomEngine(SEED);
+		std::vector<std::unique_ptr<MovementCore>> movementCores;
+		for (int faction = 0; faction < FACTION_COUNT; ++faction)
+		{
+			movementCores.push_back(std::make_unique<MovementCore>());
+			addMovingEntities(*movementCores.back(), entitiesPerFaction, randomEngine);
+		}
+
+		PathFinding::getInstance().setThreadCount(threadCount);
+		return Harness::measure<std::micro>([threadCount, &movementCores]()
+		{
+			for (int tick = 0; tick < MOVEMENT_TICKS; ++tick)
+			{
+				if (threadCount == 0)
+				{
+					for (auto& movementCore : movementCores)
+					{
+						movementCore->integrate(DELTA_TIME);
+					}
+				}
+				else
+				{
+					PathFinding::getInstance().runJobs(movementCores.size(), [&movementCores](size_t factionIndex, int)
+					{
+						movementCores[factionIndex]->integrate(DELTA_TIME);
+					});
+				}
+			}
+		}) / MOVEMENT_TICKS;
+	}
+
+	void runMovementPasses()
+	{
+		std::cout << "Movement pass, " << FACTION_COUNT << " factions (" << MOVEMENT_TICKS << " ticks)\n";
+		for (int entitiesPerFaction : ENTITIES_PER_FACTION)
+		{
+			const double inTurn = getMovementMicroseconds(entitiesPerFaction, 0);
+			std::cout << "  " << entitiesPerFaction << " per faction: in turn " << inTurn << " us";
+			for (int threadCount : THREAD_COUNTS)
+			{
+				const double atOnce = getMovementMicroseconds(entitiesPerFaction, threadCount);
+				std::cout << ", " << threadCount << " threads " << atOnce << " us (" << (atOnce > 0.0 ? inTurn / atOnce : 0.0) << "x)";
+			}
+			std::cout << "\n";
+		}
+	}
+}
+
+void Benchmarks::runFactionThreads()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	const int threadCount = PathFinding::getInstance().getThreadCount();
+	runBrawls();
+	runMovementPasses();
+	PathFinding::getInstance().setThreadCount(threadCount);
+}
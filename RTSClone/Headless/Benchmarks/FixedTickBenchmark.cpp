@@ -0,0 +1,86 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Brawl.h"
+#include "Benchmarks/Harness.h"
+#include <array>
+#include <iostream>
+#include <optional>
+
+//Simulation CPU time per rendered frame at common display rates - the previous loop stepping the whole
+//simulation once a frame by however long the frame took, against Level::updateFrame stepping it at its
+//fixed rate and leaving the remainder to interpolation. Both play the same late game brawl
+namespace
+{
+	constexpr int WARMUP_TICKS = 3600;
+	constexpr float WARMUP_DELTA_TIME = 1.0f / 60.0f;
+	constexpr int GAME_SECONDS = 40;
+	const std::array<int, 2> DISPLAY_RATES = { 60, 144 };
+
+	struct FrameStats
+	{
+		int frames			= 0;
+		int ticks			= 0;
+		double seconds		= 0.0;
+	};
+
+	template <typename UpdateFrame>
+	std::optional<FrameStats> play(int displayRate, UpdateFrame updateFrame)
+	{
+		//Same setup for both loops, stepped as the previous loop did at 60 Hz
+		std::optional<Level> level;
+		if (!Harness::startBrawl(level, WARMUP_TICKS, WARMUP_DELTA_TIME))
+		{
+			return {};
+		}
+
+		const float frameTime = 1.0f / displayRate;
+		FrameStats frameStats;
+		for (; frameStats.frames < GAME_SECONDS * displayRate && !level->getWinningFaction(); ++frameStats.frames)
+		{
+			frameStats.seconds += Harness::measure([&frameStats, &updateFrame, &level, frameTime]()
+			{
+				frameStats.ticks += updateFrame(*level, frameTime);
+			});
+		}
+
+		return frameStats;
+	}
+
+	double getMillisecondsPerFrame(const FrameStats& frameStats)
+	{
+		return frameStats.frames > 0 ? frameStats.seconds * 1000.0 / frameStats.frames : 0.0;
+	}
+}
+
+void Benchmarks::runFixedTick()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	std::cout << "Simulation time per rendered frame, " << GAME_SECONDS << " game seconds of a four way brawl (" << Brawl::LEVEL_NAME << ")\n";
+	for (int displayRate : DISPLAY_RATES)
+	{
+		const std::optional<FrameStats> variable = play(displayRate, [](Level& level, float frameTime)
+		{
+			level.update(frameTime);
+			return 1;
+		});
+		const std::optional<FrameStats> fixed = play(displayRate, [](Level& level, float frameTime)
+		{
+			return level.updateFrame(frameTime);
+		});
+		if (!variable || !fixed)
+		{
+			return;
+		}
+
+		const double variableMilliseconds = getMillisecondsPerFrame(*variable);
+		const double fixedMilliseconds = getMillisecondsPerFrame(*fixed);
+		std::cout << "  " << displayRate << " Hz\n";
+		std::cout << "    tick every frame: " << variableMilliseconds << " ms/frame, " << variable->ticks << " ticks\n";
+		std::cout << "    fixed tick:       " << fixedMilliseconds << " ms/frame, " << fixed->ticks << " ticks, saved "
+			<< variableMilliseconds - fixedMilliseconds << " ms/frame ("
+			<< (variableMilliseconds > 0.0 ? 100.0 * (variableMilliseconds - fixedMilliseconds) / variableMilliseconds : 0.0) << "%)\n";
+	}
+}
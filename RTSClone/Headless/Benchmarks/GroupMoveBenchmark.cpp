@@ -0,0 +1,152 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Benchmarks/PathFindingProbe.h"
+#include "Core/Map.h"
+#include "Core/PathFinding.h"
+#include "Model/AdjacentPositions.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+//Time taken to path a whole selection in the input frame a move order is given, without and with the shared flow field.
+//Groups are the free positions closest to a random point and are ordered to a random far away position,
+//each entity keeping its offset from the average position like FactionPlayerSelectedEntities::Move
+namespace
+{
+	constexpr int ORDER_COUNT = 40;
+	constexpr unsigned int SEED = 1;
+	const std::array<int, 3> GROUP_SIZES = { 1, 10, 50 };
+	const std::array<std::string_view, 3> LEVEL_NAMES = { "Level1.txt", "Level2.txt", "Level4.txt" };
+
+	struct Order
+	{
+		std::vector<glm::ivec2> positions;
+		glm::ivec2 destination;
+	};
+
+	struct OrderResults
+	{
+		std::vector<double> milliseconds;
+		double pathLength = 0.0;
+		int found = 0;
+	};
+
+	std::vector<Order> createOrders(const std::vector<glm::ivec2>& freePositions, int groupSize, const Map& map)
+	{
+		std::mt19937 randomEngine(SEED);
+		std::uniform_int_distribution<size_t> freePositionDistribution(0, freePositions.size() - 1);
+		std::vector<glm::ivec2> sortedPositions = freePositions;
+		std::vector<Order> orders;
+		while (static_cast<int>(orders.size()) < ORDER_COUNT)
+		{
+			const glm::ivec2 centre = freePositions[freePositionDistribution(randomEngine)];
+			const glm::ivec2 destination = freePositions[freePositionDistribution(randomEngine)];
+			if (Globals::getDistance(destination, centre) < static_cast<float>(std::max(map.getSize().x, map.getSize().y)) / 3.0f)
+			{
+				continue;
+			}
+
+			std::partial_sort(sortedPositions.begin(), sortedPositions.begin() + groupSize, sortedPositions.end(), [centre](const auto& a, const auto& b)
+			{
+				return Globals::getSqrDistance(glm::vec2(a), glm::vec2(centre)) < Globals::getSqrDistance(glm::vec2(b), glm::vec2(centre));
+			});
+			orders.push_back({ { sortedPositions.begin(), sortedPositions.begin() + groupSize }, destination });
+		}
+
+		return orders;
+	}
+
+	OrderResults runOrders(const std::vector<Order>& orders, std::vector<PathFindingProbe>& probes, const Map& map, bool flowField)
+	{
+		OrderResults results;
+		std::vector<glm::vec3> path;
+		for (const auto& order : orders)
+		{
+			glm::vec3 averagePosition(0.0f);
+			for (size_t i = 0; i < order.positions.size(); ++i)
+			{
+				probes[i].setGridPosition(order.positions[i]);
+				averagePosition += probes[i].getPosition() / static_cast<float>(order.positions.size());
+			}
+
+			const glm::vec3 position = Globals::convertToWorldPosition(order.destination);
+			results.milliseconds.push_back(Harness::measure<std::milli>([&order, &probes, &map, &path, &results, flowField, position, averagePosition]()
+			{
+				if (flowField && order.positions.size() > 1)
+				{
+					PathFinding::getInstance().setFlowFieldGoal(position, averagePosition, map);
+				}
+				for (size_t i = 0; i < order.positions.size(); ++i)
+				{
+					const glm::vec3 destination = position - (averagePosition - probes[i].getPosition());
+					PathFinding::getInstance().getPathToPosition(probes[i], destination, path, map, createAdjacentPositions(map));
+					if (!path.empty())
+					{
+						++results.found;
+						glm::vec3 previousPosition = probes[i].getPosition();
+						for (auto pathPosition = path.crbegin(); pathPosition != path.crend(); ++pathPosition)
+						{
+							results.pathLength += glm::distance(previousPosition, *pathPosition) / static_cast<float>(Globals::NODE_SIZE);
+							previousPosition = *pathPosition;
+						}
+					}
+				}
+			}));
+		}
+
+		return results;
+	}
+
+	void printResults(std::string_view name, const OrderResults& results)
+	{
+		std::cout << "    " << name;
+		Harness::print(Harness::getStats(results.milliseconds), "ms");
+		std::cout << " (found " << results.found << ", mean length " << results.pathLength / std::max(1, results.found) << ")\n";
+	}
+
+	void runLevel(std::string_view levelName)
+	{
+		std::optional<LevelDetailsFromFile> levelDetails = Harness::load(levelName);
+		if (!levelDetails)
+		{
+			return;
+		}
+
+		Map map(levelDetails->scenery, levelDetails->bases, levelDetails->gridSize);
+		PathFinding::getInstance().buildClusterGraph(map);
+		const std::vector<glm::ivec2> freePositions = Harness::getFreePositions(map);
+
+		std::vector<PathFindingProbe> probes(GROUP_SIZES.back());
+		std::array<std::vector<Order>, GROUP_SIZES.size()> orders;
+		std::array<OrderResults, GROUP_SIZES.size()> searchResults;
+		for (size_t i = 0; i < GROUP_SIZES.size(); ++i)
+		{
+			orders[i] = createOrders(freePositions, GROUP_SIZES[i], map);
+			searchResults[i] = runOrders(orders[i], probes, map, false);
+		}
+
+		std::cout << "Group move " << levelName << " " << map.getSize().x << "x" << map.getSize().y << " (" << ORDER_COUNT << " orders each)\n";
+		for (size_t i = 0; i < GROUP_SIZES.size(); ++i)
+		{
+			std::cout << "  " << GROUP_SIZES[i] << " selected\n";
+			printResults("per entity search: ", searchResults[i]);
+			printResults("flow field:        ", runOrders(orders[i], probes, map, true));
+		}
+	}
+}
+
+void Benchmarks::runGroupMove()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	for (std::string_view levelName : LEVEL_NAMES)
+	{
+		runLevel(levelName);
+	}
+}
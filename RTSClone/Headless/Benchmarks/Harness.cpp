@@ -0,0 +1,213 @@
+#include "Benchmarks/Harness.h"
+#include "Benchmarks/Brawl.h"
+#include "Core/Map.h"
+#include "Core/PathFinding.h"
+#include "Core/UniqueID.h"
+#include "Entities/EntitySpawnerBuilding.h"
+#include "Events/GameMessages.h"
+#include "Events/GameMessenger.h"
+#include "Graphics/ModelManager.h"
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+	constexpr int ID_ALIGNMENT = 60;
+	constexpr int MAX_OBSTACLE_SIZE = 6;
+}
+
+bool Harness::isReady()
+{
+	if (!ModelManager::getInstance().isAllModelsLoaded())
+	{
+		std::cout << "Failed to load all models\n";
+		return false;
+	}
+
+	PathFinding::getInstance();
+	return true;
+}
+
+std::optional<LevelDetailsFromFile> Harness::load(std::string_view levelName)
+{
+	std::optional<LevelDetailsFromFile> levelDetails = Level::load(levelName, Globals::WINDOW_SIZE);
+	if (!levelDetails)
+	{
+		std::cout << "Unable to load " << levelName << "\n";
+	}
+
+	return levelDetails;
+}
+
+std::optional<LevelDetailsFromFile> Harness::loadBrawl()
+{
+	std::optional<LevelDetailsFromFile> levelDetails = Brawl::load();
+	if (!levelDetails)
+	{
+		std::cout << "Unable to load " << Brawl::LEVEL_NAME << "\n";
+	}
+
+	return levelDetails;
+}
+
+std::vector<glm::ivec2> Harness::getFreePositions(const Map& map)
+{
+	std::vector<glm::ivec2> freePositions;
+	for (int x = 0; x < map.getSize().x; ++x)
+	{
+		for (int y = 0; y < map.getSize().y; ++y)
+		{
+			if (!map.isPositionOccupied(glm::ivec2(x, y)))
+			{
+				freePositions.emplace_back(x, y);
+			}
+		}
+	}
+
+	return freePositions;
+}
+
+AABB Harness::createObstacle(glm::ivec2 position, glm::ivec2 size)
+{
+	return AABB(glm::vec3(position.x * Globals::NODE_SIZE, Globals::GROUND_HEIGHT, position.y * Globals::NODE_SIZE),
+		glm::vec3(size.x * Globals::NODE_SIZE, 1.0f, size.y * Globals::NODE_SIZE));
+}
+
+void Harness::addObstacles(Map& map, float coverage, std::mt19937& randomEngine)
+{
+	const glm::ivec2 mapSize = map.getSize();
+	std::uniform_int_distribution<int> positionDistribution(0, mapSize.x - 1);
+	std::uniform_int_distribution<int> obstacleSizeDistribution(1, MAX_OBSTACLE_SIZE);
+	int occupied = 0;
+	while (occupied < static_cast<int>(coverage * static_cast<float>(mapSize.x * mapSize.y)))
+	{
+		glm::ivec2 size(obstacleSizeDistribution(randomEngine), obstacleSizeDistribution(randomEngine));
+		glm::ivec2 position = glm::min(glm::ivec2(positionDistribution(randomEngine), positionDistribution(randomEngine)), mapSize - size);
+		AABB obstacle = createObstacle(position, size);
+		if (!map.isAABBOccupied(obstacle))
+		{
+			broadcast<GameMessages::AddAABBToMap>({ obstacle });
+			occupied += size.x * size.y;
+		}
+	}
+}
+
+bool Harness::startBrawl(std::optional<Level>& level, int warmupTicks, float deltaTime, const std::function<void(Level&)>& setUp)
+{
+	std::optional<LevelDetailsFromFile> levelDetails = loadBrawl();
+	if (!levelDetails)
+	{
+		return false;
+	}
+
+	level.emplace(std::move(*levelDetails), Globals::WINDOW_SIZE, true);
+	if (setUp)
+	{
+		setUp(*level);
+	}
+
+	if (!Brawl::start(*level, warmupTicks, deltaTime))
+	{
+		std::cout << "Unable to start a brawl on " << Brawl::LEVEL_NAME << "\n";
+		return false;
+	}
+
+	return true;
+}
+
+bool Harness::startWithWorkerResources(std::optional<Level>& level, float deltaTime)
+{
+	std::optional<LevelDetailsFromFile> levelDetails = loadBrawl();
+	if (!levelDetails)
+	{
+		return false;
+	}
+
+	level.emplace(std::move(*levelDetails), Globals::WINDOW_SIZE, true);
+	for (const auto& faction : level->getFactions())
+	{
+		if (!faction || !faction->getMainHeadquarters())
+		{
+			std::cout << "Unable to start " << Brawl::LEVEL_NAME << "\n";
+			return false;
+		}
+
+		Level::add_event(GameEvent::create<AddFactionResourcesEvent>(
+			{ Globals::WORKER_RESOURCE_COST * static_cast<int>(Globals::MAX_WORKERS), faction->getController() }));
+	}
+	level->update(deltaTime);
+
+	return true;
+}
+
+void Harness::addWorkers(Level& level, Faction& faction, int spacing)
+{
+	const Map& map = level.getMap();
+	const glm::vec3& headquarters = faction.getMainHeadquarters()->getPosition();
+	const int workerCount = static_cast<int>(Globals::MAX_WORKERS) - static_cast<int>(getWorkers(faction).size());
+	const std::vector<glm::vec3> positions = Brawl::getFreePositions(map, headquarters, std::max(1, workerCount * spacing));
+	for (int worker = 0; worker < workerCount && !positions.empty(); ++worker)
+	{
+		EntityToSpawnFromBuilding entityToSpawn;
+		entityToSpawn.position = positions[(worker * spacing) % positions.size()];
+		entityToSpawn.type = eEntityType::Worker;
+		entityToSpawn.building_position = level.getBaseHandler().getNearestBase(headquarters)->getCenteredPosition();
+		faction.createWorker(entityToSpawn, map);
+	}
+}
+
+std::vector<const Worker*> Harness::getWorkers(const Faction& faction)
+{
+	std::vector<const Worker*> workers;
+	for (const Entity* entity : faction.getEntities())
+	{
+		if (entity->getEntityType() == eEntityType::Worker)
+		{
+			workers.push_back(static_cast<const Worker*>(entity));
+		}
+	}
+
+	return workers;
+}
+
+std::vector<double> Harness::playTicks(Level& level, int tickCount, float deltaTime)
+{
+	return playTicks(level, tickCount, deltaTime, [](int) { return true; });
+}
+
+Harness::Stats Harness::getStats(std::vector<double> samples)
+{
+	Stats stats;
+	if (samples.empty())
+	{
+		return stats;
+	}
+
+	std::sort(samples.begin(), samples.end());
+	for (double sample : samples)
+	{
+		stats.mean += sample / samples.size();
+	}
+	stats.median = samples[samples.size() / 2];
+	stats.p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+	stats.max = samples.back();
+
+	return stats;
+}
+
+void Harness::print(const Stats& stats, std::string_view unit)
+{
+	std::cout << "mean " << stats.mean << " " << unit << ", median " << stats.median << " " << unit << ", p99 " << stats.p99
+		<< " " << unit << ", max " << stats.max << " " << unit;
+}
+
+int Harness::getFirstID()
+{
+	int ID = UniqueID().Get();
+	while (ID % ID_ALIGNMENT != 0)
+	{
+		ID = UniqueID().Get();
+	}
+
+	return ID;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Core/AABB.h"
+#include "Core/Level.h"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <random>
+#include <ratio>
+#include <string_view>
+#include <vector>
+
+//What every benchmark needs around its scenario - loading levels and maps, playing a brawl through its opening,
+//timing and reporting the times taken, and hashing the state a run ends in to check it against another
+namespace Harness
+{
+	constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+	constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+	struct Stats
+	{
+		double mean		= 0.0;
+		double median	= 0.0;
+		double p99		= 0.0;
+		double max		= 0.0;
+	};
+
+	//Whether the models entities are created from are loaded, saying so when they aren't. Creates the path finder
+	//every map broadcasts its size to
+	bool isReady();
+
+	//Empty, having said so, if it can't be loaded
+	std::optional<LevelDetailsFromFile> load(std::string_view levelName);
+	std::optional<LevelDetailsFromFile> loadBrawl();
+	std::vector<glm::ivec2> getFreePositions(const Map& map);
+
+	//Building sized blocks scattered over the map until they cover the given share of it
+	AABB createObstacle(glm::ivec2 position, glm::ivec2 size);
+	void addObstacles(Map& map, float coverage, std::mt19937& randomEngine);
+
+	//Plays a brawl's opening, having said so if it can't. setUp is given the level before its first tick
+	bool startBrawl(std::optional<Level>& level, int warmupTicks, float deltaTime,
+		const std::function<void(Level&)>& setUp = nullptr);
+	//Hands the bases to their factions on the first tick, which also pays for a full set of workers each,
+	//having said so if it can't
+	bool startWithWorkerResources(std::optional<Level>& level, float deltaTime);
+	//Fills the faction out to a full set of workers round its headquarters, every spacing nodes out from it -
+	//all of them stacked on the closest free node if spacing is 0
+	void addWorkers(Level& level, Faction& faction, int spacing);
+	std::vector<const Worker*> getWorkers(const Faction& faction);
+
+	//Time a call takes, in seconds by default
+	template <typename Period = std::ratio<1>, typename Function>
+	double measure(Function&& function)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		function();
+		return std::chrono::duration<double, Period>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	//Microseconds each tick takes, until a faction wins, tickCount ticks have been played or onTick, given each tick
+	//after it's played, returns false
+	template <typename OnTick>
+	std::vector<double> playTicks(Level& level, int tickCount, float deltaTime, OnTick onTick)
+	{
+		std::vector<double> tickTimes;
+		tickTimes.reserve(tickCount);
+		for (int tick = 0; tick < tickCount && !level.getWinningFaction(); ++tick)
+		{
+			tickTimes.push_back(measure<std::micro>([&level, deltaTime]() { level.update(deltaTime); }));
+			if (!onTick(tick))
+			{
+				break;
+			}
+		}
+
+		return tickTimes;
+	}
+
+	std::vector<double> playTicks(Level& level, int tickCount, float deltaTime);
+
+	Stats getStats(std::vector<double> samples);
+	//"mean 1 us, median 1 us, p99 2 us, max 3 us"
+	void print(const Stats& stats, std::string_view unit);
+
+	template <typename T>
+	void hash(uint64_t& currentHash, const T& value)
+	{
+		unsigned char bytes[sizeof(T)];
+		std::memcpy(bytes, &value, sizeof(T));
+		for (unsigned char byte : bytes)
+		{
+			currentHash ^= byte;
+			currentHash *= FNV_PRIME;
+		}
+	}
+
+	//IDs carry on from the previous run and pick which tick each unit's delayed update lands on - start every run
+	//on the same tick of the period and hash IDs from the one this returns
+	int getFirstID();
+}
@@ -0,0 +1,143 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Benchmarks/PathFindingProbe.h"
+#include "Core/Map.h"
+#include "Core/PathFinding.h"
+#include "Events/GameMessages.h"
+#include "Events/GameMessenger.h"
+#include "Model/AdjacentPositions.h"
+#include <array>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//Long queries on generated maps with and without the cluster graph, then the cost of
+//an AddAABBToMap/RemoveAABBFromMap pair followed by a query that has to rebuild the touched clusters
+namespace
+{
+	constexpr int QUERY_COUNT = 50;
+	constexpr int EDIT_COUNT = 50;
+	constexpr unsigned int SEED = 1;
+	constexpr float OBSTACLE_COVERAGE = 0.15f;
+	const std::array<int, 4> MAP_SIZES = { 64, 128, 256, 512 };
+
+	struct Query
+	{
+		glm::ivec2 startingPosition;
+		glm::ivec2 destination;
+	};
+
+	struct QueryResults
+	{
+		double seconds = 0.0;
+		double pathLength = 0.0;
+		int found = 0;
+	};
+
+	double getPathLength(const PathFindingProbe& probe, const std::vector<glm::vec3>& path)
+	{
+		double length = 0.0;
+		glm::vec3 previousPosition = probe.getPosition();
+		for (auto position = path.crbegin(); position != path.crend(); ++position)
+		{
+			length += glm::distance(previousPosition, *position) / static_cast<float>(Globals::NODE_SIZE);
+			previousPosition = *position;
+		}
+
+		return length;
+	}
+
+	QueryResults runQueries(const std::vector<Query>& queries, const Map& map, PathFindingProbe& probe, bool hierarchicalPathing)
+	{
+		PathFinding::getInstance().setHierarchicalPathing(hierarchicalPathing);
+
+		QueryResults results;
+		std::vector<glm::vec3> path;
+		for (const auto& query : queries)
+		{
+			probe.setGridPosition(query.startingPosition);
+			results.seconds += Harness::measure([&probe, &query, &path, &map]()
+			{
+				PathFinding::getInstance().getPathToPosition(probe, Globals::convertToWorldPosition(query.destination), path, map, createAdjacentPositions(map));
+			});
+			if (!path.empty())
+			{
+				++results.found;
+				results.pathLength += getPathLength(probe, path);
+			}
+		}
+
+		return results;
+	}
+
+	void runMapSize(int mapSize)
+	{
+		std::mt19937 randomEngine(SEED);
+		std::uniform_int_distribution<int> positionDistribution(0, mapSize - 1);
+		Map map({}, {}, { mapSize, mapSize });
+		Harness::addObstacles(map, OBSTACLE_COVERAGE, randomEngine);
+
+		std::vector<Query> queries;
+		while (static_cast<int>(queries.size()) < QUERY_COUNT)
+		{
+			Query query{ { positionDistribution(randomEngine), positionDistribution(randomEngine) },
+				{ positionDistribution(randomEngine), positionDistribution(randomEngine) } };
+			if (!map.isPositionOccupied(query.startingPosition) && !map.isPositionOccupied(query.destination) &&
+				Globals::getDistance(query.destination, query.startingPosition) >= static_cast<float>(mapSize) / 2.0f)
+			{
+				queries.push_back(query);
+			}
+		}
+
+		PathFindingProbe probe;
+		const QueryResults flatResults = runQueries(queries, map, probe, false);
+		const double buildSeconds = Harness::measure([&queries, &map, &probe]() { runQueries({ queries.front() }, map, probe, true); });
+		const QueryResults hierarchicalResults = runQueries(queries, map, probe, true);
+
+		//Toggle a building sized obstacle on and off next to the start of each query
+		QueryResults editResults;
+		for (int i = 0; i < EDIT_COUNT; ++i)
+		{
+			const Query& query = queries[i % queries.size()];
+			const glm::ivec2 position = glm::clamp(query.startingPosition + glm::ivec2(2), glm::ivec2(0), glm::ivec2(mapSize - 4));
+			AABB obstacle = Harness::createObstacle(position, { 3, 3 });
+			const bool free = !map.isAABBOccupied(obstacle);
+			QueryResults results;
+			editResults.seconds += Harness::measure([&obstacle, &query, &map, &probe, &results, free]()
+			{
+				if (free)
+				{
+					broadcast<GameMessages::AddAABBToMap>({ obstacle });
+				}
+				results = runQueries({ query }, map, probe, true);
+				if (free)
+				{
+					broadcast<GameMessages::RemoveAABBFromMap>({ obstacle });
+				}
+			});
+			editResults.found += results.found;
+		}
+		PathFinding::getInstance().setHierarchicalPathing(true);
+
+		std::cout << "Map " << mapSize << "x" << mapSize << " (" << QUERY_COUNT << " queries, distance >= " << mapSize / 2 << ")\n";
+		std::cout << "  theta*:          " << flatResults.seconds * 1000.0 / QUERY_COUNT << " ms/query (found " << flatResults.found
+			<< ", mean length " << flatResults.pathLength / std::max(1, flatResults.found) << ")\n";
+		std::cout << "  hierarchical:    " << hierarchicalResults.seconds * 1000.0 / QUERY_COUNT << " ms/query (found " << hierarchicalResults.found
+			<< ", mean length " << hierarchicalResults.pathLength / std::max(1, hierarchicalResults.found) << ")\n";
+		std::cout << "  first query (full build): " << buildSeconds * 1000.0 << " ms\n";
+		std::cout << "  edit + query:    " << editResults.seconds * 1000.0 / EDIT_COUNT << " ms (found " << editResults.found << ")\n";
+	}
+}
+
+void Benchmarks::runHierarchicalPathFinding()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	for (int mapSize : MAP_SIZES)
+	{
+		runMapSize(mapSize);
+	}
+}
@@ -0,0 +1,214 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Benchmarks/PathFindingProbe.h"
+#include "Core/Map.h"
+#include "Core/PathFinding.h"
+#include "Model/AdjacentPositions.h"
+#include <array>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+//Line of sight between free nodes within attack range on each shipped level - the previous march in node sized steps
+//along the line against the walk over every node it passes through, with and without the map's cache.
+//Queries are repeated every round as units keep checking the same targets tick after tick.
+//Then Theta* searches from across the map to a handful of shared destinations with and without the cache,
+//which have to find the same paths
+namespace
+{
+	constexpr int QUERY_COUNT = 20000;
+	constexpr int ROUNDS = 10;
+	constexpr int QUERY_DISTANCE = static_cast<int>(Globals::UNIT_GRID_ATTACK_RANGE) + 2;
+	constexpr int PATH_QUERY_COUNT = 400;
+	constexpr int PATH_DESTINATION_COUNT = 8;
+	constexpr unsigned int SEED = 1;
+	const std::array<std::string_view, 3> LEVEL_NAMES = { "Level1.txt", "Level2.txt", "Level4.txt" };
+
+	struct Query
+	{
+		glm::ivec2 start		= {};
+		glm::ivec2 target		= {};
+	};
+
+	struct Result
+	{
+		double queriesPerSecond		= 0.0;
+		int visible					= 0;
+		std::vector<bool> results	= {};
+	};
+
+	struct PathResult
+	{
+		double expansionsPerSecond	= 0.0;
+		double microseconds			= 0.0;
+		size_t expansions			= 0;
+		size_t checksum				= 0;
+	};
+
+	//Previous PathFinding::isTargetInLineOfSight
+	bool isTargetInLineOfSightPerStep(const glm::vec3& startingPosition, const Entity& targetEntity, const Map& map)
+	{
+		const glm::vec3 start = Globals::convertToMiddleGridPosition(Globals::convertToNodePosition(startingPosition));
+		const glm::vec3 end = Globals::convertToMiddleGridPosition(Globals::convertToNodePosition(targetEntity.getPosition()));
+		const glm::vec3 direction = glm::normalize(end - start);
+		const float distance = glm::distance(end, start);
+		for (int i = Globals::NODE_SIZE; i <= static_cast<int>(glm::ceil(distance)); i += Globals::NODE_SIZE)
+		{
+			const glm::vec3 position = start + direction * static_cast<float>(i);
+			if (targetEntity.getAABB().contains(position))
+			{
+				return true;
+			}
+			else if (map.isPositionOccupied(position))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <typename IsInLineOfSight>
+	Result runQueries(const std::vector<Query>& queries, PathFindingProbe& target, IsInLineOfSight isInLineOfSight)
+	{
+		Result result;
+		result.results.reserve(queries.size());
+		const double seconds = Harness::measure([&queries, &target, &isInLineOfSight, &result]()
+		{
+			for (int round = 0; round < ROUNDS; ++round)
+			{
+				for (const auto& query : queries)
+				{
+					target.setGridPosition(query.target);
+					const bool visible = isInLineOfSight(Globals::convertToWorldPosition(query.start), target);
+					if (round == 0)
+					{
+						result.results.push_back(visible);
+						result.visible += visible ? 1 : 0;
+					}
+				}
+			}
+		});
+		result.queriesPerSecond = seconds > 0.0 ? static_cast<double>(queries.size() * ROUNDS) / seconds / 1000000.0 : 0.0;
+		return result;
+	}
+
+	PathResult runPaths(const std::vector<Query>& queries, Map& map, bool lineOfSightCaching)
+	{
+		map.setLineOfSightCaching(lineOfSightCaching);
+		PathResult result;
+		PathFindingProbe probe;
+		std::vector<glm::vec3> path;
+		const size_t startingExpansions = PathFinding::getInstance().getExpandedNodeCount();
+		const double seconds = Harness::measure([&queries, &probe, &path, &map, &result]()
+		{
+			for (const auto& query : queries)
+			{
+				probe.setGridPosition(query.start);
+				PathFinding::getInstance().getPathToPosition(probe, Globals::convertToWorldPosition(query.target), path, map, createAdjacentPositions(map));
+				for (const auto& position : path)
+				{
+					result.checksum = result.checksum * 31 + static_cast<size_t>(Globals::convertTo1D(Globals::convertToGridPosition(position), map.getSize()));
+				}
+			}
+		});
+		result.expansions = PathFinding::getInstance().getExpandedNodeCount() - startingExpansions;
+		result.expansionsPerSecond = seconds > 0.0 ? static_cast<double>(result.expansions) / seconds / 1000000.0 : 0.0;
+		result.microseconds = seconds * 1000000.0 / static_cast<double>(queries.size());
+		return result;
+	}
+
+	void runLevel(std::string_view levelName)
+	{
+		std::optional<LevelDetailsFromFile> levelDetails = Harness::load(levelName);
+		if (!levelDetails)
+		{
+			return;
+		}
+
+		Map map(levelDetails->scenery, levelDetails->bases, levelDetails->gridSize);
+		const std::vector<glm::ivec2> freePositions = Harness::getFreePositions(map);
+
+		std::mt19937 randomEngine(SEED);
+		std::uniform_int_distribution<size_t> freePositionDistribution(0, freePositions.size() - 1);
+		std::uniform_int_distribution<int> offsetDistribution(-QUERY_DISTANCE, QUERY_DISTANCE);
+		std::vector<Query> queries;
+		queries.reserve(QUERY_COUNT);
+		while (static_cast<int>(queries.size()) < QUERY_COUNT)
+		{
+			const glm::ivec2 start = freePositions[freePositionDistribution(randomEngine)];
+			const glm::ivec2 target = start + glm::ivec2(offsetDistribution(randomEngine), offsetDistribution(randomEngine));
+			if (map.isWithinBounds(target) && !map.isPositionOccupied(target))
+			{
+				queries.push_back({ start, target });
+			}
+		}
+
+		PathFindingProbe target;
+		const Result perStep = runQueries(queries, target, [&map](const glm::vec3& startingPosition, const Entity& targetEntity)
+		{
+			return isTargetInLineOfSightPerStep(startingPosition, targetEntity, map);
+		});
+
+		map.setLineOfSightCaching(false);
+		const Result perNode = runQueries(queries, target, [&map](const glm::vec3& startingPosition, const Entity& targetEntity)
+		{
+			return PathFinding::getInstance().isTargetInLineOfSight(startingPosition, targetEntity, map);
+		});
+
+		map.setLineOfSightCaching(true);
+		const Result cached = runQueries(queries, target, [&map](const glm::vec3& startingPosition, const Entity& targetEntity)
+		{
+			return PathFinding::getInstance().isTargetInLineOfSight(startingPosition, targetEntity, map);
+		});
+
+		int cornersMissed = 0;
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			cornersMissed += perStep.results[i] != perNode.results[i] ? 1 : 0;
+		}
+
+		std::vector<glm::ivec2> destinations;
+		for (int i = 0; i < PATH_DESTINATION_COUNT; ++i)
+		{
+			destinations.push_back(freePositions[freePositionDistribution(randomEngine)]);
+		}
+
+		std::vector<Query> pathQueries;
+		for (int i = 0; i < PATH_QUERY_COUNT; ++i)
+		{
+			pathQueries.push_back({ freePositions[freePositionDistribution(randomEngine)], destinations[i % PATH_DESTINATION_COUNT] });
+		}
+
+		const PathResult uncachedPaths = runPaths(pathQueries, map, false);
+		const PathResult cachedPaths = runPaths(pathQueries, map, true);
+
+		std::cout << "Line of sight " << levelName << " " << map.getSize().x << "x" << map.getSize().y << " (" << QUERY_COUNT
+			<< " queries within " << QUERY_DISTANCE << " nodes, " << ROUNDS << " rounds)\n";
+		std::cout << "  per step:         " << perStep.queriesPerSecond << " Mqueries/s, " << perStep.visible << " visible\n";
+		std::cout << "  per node:         " << perNode.queriesPerSecond << " Mqueries/s, " << perNode.visible << " visible, "
+			<< cornersMissed << " differ from per step\n";
+		std::cout << "  per node, cached: " << cached.queriesPerSecond << " Mqueries/s, speedup "
+			<< (perStep.queriesPerSecond > 0.0 ? cached.queriesPerSecond / perStep.queriesPerSecond : 0.0)
+			<< (cached.results == perNode.results ? "" : " (results differ from uncached)") << "\n";
+		std::cout << "  theta* (" << PATH_QUERY_COUNT << " paths to " << PATH_DESTINATION_COUNT << " destinations)\n";
+		std::cout << "    uncached: " << uncachedPaths.expansionsPerSecond << " Mexpansions/s, " << uncachedPaths.microseconds << " us/path\n";
+		std::cout << "    cached:   " << cachedPaths.expansionsPerSecond << " Mexpansions/s, " << cachedPaths.microseconds << " us/path, speedup "
+			<< (cachedPaths.microseconds > 0.0 ? uncachedPaths.microseconds / cachedPaths.microseconds : 0.0)
+			<< (cachedPaths.checksum == uncachedPaths.checksum && cachedPaths.expansions == uncachedPaths.expansions ? "" : " (paths differ)") << "\n";
+	}
+}
+
+void Benchmarks::runLineOfSight()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	for (std::string_view levelName : LEVEL_NAMES)
+	{
+		runLevel(levelName);
+	}
+}
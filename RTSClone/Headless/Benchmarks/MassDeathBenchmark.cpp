@@ -0,0 +1,371 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Benchmarks/PathFindingProbe.h"
+#include "Core/AABB.h"
+#include "Core/EntityList.h"
+#include "Core/EntityLookup.h"
+#include "Core/EntityPool.h"
+#include "Core/Level.h"
+#include "Core/Map.h"
+#include "Entities/EntitySpawnerBuilding.h"
+#include "Entities/Turret.h"
+#include "Entities/Worker.h"
+#include "Events/GameEvents.h"
+#include "Graphics/ModelManager.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <vector>
+
+//Mass deaths - a line of turrets across the way to one faction's headquarters against waves of units another
+//faction sends into it. Once a wave is in range every unit of it is hit at once and dies on the same tick.
+//Reports that tick's cost against the tick before it and checks after it that each entity a faction lists can
+//still be found by ID at the same address.
+//Then the cost of removing a whole wave found by ID from a typed vector, fixing up the pointers to every entity
+//behind it like before, against removing it from an EntityPool
+namespace
+{
+	constexpr std::string_view LEVEL_NAME = "Level2.txt";
+	constexpr int STARTING_POPULATION = 1000;
+	constexpr int WAVE_SIZE = static_cast<int>(Globals::MAX_UNITS);
+	constexpr int WAVE_COUNT = 20;
+	constexpr int MAX_TICKS = 36000;
+	constexpr float DELTA_TIME = 1.0f / 60.0f;
+	constexpr float TURRET_LINE = 0.3f;
+	constexpr float WAVE_START = 0.6f;
+	constexpr float WAVE_DESTINATION = 0.1f;
+	constexpr int TURRET_SPACING = 2;
+	constexpr int REMOVAL_ROUNDS = 200;
+	constexpr unsigned int SEED = 1;
+	const std::array<int, 2> REMOVAL_COUNTS = { 50, 500 };
+
+	Faction* getFaction(const Level& level, eFactionController controller)
+	{
+		const auto faction = std::find_if(level.getFactions().cbegin(), level.getFactions().cend(), [controller](const auto& faction)
+		{
+			return faction->getController() == controller;
+		});
+
+		return faction != level.getFactions().cend() ? faction->get() : nullptr;
+	}
+
+	bool isConsistent(const Faction& faction)
+	{
+		return std::all_of(faction.getEntities().cbegin(), faction.getEntities().cend(), [&faction](const Entity* entity)
+		{
+			return faction.get_entity(entity->getID()) == entity;
+		});
+	}
+
+	glm::vec3 getPositionBetween(const glm::vec3& a, const glm::vec3& b, float t)
+	{
+		return Globals::convertToWorldPosition(Globals::convertToGridPosition(a + (b - a) * t));
+	}
+
+	//Workers sent off to build elsewhere leave their base - harvesting ones belong to it
+	const Worker* getHarvestingWorker(const Faction& faction)
+	{
+		const auto worker = std::find_if(faction.getEntities().cbegin(), faction.getEntities().cend(), [](const Entity* entity)
+		{
+			return entity->getEntityType() == eEntityType::Worker &&
+				static_cast<const Worker*>(entity)->getCurrentState() == eWorkerState::Harvesting;
+		});
+
+		return worker != faction.getEntities().cend() ? static_cast<const Worker*>(*worker) : nullptr;
+	}
+
+	//Built on behalf of a worker so an AI faction counts them as part of its base
+	std::vector<int> createTurretLine(Faction& faction, const Worker& builder, const Map& map, const glm::vec3& center, const glm::vec3& direction)
+	{
+		const glm::vec3 across = glm::normalize(glm::vec3(-direction.z, 0.0f, direction.x));
+		const Model& model = ModelManager::getInstance().getModel(eEntityType::Turret);
+		std::vector<int> turretIDs;
+		for (int i = 0; i < map.getSize().x * 2 && turretIDs.size() < Globals::MAX_TURRETS; ++i)
+		{
+			const float offset = static_cast<float>((i + 1) / 2 * (i % 2 == 0 ? 1 : -1) * TURRET_SPACING * Globals::NODE_SIZE);
+			const glm::vec3 position = Globals::convertToWorldPosition(Globals::convertToGridPosition(center + across * offset));
+			const AABB aabb(position, model);
+			if (map.isWithinBounds(aabb) && !map.isAABBOccupied(aabb))
+			{
+				if (const Turret* turret = faction.CreateTurret(WorkerScheduledBuilding(position, eEntityType::Turret, builder.getID())))
+				{
+					turretIDs.push_back(turret->getID());
+				}
+			}
+		}
+
+		return turretIDs;
+	}
+
+	int getAliveCount(const Level& level, eFactionController controller, const std::vector<int>& IDs)
+	{
+		const Faction* faction = getFaction(level, controller);
+		return faction ? static_cast<int>(std::count_if(IDs.cbegin(), IDs.cend(), [faction](int ID)
+		{
+			return faction->get_entity(ID) != nullptr;
+		})) : 0;
+	}
+
+	//Closest free nodes to the center, ring by ring. Spawned idle - an AI faction puts them into squads
+	//and raises idle events for them the following tick
+	std::vector<int> createWave(Faction& faction, const Map& map, const glm::vec3& center)
+	{
+		std::vector<int> unitIDs;
+		const glm::ivec2 centerOnGrid = Globals::convertToGridPosition(center);
+		for (int ring = 0; ring < map.getSize().x && static_cast<int>(unitIDs.size()) < WAVE_SIZE; ++ring)
+		{
+			for (int x = -ring; x <= ring; ++x)
+			{
+				for (int y = -ring; y <= ring; ++y)
+				{
+					const glm::ivec2 position = centerOnGrid + glm::ivec2(x, y);
+					if (std::max(std::abs(x), std::abs(y)) != ring || static_cast<int>(unitIDs.size()) == WAVE_SIZE ||
+						!map.isWithinBounds(position) || map.isPositionOccupied(position) ||
+						!map.isPositionOnUnitMapAvailable(position, Globals::INVALID_ENTITY_ID))
+					{
+						continue;
+					}
+
+					EntityToSpawnFromBuilding entityToSpawn;
+					entityToSpawn.position = Globals::convertToWorldPosition(position);
+					entityToSpawn.type = eEntityType::Unit;
+					if (const Entity* unit = faction.createUnit(entityToSpawn, map))
+					{
+						unitIDs.push_back(unit->getID());
+					}
+				}
+			}
+		}
+
+		return unitIDs;
+	}
+
+	//Wave units either side has taken damage from the other
+	bool isEngaged(const Level& level, eFactionController attackerController, const std::vector<int>& waveIDs)
+	{
+		const Faction* attacker = getFaction(level, attackerController);
+		return !attacker || std::any_of(waveIDs.cbegin(), waveIDs.cend(), [attacker](int ID)
+		{
+			const Entity* unit = attacker->get_entity(ID);
+			return !unit || unit->getHealth() < unit->getMaximumHealth();
+		});
+	}
+
+	//One lethal hit from the turret line for every unit of the wave still alive, all handled on the next tick
+	void killWave(const Faction& attacker, const std::vector<int>& waveIDs, eFactionController defenderController, int turretID)
+	{
+		for (int ID : waveIDs)
+		{
+			if (const Entity* unit = attacker.get_entity(ID))
+			{
+				Level::add_event(GameEvent::create<TakeDamageEvent>({ defenderController, turretID, eEntityType::Turret,
+					attacker.getController(), ID, unit->getHealth() + unit->getShield() }));
+			}
+		}
+	}
+
+	void runWave()
+	{
+		std::optional<LevelDetailsFromFile> levelDetails = Harness::load(LEVEL_NAME);
+		if (!levelDetails)
+		{
+			return;
+		}
+		if (levelDetails->factionCount < 2)
+		{
+			std::cout << "Unable to load " << LEVEL_NAME << "\n";
+			return;
+		}
+
+		levelDetails->factionStartingPopulation = STARTING_POPULATION;
+		std::optional<Level> level;
+		level.emplace(std::move(*levelDetails), Globals::WINDOW_SIZE, true);
+
+		Faction& defender = *level->getFactions()[0];
+		Faction& attacker = *level->getFactions()[1];
+		const eFactionController defenderController = defender.getController();
+		const eFactionController attackerController = attacker.getController();
+		const glm::vec3 defenderPosition = defender.getMainHeadquarters()->getPosition();
+		const glm::vec3 attackerPosition = attacker.getMainHeadquarters()->getPosition();
+		for (int tick = 0; tick < MAX_TICKS && !getHarvestingWorker(defender); ++tick)
+		{
+			level->update(DELTA_TIME);
+		}
+
+		//Enough for the turret line only, so the defender has no more to spend than usual
+		Level::add_event(GameEvent::create<AddFactionResourcesEvent>(
+			{ Globals::TURRET_RESOURCE_COST * static_cast<int>(Globals::MAX_TURRETS), defenderController }));
+		level->update(DELTA_TIME);
+
+		const Worker* builder = getHarvestingWorker(defender);
+		const std::vector<int> turretIDs = builder ? createTurretLine(defender, *builder, level->getMap(),
+			getPositionBetween(defenderPosition, attackerPosition, TURRET_LINE), attackerPosition - defenderPosition) : std::vector<int>();
+		if (turretIDs.empty())
+		{
+			std::cout << "Unable to build a turret line on " << LEVEL_NAME << "\n";
+			return;
+		}
+
+		//Each wave marches into the turret line until the two sides have started hitting each other,
+		//then the whole wave dies in a single tick
+		const glm::vec3 waveDestination = getPositionBetween(defenderPosition, attackerPosition, WAVE_DESTINATION);
+		std::vector<double> engagedTickTimes;
+		std::vector<double> deathTickTimes;
+		int waveCount = 0;
+		int spawned = 0;
+		int deaths = 0;
+		bool consistent = true;
+		for (int wave = 0; wave < WAVE_COUNT && !level->getWinningFaction(); ++wave)
+		{
+			Level::add_event(GameEvent::create<AddFactionResourcesEvent>({ Globals::UNIT_RESOURCE_COST * WAVE_SIZE, attackerController }));
+			level->update(DELTA_TIME);
+			const std::vector<int> waveIDs = createWave(attacker, level->getMap(), getPositionBetween(defenderPosition, attackerPosition, WAVE_START));
+			level->update(DELTA_TIME);
+			for (int ID : waveIDs)
+			{
+				if (Entity* unit = attacker.get_entity(ID))
+				{
+					unit->MoveTo(waveDestination, level->getMap(), false);
+				}
+			}
+
+			bool engaged = false;
+			std::vector<double> tickTimes = Harness::playTicks(*level, MAX_TICKS, DELTA_TIME,
+				[&engaged, &level, &waveIDs, attackerController](int)
+			{
+				engaged = isEngaged(*level, attackerController, waveIDs);
+				return !engaged;
+			});
+			if (!engaged)
+			{
+				break;
+			}
+
+			engagedTickTimes.push_back(tickTimes.back());
+			spawned += static_cast<int>(waveIDs.size());
+			killWave(attacker, waveIDs, defenderController, turretIDs.front());
+			const int waveRemaining = getAliveCount(*level, attackerController, waveIDs);
+			deathTickTimes.push_back(Harness::measure<std::micro>([&level]() { level->update(DELTA_TIME); }));
+			deaths += waveRemaining - getAliveCount(*level, attackerController, waveIDs);
+			waveCount = wave + 1;
+			for (const auto& faction : level->getFactions())
+			{
+				consistent = consistent && isConsistent(*faction);
+			}
+		}
+
+		std::cout << waveCount << " waves of " << (waveCount > 0 ? spawned / waveCount : 0) << " units against "
+			<< turretIDs.size() << " turrets (" << LEVEL_NAME << ")\n";
+		std::cout << "  " << deaths << " of " << spawned << " units died on the tick their wave was hit\n";
+		std::cout << "  tick the wave engaged ";
+		Harness::print(Harness::getStats(std::move(engagedTickTimes)), "us");
+		std::cout << "\n  tick the wave died ";
+		Harness::print(Harness::getStats(std::move(deathTickTimes)), "us");
+		std::cout << (consistent ? "" : " (entities not found at the address their faction lists)") << "\n";
+	}
+
+	//Previous Faction::removeEntity
+	void removeFromVector(std::vector<PathFindingProbe>& entityContainer, std::vector<Entity*>& allEntities,
+		EntityLookup& entityLookup, Entity& entity)
+	{
+		const auto iter = entityContainer.begin() + (static_cast<PathFindingProbe*>(&entity) - entityContainer.data());
+		const auto allEntity = std::find(allEntities.begin(), allEntities.end(), &entity);
+		entityLookup.remove(entity.getID());
+
+		auto shiftedAllEntity = std::next(allEntity);
+		for (auto shiftedEntity = std::next(iter); shiftedEntity != entityContainer.end(); ++shiftedEntity)
+		{
+			shiftedAllEntity = std::find(shiftedAllEntity, allEntities.end(), &(*shiftedEntity));
+			*shiftedAllEntity = &(*std::prev(shiftedEntity));
+		}
+
+		allEntities.erase(allEntity);
+		for (auto shiftedEntity = entityContainer.erase(iter); shiftedEntity != entityContainer.end(); ++shiftedEntity)
+		{
+			entityLookup.set(*shiftedEntity);
+		}
+	}
+
+	void runRemoval()
+	{
+		std::cout << "Removing a whole wave in random order (" << REMOVAL_ROUNDS << " rounds)\n";
+		std::mt19937 randomEngine(SEED);
+		for (int entityCount : REMOVAL_COUNTS)
+		{
+			double vectorNanoseconds = 0.0;
+			double poolNanoseconds = 0.0;
+			for (int round = 0; round < REMOVAL_ROUNDS; ++round)
+			{
+				std::vector<int> order(entityCount);
+				std::iota(order.begin(), order.end(), 0);
+				std::shuffle(order.begin(), order.end(), randomEngine);
+
+				std::vector<PathFindingProbe> entities;
+				std::vector<Entity*> allEntities;
+				EntityLookup entityLookup;
+				std::vector<int> IDs;
+				entities.reserve(entityCount);
+				allEntities.reserve(entityCount);
+				for (int i = 0; i < entityCount; ++i)
+				{
+					allEntities.push_back(&entities.emplace_back());
+					entityLookup.set(entities.back());
+					IDs.push_back(entities.back().getID());
+				}
+
+				vectorNanoseconds += Harness::measure<std::nano>([&order, &entities, &allEntities, &entityLookup, &IDs]()
+				{
+					for (int i : order)
+					{
+						removeFromVector(entities, allEntities, entityLookup, *entityLookup.get(IDs[i]));
+					}
+				});
+
+				EntityPool<PathFindingProbe> entityPool(entityCount);
+				EntityList entityList;
+				IDs.clear();
+				for (int i = 0; i < entityCount; ++i)
+				{
+					PathFindingProbe& entity = entityPool.emplace_back();
+					entityList.push_back(entity);
+					entityLookup.set(entity);
+					IDs.push_back(entity.getID());
+				}
+
+				poolNanoseconds += Harness::measure<std::nano>([&order, &entityPool, &entityList, &entityLookup, &IDs]()
+				{
+					for (int i : order)
+					{
+						PathFindingProbe& entity = static_cast<PathFindingProbe&>(*entityLookup.get(IDs[i]));
+						entityLookup.remove(entity.getID());
+						entityList.remove(entity);
+						entityPool.erase(entity);
+					}
+				});
+			}
+
+			const double removals = static_cast<double>(REMOVAL_ROUNDS) * entityCount;
+			vectorNanoseconds /= removals;
+			poolNanoseconds /= removals;
+			std::cout << "  " << entityCount << " entities\n";
+			std::cout << "    vector: " << vectorNanoseconds << " ns/removal\n";
+			std::cout << "    pool:   " << poolNanoseconds << " ns/removal, speedup "
+				<< (poolNanoseconds > 0.0 ? vectorNanoseconds / poolNanoseconds : 0.0) << "\n";
+		}
+	}
+}
+
+void Benchmarks::runMassDeath()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	runWave();
+	runRemoval();
+}
@@ -0,0 +1,161 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Core/Map.h"
+#include "Core/PathFinding.h"
+#include "Events/GameMessages.h"
+#include "Events/GameMessenger.h"
+#include <iostream>
+#include <random>
+#include <vector>
+
+//Messages per second a unit path step sends to the unit map - the previous Broadcaster calling a std::function
+//per listener against StaticBroadcaster calling its one receiver directly, both into the same stand-in unit map.
+//Then the same through the StaticBroadcaster into a Map, whose receive function lives in another translation unit
+namespace
+{
+	constexpr int MAP_SIZE = 128;
+	constexpr int UNIT_COUNT = 1000;
+	constexpr int ROUNDS = 2000;
+	constexpr unsigned int SEED = 1;
+
+	struct DynamicUnitPosition
+	{
+		const glm::vec3& position;
+		const int ID = Globals::INVALID_ENTITY_ID;
+	};
+
+	struct StaticUnitPosition
+	{
+		const glm::vec3& position;
+		const int ID = Globals::INVALID_ENTITY_ID;
+	};
+
+	//Map::editUnitMap
+	class UnitMapProbe
+	{
+	public:
+		UnitMapProbe()
+			: m_unitMap(MAP_SIZE * MAP_SIZE, Globals::INVALID_ENTITY_ID)
+		{}
+
+		void edit(const glm::vec3& position, int ID)
+		{
+			int& node = m_unitMap[Globals::convertTo1D(Globals::convertToGridPosition(position), { MAP_SIZE, MAP_SIZE })];
+			node = node == ID ? Globals::INVALID_ENTITY_ID : ID;
+		}
+
+		unsigned int getChecksum() const
+		{
+			unsigned int checksum = 0;
+			for (int ID : m_unitMap)
+			{
+				checksum = checksum * 31 + static_cast<unsigned int>(ID);
+			}
+
+			return checksum;
+		}
+
+	private:
+		std::vector<int> m_unitMap;
+	};
+}
+
+template <>
+struct StaticListener<StaticUnitPosition>
+{
+	using Receiver = UnitMapProbe;
+	static void receive(UnitMapProbe& unitMap, StaticUnitPosition&& message)
+	{
+		unitMap.edit(message.position, message.ID);
+	}
+};
+
+namespace
+{
+	std::vector<glm::vec3> createPositions()
+	{
+		std::mt19937 randomEngine(SEED);
+		std::uniform_int_distribution<int> positionDistribution(0, MAP_SIZE - 1);
+		std::vector<glm::vec3> positions;
+		positions.reserve(UNIT_COUNT);
+		for (int i = 0; i < UNIT_COUNT; ++i)
+		{
+			positions.push_back(Globals::convertToWorldPosition({ positionDistribution(randomEngine), positionDistribution(randomEngine) }));
+		}
+
+		return positions;
+	}
+
+	double getMillionMessagesPerSecond(double microseconds)
+	{
+		const double messageCount = static_cast<double>(ROUNDS) * UNIT_COUNT * 2;
+		return messageCount / microseconds;
+	}
+}
+
+void Benchmarks::runMessenger()
+{
+	PathFinding::getInstance();
+	const std::vector<glm::vec3> positions = createPositions();
+
+	//Each unit steps onto its node and off again, as Unit::switchToState does when it sets off
+	UnitMapProbe dynamicUnitMap;
+	BroadcasterSub<DynamicUnitPosition> dynamicSub([&dynamicUnitMap](DynamicUnitPosition&& message)
+	{
+		dynamicUnitMap.edit(message.position, message.ID);
+	});
+	const double dynamicDuration = Harness::measure<std::micro>([&positions]()
+	{
+		for (int round = 0; round < ROUNDS; ++round)
+		{
+			for (int i = 0; i < UNIT_COUNT; ++i)
+			{
+				broadcast<DynamicUnitPosition>({ positions[i], i + 1 });
+				broadcast<DynamicUnitPosition>({ positions[i], i + 1 });
+			}
+		}
+	});
+
+	UnitMapProbe staticUnitMap;
+	StaticBroadcasterSub<StaticUnitPosition> staticSub(staticUnitMap);
+	const double staticDuration = Harness::measure<std::micro>([&positions]()
+	{
+		for (int round = 0; round < ROUNDS; ++round)
+		{
+			for (int i = 0; i < UNIT_COUNT; ++i)
+			{
+				broadcast<StaticUnitPosition>({ positions[i], i + 1 });
+				broadcast<StaticUnitPosition>({ positions[i], i + 1 });
+			}
+		}
+	});
+
+	Map map({}, {}, { MAP_SIZE, MAP_SIZE });
+	const double mapDuration = Harness::measure<std::micro>([&positions]()
+	{
+		for (int round = 0; round < ROUNDS; ++round)
+		{
+			for (int i = 0; i < UNIT_COUNT; ++i)
+			{
+				broadcast<GameMessages::AddUnitPositionToMap>({ positions[i], i + 1 });
+				broadcast<GameMessages::RemoveUnitPositionFromMap>({ positions[i], i + 1 });
+			}
+		}
+	});
+
+	bool mapCleared = true;
+	for (const auto& position : positions)
+	{
+		mapCleared = mapCleared && map.isPositionOnUnitMapAvailable(Globals::convertToGridPosition(position), Globals::INVALID_ENTITY_ID);
+	}
+
+	const double dynamicRate = getMillionMessagesPerSecond(dynamicDuration);
+	const double staticRate = getMillionMessagesPerSecond(staticDuration);
+	std::cout << "Unit map messages (" << UNIT_COUNT << " units, " << ROUNDS << " rounds)\n";
+	std::cout << "  Broadcaster:              " << dynamicRate << " million messages/sec\n";
+	std::cout << "  StaticBroadcaster:        " << staticRate << " million messages/sec, speedup "
+		<< (dynamicRate > 0.0 ? staticRate / dynamicRate : 0.0)
+		<< (staticUnitMap.getChecksum() == dynamicUnitMap.getChecksum() ? "" : " (unit maps differ)") << "\n";
+	std::cout << "  StaticBroadcaster to Map: " << getMillionMessagesPerSecond(mapDuration) << " million messages/sec"
+		<< (mapCleared ? "" : " (unit map not cleared)") << "\n";
+}
@@ -0,0 +1,102 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Core/MinHeap.h"
+#include "Core/Globals.h"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//Push every cell of the grid, decrease the cost of half of them then pop until empty -
+//mirrors the open list usage inside PathFinding::expandFrontier
+namespace
+{
+	constexpr int ROUNDS = 10;
+	constexpr unsigned int SEED = 1;
+
+	struct Operations
+	{
+		double pushSeconds = 0.0;
+		double decreaseCostSeconds = 0.0;
+		double popSeconds = 0.0;
+		size_t pushCount = 0;
+		size_t decreaseCostCount = 0;
+		size_t popCount = 0;
+	};
+
+	double getMillionsPerSecond(size_t count, double seconds)
+	{
+		return seconds > 0.0 ? static_cast<double>(count) / seconds / 1000000.0 : 0.0;
+	}
+
+	void runGrid(glm::ivec2 mapSize)
+	{
+		MinHeap minHeap;
+		minHeap.resize(mapSize);
+
+		std::mt19937 randomEngine(SEED);
+		std::uniform_real_distribution<float> costDistribution(0.f, static_cast<float>(mapSize.x + mapSize.y));
+		std::vector<glm::ivec2> positions;
+		positions.reserve(static_cast<size_t>(mapSize.x) * static_cast<size_t>(mapSize.y));
+		for (int x = 0; x < mapSize.x; ++x)
+		{
+			for (int y = 0; y < mapSize.y; ++y)
+			{
+				positions.emplace_back(x, y);
+			}
+		}
+
+		Operations operations;
+		float checksum = 0.f;
+		for (int round = 0; round < ROUNDS; ++round)
+		{
+			std::shuffle(positions.begin(), positions.end(), randomEngine);
+			std::vector<float> costs(positions.size());
+			for (float& cost : costs)
+			{
+				cost = costDistribution(randomEngine);
+			}
+
+			minHeap.clear();
+			operations.pushSeconds += Harness::measure([&]()
+			{
+				for (size_t i = 0; i < positions.size(); ++i)
+				{
+					minHeap.add({ positions[i], positions[i], costs[Globals::convertTo1D(positions[i], mapSize)], 0.f });
+				}
+			});
+			operations.pushCount += positions.size();
+
+			std::shuffle(positions.begin(), positions.end(), randomEngine);
+			const size_t decreaseCostCount = positions.size() / 2;
+			operations.decreaseCostSeconds += Harness::measure([&]()
+			{
+				for (size_t i = 0; i < decreaseCostCount; ++i)
+				{
+					minHeap.decreaseCost(positions[i], positions[i], costs[Globals::convertTo1D(positions[i], mapSize)] * 0.5f);
+				}
+			});
+			operations.decreaseCostCount += decreaseCostCount;
+
+			operations.popSeconds += Harness::measure([&]()
+			{
+				while (!minHeap.isEmpty())
+				{
+					checksum += minHeap.pop().getCost();
+					++operations.popCount;
+				}
+			});
+		}
+
+		std::cout << "MinHeap " << mapSize.x << "x" << mapSize.y << " (" << ROUNDS << " rounds, checksum " << checksum << ")\n";
+		std::cout << "  push:          " << getMillionsPerSecond(operations.pushCount, operations.pushSeconds) << " Mops/s\n";
+		std::cout << "  decrease cost: " << getMillionsPerSecond(operations.decreaseCostCount, operations.decreaseCostSeconds) << " Mops/s\n";
+		std::cout << "  pop:           " << getMillionsPerSecond(operations.popCount, operations.popSeconds) << " Mops/s\n";
+	}
+}
+
+void Benchmarks::runMinHeap()
+{
+	runGrid({ 60, 60 });
+	runGrid({ 512, 512 });
+}
@@ -0,0 +1,167 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Brawl.h"
+#include "Benchmarks/Harness.h"
+#include "Core/Base.h"
+#include "Entities/Worker.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+//Every faction of a four faction level filled out to a full set of workers, each asking for the nearest mineral nobody
+//else is harvesting at its faction's base - the previous search asking every worker of the faction which mineral it's on
+//against the faction's reservations. Asked again each time one more worker of every faction claims a mineral, until all of
+//them are taken. Both have to pick the same minerals
+namespace
+{
+	constexpr int ROUNDS = 200;
+	constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+	struct Result
+	{
+		double nanoseconds						= 0.0;
+		std::vector<const Mineral*> minerals	= {};
+	};
+
+	//Previous Faction::isMineralInUse
+	bool isMineralInUsePerWorker(const std::vector<const Worker*>& workers, const Mineral& mineral)
+	{
+		return std::any_of(workers.cbegin(), workers.cend(), [&mineral](const auto& worker)
+		{
+			return worker->getMineralToHarvest() && worker->getMineralToHarvest()->getPosition() == mineral.getPosition();
+		});
+	}
+
+	//Previous BaseHandler::getNearestAvailableMineralAtBase
+	const Mineral* getNearestAvailableMineralPerWorker(const std::vector<const Worker*>& workers, const Base& base,
+		const glm::vec3& position)
+	{
+		std::array<const Mineral*, Globals::MAX_MINERALS> minerals;
+		for (int i = 0; i < static_cast<int>(minerals.size()); ++i)
+		{
+			minerals[i] = &base.minerals[i];
+		}
+
+		std::sort(minerals.begin(), minerals.end(), [&position](const auto& mineralA, const auto& mineralB)
+		{
+			return Globals::getSqrDistance(mineralA->getPosition(), position) <
+				Globals::getSqrDistance(mineralB->getPosition(), position);
+		});
+
+		for (const auto& mineral : minerals)
+		{
+			if (!isMineralInUsePerWorker(workers, *mineral))
+			{
+				return mineral;
+			}
+		}
+
+		return nullptr;
+	}
+
+	struct FactionWorkers
+	{
+		const Faction* faction				= nullptr;
+		const Base* base					= nullptr;
+		std::vector<const Worker*> workers	= {};
+	};
+
+	template <typename GetNearestAvailableMineral>
+	Result runQueries(const Level& level, GetNearestAvailableMineral getNearestAvailableMineral)
+	{
+		std::vector<FactionWorkers> factions;
+		for (const auto& faction : level.getFactions())
+		{
+			factions.push_back({ faction.get(), level.getBaseHandler().getNearestBase(faction->getMainHeadquarters()->getPosition()),
+				Harness::getWorkers(*faction) });
+		}
+
+		Result result;
+		size_t queries = 0;
+		result.nanoseconds = Harness::measure<std::nano>([&factions, &getNearestAvailableMineral, &result, &queries]()
+		{
+			for (int round = 0; round < ROUNDS; ++round)
+			{
+				for (const auto& faction : factions)
+				{
+					for (const Worker* worker : faction.workers)
+					{
+						const Mineral* mineral = getNearestAvailableMineral(faction, worker->getPosition());
+						if (round == 0)
+						{
+							result.minerals.push_back(mineral);
+						}
+						++queries;
+					}
+				}
+			}
+		}) / static_cast<double>(queries);
+		return result;
+	}
+}
+
+void Benchmarks::runMinerals()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	std::optional<Level> level;
+	if (!Harness::startWithWorkerResources(level, DELTA_TIME))
+	{
+		return;
+	}
+
+	const Map& map = level->getMap();
+	for (const auto& faction : level->getFactions())
+	{
+		Harness::addWorkers(*level, *faction, 1);
+	}
+
+	std::cout << "Nearest available mineral, " << level->getFactions().size() << " factions of " << Harness::getWorkers(*level->getFactions().front()).size()
+		<< " workers, " << ROUNDS << " rounds (" << Brawl::LEVEL_NAME << ")\n";
+	for (int step = 0; step <= static_cast<int>(Globals::MAX_MINERALS); ++step)
+	{
+		int taken = 0;
+		for (const auto& faction : level->getFactions())
+		{
+			const Base* base = level->getBaseHandler().getNearestBase(faction->getMainHeadquarters()->getPosition());
+			taken += static_cast<int>(std::count_if(base->minerals.cbegin(), base->minerals.cend(), [&faction](const auto& mineral)
+			{
+				return faction->isMineralInUse(mineral);
+			}));
+		}
+
+
+		const Result perWorker = runQueries(*level, [](const FactionWorkers& faction, const glm::vec3& position)
+		{
+			return getNearestAvailableMineralPerWorker(faction.workers, *faction.base, position);
+		});
+		const Result reserved = runQueries(*level, [&level](const FactionWorkers& faction, const glm::vec3& position)
+		{
+			return level->getBaseHandler().getNearestAvailableMineralAtBase(*faction.faction, *faction.base, position);
+		});
+
+		std::cout << "  " << taken << " of " << Globals::MAX_MINERALS * level->getFactions().size() << " taken: per worker " << perWorker.nanoseconds
+			<< " ns/query, reserved " << reserved.nanoseconds << " ns/query, speedup "
+			<< (reserved.nanoseconds > 0.0 ? perWorker.nanoseconds / reserved.nanoseconds : 0.0)
+			<< (perWorker.minerals == reserved.minerals ? "" : " (picks differ)") << "\n";
+
+		//The next worker of every faction claims what it was given
+		for (const auto& faction : level->getFactions())
+		{
+			const Base* base = level->getBaseHandler().getNearestBase(faction->getMainHeadquarters()->getPosition());
+			const std::vector<const Worker*> workers = Harness::getWorkers(*faction);
+			if (step < static_cast<int>(workers.size()))
+			{
+				Entity* worker = faction->get_entity(workers[step]->getID());
+				if (const Mineral* mineral = level->getBaseHandler().getNearestAvailableMineralAtBase(*faction, *base, worker->getPosition()))
+				{
+					worker->Harvest(*mineral, map);
+				}
+			}
+		}
+	}
+}
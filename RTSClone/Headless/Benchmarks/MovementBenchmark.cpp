@@ -0,0 +1,165 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Core/Globals.h"
+#include "Core/MovementCore.h"
+#include "Entities/Entity.h"
+#include "Graphics/ModelManager.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//Cost of the per tick movement pass per 1,000 moving units - the previous step inside every Unit::update
+//against MovementCore::integrate over contiguous arrays followed by each unit copying its position back.
+//Units walk random paths long enough that none of them arrive - both have to end in the same positions
+namespace
+{
+	constexpr int MAP_SIZE = 128;
+	constexpr int PATH_LENGTH = 64;
+	constexpr int TICKS = 1000;
+	constexpr float DELTA_TIME = 1.0f / 60.0f;
+	constexpr float MOVEMENT_SPEED = 10.f;
+	constexpr unsigned int SEED = 1;
+	const std::array<int, 3> UNIT_COUNTS = { 1000, 4000, 16000 };
+
+	//Stand-in unit holding only what the movement step touches
+	class MovingProbe : public Entity
+	{
+	public:
+		MovingProbe(MovementCore& movementCore, const glm::vec3& position, std::vector<glm::vec3>&& path)
+			: Entity(ModelManager::getInstance().getModel(UNIT_MODEL_NAME),
+				Position(position, GridLockActive::False), eEntityType::Unit, 1, 0),
+			m_path(std::move(path)),
+			m_slot(movementCore, position, MOVEMENT_SPEED)
+		{
+			m_slot.setPath(m_position.Get(), m_rotation.y, m_path);
+		}
+
+		bool is_group_selectable() const override { return false; }
+
+		//Previous Unit::update
+		void move(float deltaTime)
+		{
+			if (!m_path.empty())
+			{
+				glm::vec3 newPosition = Globals::moveTowards(m_position.Get(), m_path.back(), MOVEMENT_SPEED * deltaTime);
+				m_rotation.y = Globals::getAngle(newPosition, m_position.Get());
+				setPosition(newPosition);
+
+				if (m_position.Get() == m_path.back())
+				{
+					m_path.pop_back();
+				}
+			}
+		}
+
+		//Unit::update after MovementCore::integrate
+		void copyFromMovementCore()
+		{
+			if (!m_path.empty())
+			{
+				m_rotation.y = m_slot.getRotation();
+				setPosition(m_slot.getPosition());
+
+				if (m_position.Get() == m_path.back())
+				{
+					m_path.pop_back();
+					m_slot.setPath(m_position.Get(), m_rotation.y, m_path);
+				}
+			}
+		}
+
+	private:
+		std::vector<glm::vec3> m_path;
+		MovementSlot m_slot;
+	};
+
+	//Random walk over neighbouring nodes, held back to front like every other path
+	void createProbes(int unitCount, MovementCore& movementCore, std::vector<MovingProbe>& probes)
+	{
+		std::mt19937 randomEngine(SEED);
+		std::uniform_int_distribution<int> positionDistribution(0, MAP_SIZE - 1);
+		std::uniform_int_distribution<int> directionDistribution(-1, 1);
+		probes.reserve(unitCount);
+		for (int i = 0; i < unitCount; ++i)
+		{
+			glm::ivec2 position(positionDistribution(randomEngine), positionDistribution(randomEngine));
+			const glm::vec3 startingPosition = Globals::convertToWorldPosition(position);
+			std::vector<glm::vec3> path;
+			for (int waypoint = 0; waypoint < PATH_LENGTH; ++waypoint)
+			{
+				glm::ivec2 direction(directionDistribution(randomEngine), directionDistribution(randomEngine));
+				position += direction == glm::ivec2(0) ? glm::ivec2(1, 0) : direction;
+				path.push_back(Globals::convertToWorldPosition(position));
+			}
+
+			std::reverse(path.begin(), path.end());
+			probes.emplace_back(movementCore, startingPosition, std::move(path));
+		}
+	}
+
+	double getNanosecondsPer1000Units(double nanoseconds, int unitCount)
+	{
+		return nanoseconds / TICKS / unitCount * 1000.0;
+	}
+}
+
+void Benchmarks::runMovement()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	std::cout << "Movement (" << TICKS << " ticks, paths of " << PATH_LENGTH << " nodes)\n";
+	for (int unitCount : UNIT_COUNTS)
+	{
+		MovementCore perUnitCore;
+		std::vector<MovingProbe> perUnitProbes;
+		createProbes(unitCount, perUnitCore, perUnitProbes);
+		const double perUnit = Harness::measure<std::nano>([&perUnitProbes]()
+		{
+			for (int tick = 0; tick < TICKS; ++tick)
+			{
+				for (auto& probe : perUnitProbes)
+				{
+					probe.move(DELTA_TIME);
+				}
+			}
+		});
+
+		MovementCore movementCore;
+		std::vector<MovingProbe> probes;
+		createProbes(unitCount, movementCore, probes);
+		double integrate = 0.0;
+		double copy = 0.0;
+		for (int tick = 0; tick < TICKS; ++tick)
+		{
+			integrate += Harness::measure<std::nano>([&movementCore]() { movementCore.integrate(DELTA_TIME); });
+			copy += Harness::measure<std::nano>([&probes]()
+			{
+				for (auto& probe : probes)
+				{
+					probe.copyFromMovementCore();
+				}
+			});
+		}
+
+		bool matching = true;
+		for (int i = 0; i < unitCount; ++i)
+		{
+			matching = matching && perUnitProbes[i].getPosition() == probes[i].getPosition();
+		}
+
+		const double perUnitNanoseconds = getNanosecondsPer1000Units(perUnit, unitCount);
+		const double integrateNanoseconds = getNanosecondsPer1000Units(integrate, unitCount);
+		const double copyNanoseconds = getNanosecondsPer1000Units(copy, unitCount);
+		std::cout << "  " << unitCount << " units\n";
+		std::cout << "    per unit:    " << perUnitNanoseconds << " ns/tick per 1000 units\n";
+		std::cout << "    integrate:   " << integrateNanoseconds << " ns/tick per 1000 units, speedup "
+			<< (integrateNanoseconds > 0.0 ? perUnitNanoseconds / integrateNanoseconds : 0.0) << "\n";
+		std::cout << "    + copy back: " << integrateNanoseconds + copyNanoseconds << " ns/tick per 1000 units"
+			<< (matching ? "" : " (positions differ from per unit)") << "\n";
+	}
+}
@@ -0,0 +1,99 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Core/Map.h"
+#include "Graphics/ModelManager.h"
+#include <array>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//Map::isAABBOccupied for building sized AABBs against the previous walk over every whole world position
+//inside the AABB - both have to agree on every query
+namespace
+{
+	constexpr int MAP_SIZE = 256;
+	constexpr int QUERY_COUNT = 100000;
+	constexpr int ROUNDS = 10;
+	constexpr unsigned int SEED = 1;
+	constexpr float OBSTACLE_COVERAGE = 0.15f;
+	const std::array<eEntityType, 5> BUILDING_TYPES =
+	{
+		eEntityType::Headquarters,
+		eEntityType::SupplyDepot,
+		eEntityType::Barracks,
+		eEntityType::Turret,
+		eEntityType::Laboratory
+	};
+
+	bool isAABBOccupiedPerPosition(const AABB& AABB, const Map& map)
+	{
+		for (int x = static_cast<int>(AABB.getLeft()); x < static_cast<int>(AABB.getRight()); ++x)
+		{
+			for (int y = static_cast<int>(AABB.getBack()); y < static_cast<int>(AABB.getForward()); ++y)
+			{
+				if (map.isPositionOccupied(glm::vec3(x, Globals::GROUND_HEIGHT, y)))
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	template <typename Function>
+	double getQueriesPerSecond(const std::vector<AABB>& queries, Function function, int& occupied)
+	{
+		occupied = 0;
+		const double seconds = Harness::measure([&queries, &function, &occupied]()
+		{
+			for (int round = 0; round < ROUNDS; ++round)
+			{
+				for (const auto& query : queries)
+				{
+					occupied += function(query) ? 1 : 0;
+				}
+			}
+		});
+		return seconds > 0.0 ? static_cast<double>(queries.size() * ROUNDS) / seconds / 1000000.0 : 0.0;
+	}
+}
+
+void Benchmarks::runOccupancy()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	std::mt19937 randomEngine(SEED);
+	std::uniform_int_distribution<int> positionDistribution(0, MAP_SIZE - 1);
+	std::uniform_int_distribution<size_t> buildingDistribution(0, BUILDING_TYPES.size() - 1);
+	Map map({}, {}, { MAP_SIZE, MAP_SIZE });
+	Harness::addObstacles(map, OBSTACLE_COVERAGE, randomEngine);
+
+	std::vector<AABB> queries;
+	queries.reserve(QUERY_COUNT);
+	while (static_cast<int>(queries.size()) < QUERY_COUNT)
+	{
+		const glm::vec3 position = Globals::convertToWorldPosition(
+			glm::ivec2(positionDistribution(randomEngine), positionDistribution(randomEngine)));
+		AABB query = ModelManager::getInstance().getModelAABB(position, BUILDING_TYPES[buildingDistribution(randomEngine)]);
+		if (map.isWithinBounds(query))
+		{
+			queries.push_back(query);
+		}
+	}
+
+	int perPositionOccupied = 0;
+	int occupied = 0;
+	const double perPosition = getQueriesPerSecond(queries, [&map](const AABB& AABB) { return isAABBOccupiedPerPosition(AABB, map); },
+		perPositionOccupied);
+	const double rectangle = getQueriesPerSecond(queries, [&map](const AABB& AABB) { return map.isAABBOccupied(AABB); }, occupied);
+
+	std::cout << "Occupancy " << MAP_SIZE << "x" << MAP_SIZE << " (" << QUERY_COUNT << " building AABBs, " << ROUNDS << " rounds, "
+		<< occupied / ROUNDS << " occupied)\n";
+	std::cout << "  per position: " << perPosition << " Mqueries/s\n";
+	std::cout << "  rectangle:    " << rectangle << " Mqueries/s, speedup " << (perPosition > 0.0 ? rectangle / perPosition : 0.0)
+		<< (occupied == perPositionOccupied ? "" : " (results differ from per position)") << "\n";
+}
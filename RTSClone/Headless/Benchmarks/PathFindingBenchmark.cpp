@@ -0,0 +1,126 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Benchmarks/PathFindingProbe.h"
+#include "Core/Map.h"
+#include "Core/PathFinding.h"
+#include "Model/AdjacentPositions.h"
+#include <array>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+//Short Theta* queries (destination within a few nodes), long Theta* queries (destination anywhere)
+//and BFS queries on each shipped level
+namespace
+{
+	constexpr int QUERY_COUNT = 2000;
+	constexpr int SHORT_QUERY_DISTANCE = 4;
+	constexpr unsigned int SEED = 1;
+	const std::array<std::string_view, 3> LEVEL_NAMES = { "Level1.txt", "Level2.txt", "Level4.txt" };
+
+	struct QueryResults
+	{
+		double seconds = 0.0;
+		size_t checksum = 0;
+		int found = 0;
+	};
+
+	size_t getChecksum(const std::vector<glm::vec3>& path, const Map& map)
+	{
+		size_t checksum = 0;
+		for (const auto& position : path)
+		{
+			checksum += static_cast<size_t>(Globals::convertTo1D(Globals::convertToGridPosition(position), map.getSize()));
+		}
+
+		return checksum;
+	}
+
+	template <typename Query>
+	QueryResults runQueries(Query query)
+	{
+		QueryResults results;
+		results.seconds = Harness::measure([&query, &results]()
+		{
+			for (int i = 0; i < QUERY_COUNT; ++i)
+			{
+				query(results);
+			}
+		});
+
+		return results;
+	}
+
+	void printResults(std::string_view name, const QueryResults& results)
+	{
+		std::cout << "  " << name << results.seconds * 1000000.0 / QUERY_COUNT << " us/query (found " << results.found
+			<< ", checksum " << results.checksum << ")\n";
+	}
+
+	void runLevel(std::string_view levelName)
+	{
+		std::optional<LevelDetailsFromFile> levelDetails = Harness::load(levelName);
+		if (!levelDetails)
+		{
+			return;
+		}
+
+		Map map(levelDetails->scenery, levelDetails->bases, levelDetails->gridSize);
+		const std::vector<glm::ivec2> freePositions = Harness::getFreePositions(map);
+
+		std::mt19937 randomEngine(SEED);
+		std::uniform_int_distribution<size_t> freePositionDistribution(0, freePositions.size() - 1);
+		std::uniform_int_distribution<int> offsetDistribution(-SHORT_QUERY_DISTANCE, SHORT_QUERY_DISTANCE);
+		PathFindingProbe probe;
+		std::vector<glm::vec3> path;
+
+		const QueryResults shortQueries = runQueries([&](QueryResults& results)
+		{
+			const glm::ivec2 start = freePositions[freePositionDistribution(randomEngine)];
+			const glm::ivec2 destination = start + glm::ivec2(offsetDistribution(randomEngine), offsetDistribution(randomEngine));
+			probe.setGridPosition(start);
+			PathFinding::getInstance().getPathToPosition(probe, Globals::convertToWorldPosition(destination), path, map, createAdjacentPositions(map));
+			results.found += path.empty() ? 0 : 1;
+			results.checksum += getChecksum(path, map);
+		});
+
+		const QueryResults longQueries = runQueries([&](QueryResults& results)
+		{
+			probe.setGridPosition(freePositions[freePositionDistribution(randomEngine)]);
+			const glm::ivec2 destination = freePositions[freePositionDistribution(randomEngine)];
+			PathFinding::getInstance().getPathToPosition(probe, Globals::convertToWorldPosition(destination), path, map, createAdjacentPositions(map));
+			results.found += path.empty() ? 0 : 1;
+			results.checksum += getChecksum(path, map);
+		});
+
+		const QueryResults BFSQueries = runQueries([&](QueryResults& results)
+		{
+			probe.setGridPosition(freePositions[freePositionDistribution(randomEngine)]);
+			glm::vec3 position(0.0f);
+			if (PathFinding::getInstance().getRandomPositionOutsideAABB(probe, map, position))
+			{
+				++results.found;
+				results.checksum += getChecksum({ position }, map);
+			}
+		});
+
+		std::cout << "PathFinding " << levelName << " " << map.getSize().x << "x" << map.getSize().y << " (" << QUERY_COUNT << " queries each)\n";
+		printResults("theta* short: ", shortQueries);
+		printResults("theta* long:  ", longQueries);
+		printResults("bfs:          ", BFSQueries);
+	}
+}
+
+void Benchmarks::runPathFinding()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	for (std::string_view levelName : LEVEL_NAMES)
+	{
+		runLevel(levelName);
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Entities/Entity.h"
+#include "Core/Globals.h"
+#include "Graphics/ModelManager.h"
+
+//Stand-in worker so path finding queries can be made from any grid position without a faction
+class PathFindingProbe : public Entity
+{
+public:
+	PathFindingProbe()
+		: Entity(ModelManager::getInstance().getModel(WORKER_MODEL_NAME),
+			Position(glm::vec3(0.0f), GridLockActive::False), eEntityType::Worker, 1, 0)
+	{}
+
+	bool is_group_selectable() const override { return false; }
+
+	void setGridPosition(glm::ivec2 position)
+	{
+		setPosition(Globals::convertToWorldPosition(position));
+		m_AABB.update(getPosition());
+	}
+};
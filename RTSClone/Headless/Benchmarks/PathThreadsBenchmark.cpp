@@ -0,0 +1,91 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Benchmarks/PathFindingProbe.h"
+#include "Core/Map.h"
+#include "Core/PathFinding.h"
+#include "Model/AdjacentPositions.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+//A large battle's worth of independent queries solved through PathFinding::getPaths with a growing number of threads.
+//Every thread count has to give the same paths as one thread
+namespace
+{
+	constexpr int MAP_SIZE = 256;
+	constexpr int QUERY_COUNT = 256;
+	constexpr int ROUNDS = 5;
+	constexpr unsigned int SEED = 1;
+	constexpr float OBSTACLE_COVERAGE = 0.15f;
+	const std::array<int, 4> THREAD_COUNTS = { 1, 2, 4, 8 };
+
+	double runQueries(std::vector<PathQuery>& queries, const Map& map, int threadCount, std::vector<std::vector<glm::vec3>>& paths)
+	{
+		PathFinding::getInstance().setThreadCount(threadCount);
+		double seconds = 0.0;
+		for (int round = 0; round < ROUNDS; ++round)
+		{
+			seconds += Harness::measure([&queries, &map]() { PathFinding::getInstance().getPaths(queries, map); });
+		}
+
+		paths.clear();
+		for (const auto& query : queries)
+		{
+			paths.push_back(query.path);
+		}
+
+		return seconds / ROUNDS;
+	}
+}
+
+void Benchmarks::runPathThreads()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	const int initialThreadCount = PathFinding::getInstance().getThreadCount();
+	std::mt19937 randomEngine(SEED);
+	std::uniform_int_distribution<int> positionDistribution(0, MAP_SIZE - 1);
+	Map map({}, {}, { MAP_SIZE, MAP_SIZE });
+	Harness::addObstacles(map, OBSTACLE_COVERAGE, randomEngine);
+
+	std::vector<PathFindingProbe> probes(QUERY_COUNT);
+	std::vector<PathQuery> queries;
+	while (static_cast<int>(queries.size()) < QUERY_COUNT)
+	{
+		const glm::ivec2 startingPosition(positionDistribution(randomEngine), positionDistribution(randomEngine));
+		const glm::ivec2 destination(positionDistribution(randomEngine), positionDistribution(randomEngine));
+		if (!map.isPositionOccupied(startingPosition) && !map.isPositionOccupied(destination) &&
+			Globals::getDistance(destination, startingPosition) >= static_cast<float>(MAP_SIZE) / 4.0f)
+		{
+			PathFindingProbe& probe = probes[queries.size()];
+			probe.setGridPosition(startingPosition);
+
+			PathQuery query;
+			query.entity = &probe;
+			query.destination = Globals::convertToWorldPosition(destination);
+			query.adjacentPositions = createAdjacentPositions(map);
+			queries.push_back(std::move(query));
+		}
+	}
+
+	std::cout << "Path threads " << MAP_SIZE << "x" << MAP_SIZE << " (" << QUERY_COUNT << " queries, "
+		<< std::thread::hardware_concurrency() << " hardware threads)\n";
+	std::vector<std::vector<glm::vec3>> singleThreadPaths;
+	const double singleThreadSeconds = runQueries(queries, map, 1, singleThreadPaths);
+	std::vector<std::vector<glm::vec3>> paths;
+	for (int threadCount : THREAD_COUNTS)
+	{
+		const double seconds = threadCount == 1 ? singleThreadSeconds : runQueries(queries, map, threadCount, paths);
+		const bool samePaths = threadCount == 1 || paths == singleThreadPaths;
+		std::cout << "  " << threadCount << " threads: " << seconds * 1000.0 << " ms, speedup " << singleThreadSeconds / seconds
+			<< (samePaths ? "" : " (paths differ from one thread)") << "\n";
+	}
+
+	PathFinding::getInstance().setThreadCount(initialThreadCount);
+}
@@ -0,0 +1,266 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Brawl.h"
+#include "Benchmarks/Harness.h"
+#include "Core/Map.h"
+#include "Core/PathSegmentIndex.h"
+#include "Entities/EntitySpawnerBuilding.h"
+#include "Graphics/ModelManager.h"
+#include "Model/ProjectilePool.h"
+#include <algorithm>
+#include <initializer_list>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+//Twenty turrets per faction firing without pause at the units of every other faction across the map - the
+//previous vector of Projectiles, each with its own AABB and removed through remove_if, against ProjectilePool.
+//Targets stand still and take no damage so the fire never lets up. Both have to raise the same hits in the same order
+namespace
+{
+	constexpr int TURRETS_PER_FACTION = static_cast<int>(Globals::MAX_TURRETS);
+	constexpr int UNITS_PER_FACTION = static_cast<int>(Globals::MAX_UNITS);
+	constexpr int FIRE_INTERVAL_TICKS = 6;
+	constexpr int DAMAGE = 2;
+	constexpr int TICKS = 1800;
+	constexpr float DELTA_TIME = 1.0f / 60.0f;
+	constexpr float MOVEMENT_SPEED = 100.0f;
+
+	struct StandInTurret
+	{
+		size_t factionIndex			= 0;
+		eFactionController faction	= eFactionController::None;
+		int ID						= Globals::INVALID_ENTITY_ID;
+		glm::vec3 position			= {};
+	};
+
+	struct Target
+	{
+		eFactionController faction	= eFactionController::None;
+		int ID						= Globals::INVALID_ENTITY_ID;
+		glm::vec3 position			= {};
+	};
+
+	//Previous Projectile
+	class PreviousProjectile
+	{
+	public:
+		PreviousProjectile(const SpawnProjectileEvent& gameEvent)
+			: m_senderEvent(gameEvent),
+			m_position(gameEvent.spawnPosition),
+			m_previousPosition(m_position),
+			m_AABB(m_position, ModelManager::getInstance().getModel(PROJECTILE_MODEL_NAME))
+		{}
+
+		const AABB& getAABB() const
+		{
+			return m_AABB;
+		}
+
+		const SpawnProjectileEvent& getSenderEvent() const
+		{
+			return m_senderEvent;
+		}
+
+		bool isReachedDestination() const
+		{
+			return m_position == m_senderEvent.destination;
+		}
+
+		void update(float deltaTime)
+		{
+			m_previousPosition = m_position;
+			m_position = Globals::moveTowards(m_position, m_senderEvent.destination, MOVEMENT_SPEED * deltaTime);
+			m_AABB.update(m_position);
+		}
+
+	private:
+		SpawnProjectileEvent m_senderEvent;
+		glm::vec3 m_position;
+		glm::vec3 m_previousPosition;
+		AABB m_AABB;
+	};
+
+	struct Result
+	{
+		double microseconds			= 0.0;
+		int hits					= 0;
+		size_t mostInFlight			= 0;
+		double averageInFlight		= 0.0;
+		uint64_t hitsHash			= Harness::FNV_OFFSET_BASIS;
+	};
+
+	void addHit(Result& result, const TakeDamageEvent& hit)
+	{
+		++result.hits;
+		for (int value : { hit.senderID, hit.targetID, hit.damage })
+		{
+			Harness::hash(result.hitsHash, value);
+		}
+	}
+
+	//Each turret fires at every other faction in turn and at the next of its units each time round,
+	//staggered over the fire interval
+	template <typename AddProjectile>
+	void fire(int tick, const std::vector<StandInTurret>& turrets, const std::vector<std::vector<Target>>& targets, AddProjectile addProjectile)
+	{
+		const size_t opposingFactionCount = targets.size() - 1;
+		for (size_t i = 0; i < turrets.size(); ++i)
+		{
+			if ((tick + static_cast<int>(i)) % FIRE_INTERVAL_TICKS != 0)
+			{
+				continue;
+			}
+
+			const size_t shot = static_cast<size_t>(tick / FIRE_INTERVAL_TICKS) + i;
+			const std::vector<Target>& opposingTargets = targets[(turrets[i].factionIndex + 1 + shot % opposingFactionCount) % targets.size()];
+			const Target& target = opposingTargets[(shot / opposingFactionCount) % opposingTargets.size()];
+			addProjectile(SpawnProjectileEvent{ turrets[i].faction, turrets[i].ID, eEntityType::Turret, target.faction,
+				target.ID, eEntityType::Unit, DAMAGE, turrets[i].position, target.position });
+		}
+	}
+
+	Result playPrevious(const FactionHandler& factionHandler, const std::vector<StandInTurret>& turrets,
+		const std::vector<std::vector<Target>>& targets)
+	{
+		Result result;
+		std::vector<PreviousProjectile> projectiles;
+		result.microseconds = Harness::measure<std::micro>([&factionHandler, &turrets, &targets, &result, &projectiles]()
+		{
+			for (int tick = 0; tick < TICKS; ++tick)
+			{
+				fire(tick, turrets, targets, [&projectiles](const SpawnProjectileEvent& gameEvent)
+				{
+					projectiles.emplace_back(gameEvent);
+				});
+
+				for (auto& projectile : projectiles)
+				{
+					projectile.update(DELTA_TIME);
+				}
+
+				projectiles.erase(std::remove_if(projectiles.begin(), projectiles.end(), [&factionHandler, &result](const auto& projectile)
+				{
+					const SpawnProjectileEvent& senderEvent = projectile.getSenderEvent();
+					const Entity* target = nullptr;
+					if (const Faction* targetFaction = factionHandler.getFaction(senderEvent.targetFaction))
+					{
+						target = targetFaction->get_entity(senderEvent.targetID);
+					}
+
+					const bool hitEntity = target && target->getAABB().contains(projectile.getAABB());
+					if (hitEntity)
+					{
+						addHit(result, { senderEvent.senderFaction, senderEvent.senderID, senderEvent.senderEntityType,
+							senderEvent.targetFaction, senderEvent.targetID, senderEvent.damage });
+					}
+					return hitEntity || projectile.isReachedDestination();
+				}), projectiles.end());
+
+				result.mostInFlight = std::max(result.mostInFlight, projectiles.size());
+				result.averageInFlight += static_cast<double>(projectiles.size()) / TICKS;
+			}
+		}) / TICKS;
+		return result;
+	}
+
+	Result playPool(const FactionHandler& factionHandler, const std::vector<StandInTurret>& turrets,
+		const std::vector<std::vector<Target>>& targets)
+	{
+		Result result;
+		ProjectilePool projectiles;
+		std::vector<TakeDamageEvent> hits;
+		result.microseconds = Harness::measure<std::micro>([&factionHandler, &turrets, &targets, &result, &projectiles, &hits]()
+		{
+			for (int tick = 0; tick < TICKS; ++tick)
+			{
+				fire(tick, turrets, targets, [&projectiles](const SpawnProjectileEvent& gameEvent)
+				{
+					projectiles.add(gameEvent);
+				});
+
+				projectiles.update(DELTA_TIME, factionHandler, hits);
+				for (const auto& hit : hits)
+				{
+					addHit(result, hit);
+				}
+				hits.clear();
+
+				result.mostInFlight = std::max(result.mostInFlight, projectiles.getSize());
+				result.averageInFlight += static_cast<double>(projectiles.getSize()) / TICKS;
+			}
+		}) / TICKS;
+		return result;
+	}
+}
+
+void Benchmarks::runProjectiles()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	std::optional<LevelDetailsFromFile> levelDetails = Harness::loadBrawl();
+	if (!levelDetails)
+	{
+		return;
+	}
+
+	levelDetails->factionStartingResources += Globals::UNIT_RESOURCE_COST * UNITS_PER_FACTION;
+	BaseHandler baseHandler(std::move(levelDetails->bases));
+	const Map map(levelDetails->scenery, baseHandler.getBases(), levelDetails->gridSize);
+	//Units report their paths to it as a level's do, destroyed ones included
+	PathSegmentIndex pathSegments(levelDetails->gridSize);
+	FactionHandler factionHandler(baseHandler, *levelDetails, true);
+
+	//Units packed around each headquarters with the turrets on the ring past them
+	std::vector<StandInTurret> turrets;
+	std::vector<std::vector<Target>> targets;
+	int targetCount = 0;
+	for (auto& faction : factionHandler.getFactions())
+	{
+		const std::vector<glm::vec3> positions = Brawl::getFreePositions(map, faction->getMainHeadquarters()->getPosition(),
+			UNITS_PER_FACTION + TURRETS_PER_FACTION);
+		targets.emplace_back();
+		for (int i = 0; i < static_cast<int>(positions.size()); ++i)
+		{
+			if (i < UNITS_PER_FACTION)
+			{
+				EntityToSpawnFromBuilding entityToSpawn;
+				entityToSpawn.position = positions[i];
+				entityToSpawn.type = eEntityType::Unit;
+				if (const Entity* unit = faction->createUnit(entityToSpawn, map))
+				{
+					targets.back().push_back({ faction->getController(), unit->getID(), unit->getPosition() });
+					++targetCount;
+				}
+			}
+			else
+			{
+				turrets.push_back({ targets.size() - 1, faction->getController(), static_cast<int>(turrets.size()), positions[i] });
+			}
+		}
+
+		if (targets.back().empty())
+		{
+			std::cout << "Unable to place units on " << Brawl::LEVEL_NAME << "\n";
+			return;
+		}
+	}
+
+	if (turrets.empty())
+	{
+		std::cout << "Unable to place turrets on " << Brawl::LEVEL_NAME << "\n";
+		return;
+	}
+
+	const Result previous = playPrevious(factionHandler, turrets, targets);
+	const Result pool = playPool(factionHandler, turrets, targets);
+	std::cout << "Projectiles, " << turrets.size() << " turrets firing every " << FIRE_INTERVAL_TICKS << " ticks at "
+		<< targetCount << " units (" << TICKS << " ticks, " << Brawl::LEVEL_NAME << ")\n";
+	std::cout << "  in flight: " << pool.averageInFlight << " on average, " << pool.mostInFlight << " at most\n";
+	std::cout << "  Projectile:     " << previous.microseconds << " us/tick, " << previous.hits << " hits\n";
+	std::cout << "  ProjectilePool: " << pool.microseconds << " us/tick, " << pool.hits << " hits, speedup "
+		<< (pool.microseconds > 0.0 ? previous.microseconds / pool.microseconds : 0.0)
+		<< (pool.hitsHash == previous.hitsHash && pool.hits == previous.hits ? "" : " (hits differ)") << "\n";
+}
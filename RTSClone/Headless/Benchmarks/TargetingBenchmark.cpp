@@ -0,0 +1,135 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Benchmarks/PathFindingProbe.h"
+#include "Core/EntitySpatialIndex.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+//Faction::getEntity target acquisition from the spatial index against the previous walk over every entity
+//the faction owns, as the faction grows. Entities are scattered over a Level sized map and a fraction
+//of them move between rounds - both have to pick the same target for every query
+namespace
+{
+	constexpr int MAP_SIZE = 128;
+	constexpr int QUERY_COUNT = 20000;
+	constexpr int ROUNDS = 10;
+	constexpr unsigned int SEED = 1;
+	constexpr float MOVING_FRACTION = 0.25f;
+	const std::array<int, 5> ENTITY_COUNTS = { 10, 50, 100, 500, 2000 };
+
+	//Previous Faction::getEntity
+	const Entity* getEntityPerEntity(const std::vector<const Entity*>& entities, const glm::vec3& position, float maxDistance)
+	{
+		const Entity* closestEntity = nullptr;
+		float closestEntityDistance = maxDistance * maxDistance;
+		for (const auto& entity : entities)
+		{
+			float distance = Globals::getSqrDistance(entity->getPosition(), position);
+			if (!closestEntity && distance < closestEntityDistance)
+			{
+				closestEntity = &*entity;
+				closestEntityDistance = distance;
+			}
+			else if (closestEntity && Globals::BUILDING_TYPES.isMatch(closestEntity->getEntityType()) &&
+				Globals::UNIT_TYPES.isMatch(entity->getEntityType()) &&
+				Globals::getSqrDistance(entity->getPosition(), position) < maxDistance * maxDistance)
+			{
+				closestEntity = &*entity;
+				closestEntityDistance = distance;
+			}
+			else if (closestEntity && distance < closestEntityDistance)
+			{
+				closestEntity = &*entity;
+				closestEntityDistance = distance;
+			}
+		}
+
+		return closestEntity;
+	}
+
+	template <typename Function>
+	double getMicrosecondsPerQuery(const std::vector<glm::vec3>& queries, Function function, std::vector<int>& targetIDs)
+	{
+		targetIDs.clear();
+		return Harness::measure<std::micro>([&queries, &function, &targetIDs]()
+		{
+			for (const auto& query : queries)
+			{
+				const Entity* target = function(query);
+				targetIDs.push_back(target ? target->getID() : -1);
+			}
+		}) / static_cast<double>(queries.size());
+	}
+}
+
+void Benchmarks::runTargeting()
+{
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	std::cout << "Targeting " << MAP_SIZE << "x" << MAP_SIZE << " (" << QUERY_COUNT << " queries, " << ROUNDS << " rounds, range "
+		<< Globals::UNIT_ATTACK_RANGE << ")\n";
+	for (int entityCount : ENTITY_COUNTS)
+	{
+		std::mt19937 randomEngine(SEED);
+		std::uniform_int_distribution<int> positionDistribution(0, MAP_SIZE - 1);
+		std::uniform_int_distribution<int> entityDistribution(0, entityCount - 1);
+		std::vector<std::unique_ptr<PathFindingProbe>> probes;
+		std::vector<const Entity*> entities;
+		EntitySpatialIndex entityIndex;
+		for (int i = 0; i < entityCount; ++i)
+		{
+			probes.push_back(std::make_unique<PathFindingProbe>());
+			probes.back()->setGridPosition({ positionDistribution(randomEngine), positionDistribution(randomEngine) });
+			entities.push_back(probes.back().get());
+			entityIndex.add(*probes.back());
+		}
+
+		double perEntity = 0.0;
+		double indexed = 0.0;
+		bool matching = true;
+		int found = 0;
+		std::vector<glm::vec3> queries(QUERY_COUNT);
+		std::vector<int> perEntityTargetIDs;
+		std::vector<int> indexedTargetIDs;
+		for (int round = 0; round < ROUNDS; ++round)
+		{
+			for (int i = 0; i < static_cast<int>(MOVING_FRACTION * static_cast<float>(entityCount)); ++i)
+			{
+				PathFindingProbe& probe = *probes[entityDistribution(randomEngine)];
+				probe.setGridPosition({ positionDistribution(randomEngine), positionDistribution(randomEngine) });
+				entityIndex.update(probe);
+			}
+
+			for (auto& query : queries)
+			{
+				query = Globals::convertToWorldPosition(glm::ivec2(positionDistribution(randomEngine), positionDistribution(randomEngine)));
+			}
+
+			perEntity += getMicrosecondsPerQuery(queries, [&entities](const glm::vec3& position)
+			{
+				return getEntityPerEntity(entities, position, Globals::UNIT_ATTACK_RANGE);
+			}, perEntityTargetIDs);
+			indexed += getMicrosecondsPerQuery(queries, [&entityIndex](const glm::vec3& position)
+			{
+				return entityIndex.getClosestEntity(position, Globals::UNIT_ATTACK_RANGE, true);
+			}, indexedTargetIDs);
+
+			matching = matching && perEntityTargetIDs == indexedTargetIDs;
+			found += static_cast<int>(std::count_if(indexedTargetIDs.cbegin(), indexedTargetIDs.cend(), [](int ID) { return ID != -1; }));
+		}
+
+		perEntity /= ROUNDS;
+		indexed /= ROUNDS;
+		std::cout << "  " << entityCount << " entities (" << found / ROUNDS << " found)\n";
+		std::cout << "    per entity: " << perEntity << " us/query\n";
+		std::cout << "    indexed:    " << indexed << " us/query, speedup " << (indexed > 0.0 ? perEntity / indexed : 0.0)
+			<< (matching ? "" : " (targets differ from per entity)") << "\n";
+	}
+}
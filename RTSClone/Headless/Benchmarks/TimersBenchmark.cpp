@@ -0,0 +1,139 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Harness.h"
+#include "Core/Timer.h"
+#include <array>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//Cooldowns of growing numbers of entities - the previous Timer, which every entity advanced every tick, against
+//Timer measured from the simulation clock. Each tick every timer is checked, then only one in ten of them as
+//entities that are idle or out of range don't look at their cooldowns. Both have to expire the same number of times
+namespace
+{
+	constexpr int TICKS = 1800;
+	constexpr float DELTA_TIME = 1.0f / 60.0f;
+	constexpr float MIN_EXPIRATION_TIME = 0.2f;
+	constexpr float MAX_EXPIRATION_TIME = 2.0f;
+	constexpr unsigned int SEED = 1;
+	const std::array<int, 3> TIMER_COUNTS = { 1000, 10000, 100000 };
+	const std::array<int, 2> CHECK_INTERVALS = { 1, 10 };
+
+	//Previous Timer
+	class TimerPerUpdate
+	{
+	public:
+		TimerPerUpdate(float expirationTime)
+			: m_expirationTime(expirationTime),
+			m_elaspedTime(0.0f)
+		{}
+
+		bool isExpired() const
+		{
+			return m_elaspedTime >= m_expirationTime;
+		}
+
+		void update(float deltaTime)
+		{
+			m_elaspedTime += deltaTime;
+		}
+
+		void resetElaspedTime()
+		{
+			m_elaspedTime = 0.0f;
+		}
+
+	private:
+		float m_expirationTime;
+		float m_elaspedTime;
+	};
+
+	struct Result
+	{
+		double nanoseconds	= 0.0;
+		long long expired	= 0;
+	};
+
+	std::vector<float> getExpirationTimes(int timerCount)
+	{
+		std::mt19937 randomEngine(SEED);
+		std::uniform_int_distribution<int> ticksDistribution(static_cast<int>(MIN_EXPIRATION_TIME / DELTA_TIME),
+			static_cast<int>(MAX_EXPIRATION_TIME / DELTA_TIME));
+		std::vector<float> expirationTimes;
+		for (int i = 0; i < timerCount; ++i)
+		{
+			//Half a tick short of a whole number of ticks, so rounding can't move the tick either expires on
+			expirationTimes.push_back((static_cast<float>(ticksDistribution(randomEngine)) - 0.5f) * DELTA_TIME);
+		}
+
+		return expirationTimes;
+	}
+
+	Result runPerUpdate(const std::vector<float>& expirationTimes, int checkInterval)
+	{
+		std::vector<TimerPerUpdate> timers(expirationTimes.cbegin(), expirationTimes.cend());
+		Result result;
+		result.nanoseconds = Harness::measure<std::nano>([&timers, &result, checkInterval]()
+		{
+			for (int tick = 0; tick < TICKS; ++tick)
+			{
+				for (size_t i = 0; i < timers.size(); ++i)
+				{
+					timers[i].update(DELTA_TIME);
+					if (static_cast<int>(i) % checkInterval == tick % checkInterval && timers[i].isExpired())
+					{
+						timers[i].resetElaspedTime();
+						++result.expired;
+					}
+				}
+			}
+		}) / (static_cast<double>(TICKS) * timers.size());
+		return result;
+	}
+
+	Result runSimulationClock(const std::vector<float>& expirationTimes, int checkInterval)
+	{
+		std::vector<Timer> timers;
+		timers.reserve(expirationTimes.size());
+		for (float expirationTime : expirationTimes)
+		{
+			timers.emplace_back(expirationTime, true);
+		}
+
+		Result result;
+		result.nanoseconds = Harness::measure<std::nano>([&timers, &result, checkInterval]()
+		{
+			for (int tick = 0; tick < TICKS; ++tick)
+			{
+				SimulationClock::advance(DELTA_TIME);
+				for (size_t i = static_cast<size_t>(tick % checkInterval); i < timers.size(); i += checkInterval)
+				{
+					if (timers[i].isExpired())
+					{
+						timers[i].resetElaspedTime();
+						++result.expired;
+					}
+				}
+			}
+		}) / (static_cast<double>(TICKS) * timers.size());
+		return result;
+	}
+}
+
+void Benchmarks::runTimers()
+{
+	std::cout << "Timers, " << TICKS << " ticks, expiring every " << MIN_EXPIRATION_TIME << " to " << MAX_EXPIRATION_TIME << " s\n";
+	for (int checkInterval : CHECK_INTERVALS)
+	{
+		for (int timerCount : TIMER_COUNTS)
+		{
+			const std::vector<float> expirationTimes = getExpirationTimes(timerCount);
+			const Result perUpdate = runPerUpdate(expirationTimes, checkInterval);
+			const Result simulationClock = runSimulationClock(expirationTimes, checkInterval);
+			std::cout << "  " << timerCount << " timers, checked every " << checkInterval << " ticks: per update "
+				<< perUpdate.nanoseconds << " ns/timer/tick, simulation clock " << simulationClock.nanoseconds << " ns/timer/tick, speedup "
+				<< (simulationClock.nanoseconds > 0.0 ? perUpdate.nanoseconds / simulationClock.nanoseconds : 0.0)
+				<< (perUpdate.expired == simulationClock.expired ? "" : " (expirations differ)") << "\n";
+		}
+	}
+}
@@ -0,0 +1,241 @@
+#include "Benchmarks/Benchmarks.h"
+#include "Benchmarks/Brawl.h"
+#include "Benchmarks/Harness.h"
+#include "Core/Graph.h"
+#include "Core/PathFinding.h"
+#include "Core/WorkerOccupancy.h"
+#include "Entities/Worker.h"
+#include "Model/AdjacentPositions.h"
+#include <algorithm>
+#include <iostream>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+//A full set of idle workers stacked on one node next to their headquarters, then another spread out around theirs -
+//the previous pass over every worker asking every worker handled before it whether they overlap, then searching for a
+//free node asking every worker whether it stands there, against the pass looking only at the workers on nearby nodes
+//and searching the occupancy. Destinations are found without sending the workers off, so every pass starts from the
+//same workers. Reports how many workers were pushed out and onto how many different nodes
+namespace
+{
+	constexpr int ROUNDS = 50;
+	constexpr float DELTA_TIME = 1.0f / 60.0f;
+	constexpr int SPREAD_OUT_SPACING = 4;
+
+	struct Result
+	{
+		double microseconds						= 0.0;
+		std::vector<glm::vec3> destinations		= {};
+	};
+
+	//Previous PathFinding::getClosestAvailablePosition
+	bool getClosestAvailablePositionPerWorker(const Worker& worker, const std::vector<const Worker*>& workers, const Map& map,
+		Graph& graph, glm::vec3& outPosition)
+	{
+		graph.reset(Globals::convertToGridPosition(worker.getPosition()));
+		bool availablePositionFound = false;
+		int workerID = worker.getID();
+		auto workerCollision = [workerID, &workers](glm::ivec2 position) -> bool
+		{
+			auto worker = std::find_if(workers.cbegin(), workers.cend(), [workerID, position](auto& worker)
+			{
+				return worker->getID() != workerID && !worker->getAABB().contains(Globals::convertToWorldPosition(position));
+			});
+			return worker != workers.cend();
+		};
+
+		while (!availablePositionFound && !graph.is_frontier_empty())
+		{
+			glm::ivec2 position = graph.pop_frontier();
+			for (const auto& adjacentPosition : getAdjacentPositions(position, map))
+			{
+				if (adjacentPosition.valid && workerCollision(adjacentPosition.position))
+				{
+					outPosition = Globals::convertToWorldPosition(adjacentPosition.position);
+					availablePositionFound = true;
+					break;
+				}
+				else if (!graph.is_position_visited(adjacentPosition.position, map))
+				{
+					graph.add(adjacentPosition.position, position, map);
+				}
+			}
+		}
+
+		return availablePositionFound;
+	}
+
+	//Previous Faction::handleWorkerCollisions
+	void handleWorkerCollisionsPerWorker(const std::vector<const Worker*>& workers, const Map& map, Graph& graph,
+		std::vector<glm::vec3>& destinations)
+	{
+		static std::vector<std::reference_wrapper<const Worker>> handledWorkers;
+
+		auto foundWorker = [](int ID) -> bool
+		{
+			auto worker = std::find_if(handledWorkers.cbegin(), handledWorkers.cend(), [ID](const auto& worker)
+			{
+				return worker.get().getID() == ID;
+			});
+			return worker != handledWorkers.cend();
+		};
+
+		for (const Worker* worker : workers)
+		{
+			if (worker->getCurrentState() == eWorkerState::Idle)
+			{
+				if (map.isCollidable(worker->getPosition()))
+				{
+					glm::vec3 destination(0.f);
+					if (getClosestAvailablePositionPerWorker(*worker, workers, map, graph, destination))
+					{
+						destinations.push_back(destination);
+					}
+				}
+				else
+				{
+					for (const Worker* otherWorker : workers)
+					{
+						if (worker->getID() != otherWorker->getID() &&
+							foundWorker(otherWorker->getID()) &&
+							otherWorker->getCurrentState() == eWorkerState::Idle &&
+							worker->getAABB().contains(otherWorker->getAABB()))
+						{
+							glm::vec3 destination(0.f);
+							if (getClosestAvailablePositionPerWorker(*worker, workers, map, graph, destination))
+							{
+								destinations.push_back(destination);
+								break;
+							}
+						}
+					}
+				}
+			}
+
+			handledWorkers.push_back(*worker);
+		}
+
+		handledWorkers.clear();
+	}
+
+	//Faction::handleWorkerCollisions
+	void handleWorkerCollisionsOccupancy(const std::vector<const Worker*>& workers, const Map& map, WorkerOccupancy& workerOccupancy,
+		std::vector<const Worker*>& overlappingWorkers, std::vector<glm::vec3>& destinations)
+	{
+		workerOccupancy.clear();
+		for (const Worker* worker : workers)
+		{
+			workerOccupancy.add(*worker);
+		}
+		workerOccupancy.sortByNode();
+
+		for (const Worker* worker : workers)
+		{
+			if (worker->getCurrentState() != eWorkerState::Idle)
+			{
+				continue;
+			}
+
+			bool overlapping = map.isCollidable(worker->getPosition());
+			if (!overlapping)
+			{
+				workerOccupancy.getWorkers(worker->getAABB(), overlappingWorkers);
+				overlapping = std::any_of(overlappingWorkers.cbegin(), overlappingWorkers.cend(), [worker](const Worker* otherWorker)
+				{
+					return otherWorker->getID() < worker->getID() &&
+						otherWorker->getCurrentState() == eWorkerState::Idle;
+				});
+			}
+
+			glm::vec3 destination(0.f);
+			if (overlapping && PathFinding::getInstance().getClosestAvailablePosition(*worker, workerOccupancy, map, destination))
+			{
+				workerOccupancy.addDestination(*worker, destination);
+				destinations.push_back(destination);
+			}
+		}
+	}
+
+	template <typename HandleWorkerCollisions>
+	Result runPasses(HandleWorkerCollisions handleWorkerCollisions)
+	{
+		Result result;
+		std::vector<glm::vec3> destinations;
+		result.microseconds = Harness::measure<std::micro>([&destinations, &handleWorkerCollisions]()
+		{
+			for (int round = 0; round < ROUNDS; ++round)
+			{
+				destinations.clear();
+				handleWorkerCollisions(destinations);
+			}
+		}) / ROUNDS;
+		result.destinations = std::move(destinations);
+		return result;
+	}
+
+	size_t getDistinctNodeCount(const std::vector<glm::vec3>& positions)
+	{
+		std::set<std::pair<int, int>> nodes;
+		for (const auto& position : positions)
+		{
+			const glm::ivec2 node = Globals::convertToGridPosition(position);
+			nodes.emplace(node.x, node.y);
+		}
+
+		return nodes.size();
+	}
+
+	void print(const char* name, const Result& result)
+	{
+		std::cout << "  " << name << result.microseconds << " us/pass, " << result.destinations.size() << " pushed out onto "
+			<< getDistinctNodeCount(result.destinations) << " nodes\n";
+	}
+}
+
+void Benchmarks::runWorkerCollisions()
+{
+	//Searches are sized on the level's map as it's created
+	if (!Harness::isReady())
+	{
+		return;
+	}
+
+	Graph graph;
+	std::optional<Level> level;
+	if (!Harness::startWithWorkerResources(level, DELTA_TIME))
+	{
+		return;
+	}
+	if (level->getFactions().size() < 2)
+	{
+		std::cout << "Unable to start " << Brawl::LEVEL_NAME << "\n";
+		return;
+	}
+
+	//One faction's workers stacked on a single node, the next one's spread out a node apart from one another
+	const Map& map = level->getMap();
+	for (size_t i = 0; i < 2; ++i)
+	{
+		Faction& faction = *level->getFactions()[i];
+		Harness::addWorkers(*level, faction, i == 0 ? 0 : SPREAD_OUT_SPACING);
+		const std::vector<const Worker*> workers = Harness::getWorkers(faction);
+		WorkerOccupancy workerOccupancy;
+		std::vector<const Worker*> overlappingWorkers;
+		const Result perWorker = runPasses([&workers, &map, &graph](std::vector<glm::vec3>& destinations)
+		{
+			handleWorkerCollisionsPerWorker(workers, map, graph, destinations);
+		});
+		const Result occupancy = runPasses([&workers, &map, &workerOccupancy, &overlappingWorkers](std::vector<glm::vec3>& destinations)
+		{
+			handleWorkerCollisionsOccupancy(workers, map, workerOccupancy, overlappingWorkers, destinations);
+		});
+
+		std::cout << "Worker collisions, " << workers.size() << " idle workers " << (i == 0 ? "stacked on one node" : "spread out")
+			<< ", " << ROUNDS << " passes (" << Brawl::LEVEL_NAME << ")\n";
+		print("per worker: ", perWorker);
+		print("occupancy:  ", occupancy);
+		std::cout << "  speedup " << (occupancy.microseconds > 0.0 ? perWorker.microseconds / occupancy.microseconds : 0.0) << "\n";
+	}
+}
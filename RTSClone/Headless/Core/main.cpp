@@ -0,0 +1,249 @@
+#include "Core/Level.h"
+#include "Core/LevelFileHandler.h"
+#include "Core/PathFinding.h"
+#include "Core/Globals.h"
+#include "Graphics/ModelManager.h"
+#include "Benchmarks/Benchmarks.h"
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+//Runs a level without a window, OpenGL context or ImGui - every faction is AI controlled.
+//Usage: Headless --level=Level2.txt --ticks=7200 --dt=0.0166667 --seed=1
+//       Headless --path-budget=8000 --path-budget-us=0 --path-threads=4 --trace-path-requests
+//       Headless --benchmark=minheap|pathfinding|hierarchical|groupmove|paththreads|occupancy|targeting|entitylookup|movement|
+//                            massdeath|eventqueue|messenger|fixedtick|delayedupdate|factionthreads|projectiles|lineofsight|
+//                            avoidance|timers|minerals|workercollisions
+namespace
+{
+	constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+	constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+	struct HeadlessSettings
+	{
+		std::string levelName		= "Level2.txt";
+		int ticks					= 7200;
+		float deltaTime				= 1.0f / 60.0f;
+		unsigned int seed			= 1;
+		int pathBudget				= 0;
+		int pathBudgetMicroseconds	= 0;
+		int pathThreads				= 0;
+		bool tracePathRequests		= false;
+		std::string benchmarkName;
+	};
+
+	struct PathRequestSummary
+	{
+		int processed			= 0;
+		int totalLatency		= 0;
+		int maxLatency			= 0;
+		int maxExpandedNodes	= 0;
+		size_t maxQueueSize		= 0;
+	};
+
+	bool parseArgument(std::string_view argument, std::string_view name, std::string& value)
+	{
+		if (argument.size() > name.size() + 1 && argument.substr(0, name.size()) == name && argument[name.size()] == '=')
+		{
+			value = std::string(argument.substr(name.size() + 1));
+			return true;
+		}
+
+		return false;
+	}
+
+	bool parseSettings(int argc, char* argv[], HeadlessSettings& settings)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string value;
+			if (parseArgument(argv[i], "--level", value))
+			{
+				settings.levelName = value;
+			}
+			else if (parseArgument(argv[i], "--ticks", value))
+			{
+				settings.ticks = std::stoi(value);
+			}
+			else if (parseArgument(argv[i], "--dt", value))
+			{
+				settings.deltaTime = std::stof(value);
+			}
+			else if (parseArgument(argv[i], "--seed", value))
+			{
+				settings.seed = static_cast<unsigned int>(std::stoul(value));
+			}
+			else if (parseArgument(argv[i], "--path-budget", value))
+			{
+				settings.pathBudget = std::stoi(value);
+			}
+			else if (parseArgument(argv[i], "--path-budget-us", value))
+			{
+				settings.pathBudgetMicroseconds = std::stoi(value);
+			}
+			else if (parseArgument(argv[i], "--path-threads", value))
+			{
+				settings.pathThreads = std::stoi(value);
+			}
+			else if (std::string_view(argv[i]) == "--trace-path-requests")
+			{
+				settings.tracePathRequests = true;
+			}
+			else if (parseArgument(argv[i], "--benchmark", value))
+			{
+				settings.benchmarkName = value;
+			}
+			else
+			{
+				std::cout << "Unknown argument " << argv[i] << "\n";
+				return false;
+			}
+		}
+
+		return settings.ticks > 0 && settings.deltaTime > 0.0f && settings.pathBudget >= 0 && settings.pathBudgetMicroseconds >= 0 &&
+			settings.pathThreads >= 0;
+	}
+
+	template <typename T>
+	void hash(uint64_t& currentHash, const T& value)
+	{
+		unsigned char bytes[sizeof(T)];
+		std::memcpy(bytes, &value, sizeof(T));
+		for (unsigned char byte : bytes)
+		{
+			currentHash ^= byte;
+			currentHash *= FNV_PRIME;
+		}
+	}
+
+	uint64_t getStateHash(const Level& level)
+	{
+		uint64_t stateHash = FNV_OFFSET_BASIS;
+		for (const auto& faction : level.getFactions())
+		{
+			hash(stateHash, faction->getController());
+			hash(stateHash, faction->getCurrentResourceAmount());
+			hash(stateHash, faction->getCurrentPopulationAmount());
+			hash(stateHash, faction->getMaximumPopulationAmount());
+			hash(stateHash, faction->getCurrentShieldAmount());
+			hash(stateHash, faction->getEntities().size());
+			for (const Entity* entity : faction->getEntities())
+			{
+				hash(stateHash, entity->getID());
+				hash(stateHash, entity->getEntityType());
+				hash(stateHash, entity->getHealth());
+				hash(stateHash, entity->getShield());
+				hash(stateHash, entity->getPosition());
+			}
+		}
+
+		return stateHash;
+	}
+
+	double getPercentile(std::vector<double> tickTimes, double percentile)
+	{
+		assert(!tickTimes.empty());
+		const size_t i = std::min(tickTimes.size() - 1, static_cast<size_t>(percentile * static_cast<double>(tickTimes.size())));
+		std::nth_element(tickTimes.begin(), tickTimes.begin() + i, tickTimes.end());
+
+		return tickTimes[i];
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	HeadlessSettings settings;
+	if (!parseSettings(argc, argv, settings))
+	{
+		return -1;
+	}
+
+	if (!settings.benchmarkName.empty())
+	{
+		Globals::setRandomSeed(settings.seed);
+		return Benchmarks::run(settings.benchmarkName) ? 0 : -1;
+	}
+
+	if (!ModelManager::getInstance().isAllModelsLoaded())
+	{
+		std::cout << "Failed to load all models\n";
+		return -1;
+	}
+
+	Globals::setRandomSeed(settings.seed);
+	PathFinding::getInstance();
+	if (settings.pathThreads > 0)
+	{
+		PathFinding::getInstance().setThreadCount(settings.pathThreads);
+	}
+
+	std::optional<LevelDetailsFromFile> levelDetails = Level::load(settings.levelName, Globals::WINDOW_SIZE);
+	if (!levelDetails)
+	{
+		std::cout << "Unable to load " << settings.levelName << "\n";
+		return -1;
+	}
+
+	std::optional<Level> level;
+	level.emplace(std::move(*levelDetails), Globals::WINDOW_SIZE, true);
+	if (settings.pathBudget > 0 || settings.pathBudgetMicroseconds > 0)
+	{
+		level->setPathRequestBudget(settings.pathBudget > 0 ? settings.pathBudget : std::numeric_limits<int>::max(),
+			settings.pathBudgetMicroseconds);
+	}
+
+	std::vector<double> tickTimes;
+	tickTimes.reserve(static_cast<size_t>(settings.ticks));
+	PathRequestSummary pathRequestSummary;
+	const Faction* winningFaction = nullptr;
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < settings.ticks && !winningFaction; ++i)
+	{
+		const auto tickStart = std::chrono::steady_clock::now();
+		level->update(settings.deltaTime);
+		const auto tickEnd = std::chrono::steady_clock::now();
+
+		tickTimes.push_back(std::chrono::duration<double, std::milli>(tickEnd - tickStart).count());
+		const PathRequestStats& pathRequestStats = level->getPathRequestStats();
+		pathRequestSummary.processed += pathRequestStats.processed;
+		pathRequestSummary.totalLatency += pathRequestStats.totalLatency;
+		pathRequestSummary.maxLatency = std::max(pathRequestSummary.maxLatency, pathRequestStats.maxLatency);
+		pathRequestSummary.maxExpandedNodes = std::max(pathRequestSummary.maxExpandedNodes, pathRequestStats.expandedNodes);
+		pathRequestSummary.maxQueueSize = std::max(pathRequestSummary.maxQueueSize, pathRequestStats.queueSize);
+		if (settings.tracePathRequests && (pathRequestStats.processed > 0 || pathRequestStats.queueSize > 0))
+		{
+			std::cout << "Tick " << i << ": path requests processed " << pathRequestStats.processed << ", queued " << pathRequestStats.queueSize
+				<< ", expanded nodes " << pathRequestStats.expandedNodes << ", max latency " << pathRequestStats.maxLatency
+				<< " ticks, tick time " << tickTimes.back() << " ms\n";
+		}
+		winningFaction = level->getWinningFaction();
+	}
+	const double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Level: " << settings.levelName << "\n";
+	std::cout << "Seed: " << settings.seed << "\n";
+	std::cout << "Path threads: " << PathFinding::getInstance().getThreadCount() << "\n";
+	std::cout << "Ticks: " << tickTimes.size() << " (dt " << settings.deltaTime << ")\n";
+	std::cout << "Ticks/sec: " << static_cast<double>(tickTimes.size()) / totalSeconds << "\n";
+	std::cout << "Tick time p50: " << getPercentile(tickTimes, 0.5) << " ms, p99: " << getPercentile(tickTimes, 0.99)
+		<< " ms, max: " << *std::max_element(tickTimes.cbegin(), tickTimes.cend()) << " ms\n";
+	std::cout << "Path requests: " << pathRequestSummary.processed << ", max queued: " << pathRequestSummary.maxQueueSize
+		<< ", latency mean: " << static_cast<double>(pathRequestSummary.totalLatency) / std::max(1, pathRequestSummary.processed)
+		<< " ticks, max: " << pathRequestSummary.maxLatency << " ticks, max expanded nodes per tick: " << pathRequestSummary.maxExpandedNodes << "\n";
+	if (winningFaction)
+	{
+		std::cout << "Winner: " << static_cast<int>(winningFaction->getController()) << "\n";
+	}
+	std::cout << "State hash: " << std::hex << getStateHash(*level) << std::dec << "\n";
+
+	level.reset();
+
+	return 0;
+}
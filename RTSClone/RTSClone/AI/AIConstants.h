@@ -15,6 +15,8 @@ namespace AIConstants
 	constexpr float MAX_DISTANCE_FROM_HQ = static_cast<float>(Globals::NODE_SIZE) * 18.0f;
 	constexpr float MIN_DISTANCE_FROM_HQ = static_cast<float>(Globals::NODE_SIZE) * 5.0f;
 	constexpr float DISTANCE_FROM_MINERALS = static_cast<float>(Globals::NODE_SIZE) * 7.0f;
+	constexpr float MIN_BUILDING_DISTANCE_FROM_BUILDINGS = static_cast<float>(Globals::NODE_SIZE) * 6.0f;
+	constexpr float MIN_BUILDING_DISTANCE_FROM_MINERALS = static_cast<float>(Globals::NODE_SIZE) * 8.0f;
 	constexpr float MIN_BASE_EXPANSION_TIME = 2.0f;
 	constexpr float MAX_BASE_EXPANSION_TIME = MIN_BASE_EXPANSION_TIME * 2.0f;
 	constexpr int MAX_LABORATORY = 1;
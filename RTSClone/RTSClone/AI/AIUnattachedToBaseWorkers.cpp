@@ -40,6 +40,8 @@ void AIUnattachedToBaseWorkers::remove(const Worker& _worker)
 	{
 		return _worker.getID() == worker.get().getID();
 	});
-	assert(iter != m_unattachedToBaseWorkers.end());
-	m_unattachedToBaseWorkers.erase(iter);
+	if (iter != m_unattachedToBaseWorkers.end())
+	{
+		m_unattachedToBaseWorkers.erase(iter);
+	}
 }
\ No newline at end of file
@@ -160,6 +160,29 @@ bool AABB::contains(const AABB& other) const
 		m_back < other.m_forward;
 }
 
+//Ignores height - segments are on the ground
+bool AABB::intersects(const glm::vec3& start, const glm::vec3& end) const
+{
+	float entry = 0.f;
+	float exit = 1.f;
+	auto clip = [&entry, &exit](float start, float direction, float minimum, float maximum)
+	{
+		if (direction == 0.f)
+		{
+			return start >= minimum && start <= maximum;
+		}
+
+		float t1 = (minimum - start) / direction;
+		float t2 = (maximum - start) / direction;
+		entry = glm::max(entry, glm::min(t1, t2));
+		exit = glm::min(exit, glm::max(t1, t2));
+		return entry <= exit;
+	};
+
+	return clip(start.x, end.x - start.x, m_left, m_right) && 
+		clip(start.z, end.z - start.z, m_back, m_forward);
+}
+
 #ifdef LEVEL_EDITOR
 void AABB::move(const glm::vec3& currentPosition, const glm::vec3& position)
 {
@@ -38,6 +38,7 @@ public:
 
 	bool contains(const glm::vec3& position) const;
 	bool contains(const AABB& other) const;
+	bool intersects(const glm::vec3& start, const glm::vec3& end) const;
 	
 #ifdef LEVEL_EDITOR
 	void move(const glm::vec3& currentPosition, const glm::vec3& position);
@@ -26,7 +26,7 @@ Base::Base(const glm::vec3& position, std::vector<Mineral>&& minerals)
 Base::Base(Base&& rhs) noexcept
 	: position(std::move(rhs.position)),
 	minerals(std::move(rhs.minerals)),
-	quad(std::move(quad)),
+	quad(std::move(rhs.quad)),
 	owningFactionController(rhs.owningFactionController)
 {
 	std::swap(owningFactionController, rhs.owningFactionController);
@@ -82,23 +82,24 @@ void Base::setPosition(const glm::vec3 & _position)
 #ifdef GAME
 namespace
 {
-	std::array<const Mineral*, Globals::MAX_MINERALS> getClosestMinerals(const std::vector<Mineral>& minerals, const glm::vec3& position)
+	//Nearest available mineral, the earlier one of two as near - the first available one were they sorted by distance
+	template <typename IsAvailable>
+	const Mineral* getNearestMineral(const std::vector<Mineral>& minerals, const glm::vec3& position, IsAvailable isAvailable)
 	{
 		assert(static_cast<int>(minerals.size()) == Globals::MAX_MINERALS);
-		std::array<const Mineral*, Globals::MAX_MINERALS> sortedMinerals;
-		for (int i = 0; i < static_cast<int>(minerals.size()); ++i)
+		const Mineral* nearestMineral = nullptr;
+		float nearestDistance = std::numeric_limits<float>::max();
+		for (const auto& mineral : minerals)
 		{
-			sortedMinerals[i] = &minerals[i];
+			const float distance = Globals::getSqrDistance(mineral.getPosition(), position);
+			if ((!nearestMineral || distance < nearestDistance) && isAvailable(mineral))
+			{
+				nearestMineral = &mineral;
+				nearestDistance = distance;
+			}
 		}
 
-		std::sort(sortedMinerals.begin(), sortedMinerals.end(), [&position](const auto& mineralA, const auto& mineralB)
-		{
-			assert(mineralA && mineralB);
-			return Globals::getSqrDistance(mineralA->getPosition(), position) <
-				Globals::getSqrDistance(mineralB->getPosition(), position);
-		});
-
-		return sortedMinerals;
+		return nearestMineral;
 	}
 }
 
@@ -130,17 +131,10 @@ const std::vector<Base>& BaseHandler::getBases() const
 const Mineral* BaseHandler::getNearestAvailableMineralAtBase(const Faction& faction, const Base& base,
 	const glm::vec3& position) const
 {
-	std::array<const Mineral*, Globals::MAX_MINERALS> minerals = getClosestMinerals(base.minerals, position);
-	for (const auto& mineral : minerals)
+	return getNearestMineral(base.minerals, position, [&faction](const Mineral& mineral)
 	{
-		assert(mineral);
-		if (!faction.isMineralInUse(*mineral))
-		{
-			return mineral;
-		}
-	}
-
-	return nullptr;
+		return !faction.isMineralInUse(mineral);
+	});
 }
 
 const Mineral* BaseHandler::getNearestAvailableMineralAtBase(const Faction& faction, const Mineral& _mineral,
@@ -149,16 +143,10 @@ const Mineral* BaseHandler::getNearestAvailableMineralAtBase(const Faction& fact
 	assert(faction.isMineralInUse(_mineral));
 	if (const Base* base = getBase(_mineral))
 	{
-		std::array<const Mineral*, Globals::MAX_MINERALS> minerals = getClosestMinerals(base->minerals, position);
-		for (const auto& mineral : minerals)
+		return getNearestMineral(base->minerals, position, [&faction, &_mineral](const Mineral& mineral)
 		{
-			assert(mineral);
-			if (&(*mineral) != &_mineral &&
-				!faction.isMineralInUse(*mineral))
-			{
-				return mineral;
-			}
-		}
+			return &mineral != &_mineral && !faction.isMineralInUse(mineral);
+		});
 	}
 
 	return nullptr;
@@ -0,0 +1,474 @@
+#include "Core/ClusterGraph.h"
+#include "Core/Globals.h"
+#include "Core/Map.h"
+#include "Core/AABB.h"
+#include "Events/GameMessages.h"
+#include "Model/AdjacentPositions.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace
+{
+	constexpr int CLUSTER_SIZE = 10;
+	constexpr int MIN_ENTRANCE_SIZE_FOR_TWO_PORTALS = 6;
+	constexpr float INTER_CLUSTER_COST = 1.f;
+	constexpr float UNREACHABLE_COST = std::numeric_limits<float>::max();
+
+	using OpenListNode = std::pair<float, int>;
+	using OpenList = std::priority_queue<OpenListNode, std::vector<OpenListNode>, std::greater<OpenListNode>>;
+
+	int getLocalIndex(glm::ivec2 position, glm::ivec2 clusterMin)
+	{
+		return (position.x - clusterMin.x) * CLUSTER_SIZE + (position.y - clusterMin.y);
+	}
+
+	bool isWithinCluster(glm::ivec2 position, glm::ivec2 clusterMin, glm::ivec2 clusterMax)
+	{
+		return position.x >= clusterMin.x && position.x <= clusterMax.x &&
+			position.y >= clusterMin.y && position.y <= clusterMax.y;
+	}
+}
+
+ClusterGraph::ClusterGraph()
+	: m_mapSize(0, 0),
+	m_clusterCount(0, 0),
+	m_clusters(),
+	m_nodes(),
+	m_freeNodeIDs(),
+	m_dirty(false),
+	m_clusterCosts(static_cast<size_t>(CLUSTER_SIZE * CLUSTER_SIZE), UNREACHABLE_COST),
+	m_onNewMapSizeID([this](const GameMessages::MapSize& gameMessage) { return onNewMapSize(gameMessage); }),
+	m_onAddAABBID([this](const GameMessages::AddAABBToMap& gameMessage) { return markDirty(gameMessage.aabb); }),
+	m_onRemoveAABBID([this](const GameMessages::RemoveAABBFromMap& gameMessage) { return markDirty(gameMessage.aabb); })
+{}
+
+int ClusterGraph::getNodeCount() const
+{
+	return static_cast<int>(m_nodes.size() - m_freeNodeIDs.size());
+}
+
+bool ClusterGraph::getPath(glm::ivec2 startingPosition, glm::ivec2 destination, const Map& map, ClusterGraphSearch& search, 
+	std::vector<glm::ivec2>& path) const
+{
+	path.clear();
+	if (m_mapSize != map.getSize() || !map.isWithinBounds(startingPosition) || !map.isWithinBounds(destination) ||
+		map.isPositionOccupied(startingPosition) || map.isPositionOccupied(destination))
+	{
+		return false;
+	}
+
+	assert(!m_dirty);
+	const int startingNodeID = static_cast<int>(m_nodes.size());
+	const int destinationNodeID = startingNodeID + 1;
+	const size_t searchSize = m_nodes.size() + 2;
+	if (search.searchIDs.size() < searchSize)
+	{
+		search.g.resize(searchSize);
+		search.cameFrom.resize(searchSize);
+		search.searchIDs.resize(searchSize, 0);
+	}
+
+	++search.searchID;
+	if (search.searchID == 0)
+	{
+		std::fill(search.searchIDs.begin(), search.searchIDs.end(), 0);
+		search.searchID = 1;
+	}
+
+	setEdgesToPosition(startingPosition, map, search.clusterCosts, search.startingEdges);
+	const int destinationClusterID = getClusterID(destination);
+	if (getClusterID(startingPosition) == destinationClusterID)
+	{
+		const float cost = search.clusterCosts[getLocalIndex(destination, getClusterMin(destinationClusterID))];
+		if (cost != UNREACHABLE_COST)
+		{
+			search.startingEdges.push_back({ destinationNodeID, cost });
+		}
+	}
+	setEdgesToPosition(destination, map, search.clusterCosts, search.destinationEdges);
+
+	auto getPosition = [&](int nodeID) -> glm::ivec2
+	{
+		if (nodeID == startingNodeID)
+		{
+			return startingPosition;
+		}
+		else if (nodeID == destinationNodeID)
+		{
+			return destination;
+		}
+
+		return m_nodes[nodeID].position;
+	};
+
+	OpenList openList;
+	search.g[startingNodeID] = 0.f;
+	search.cameFrom[startingNodeID] = startingNodeID;
+	search.searchIDs[startingNodeID] = search.searchID;
+	openList.emplace(Globals::getDistance(destination, startingPosition), startingNodeID);
+
+	auto addToOpenList = [&](int currentNodeID, int nodeID, float cost)
+	{
+		const float g = search.g[currentNodeID] + cost;
+		if (search.searchIDs[nodeID] != search.searchID || g < search.g[nodeID])
+		{
+			search.g[nodeID] = g;
+			search.cameFrom[nodeID] = currentNodeID;
+			search.searchIDs[nodeID] = search.searchID;
+			openList.emplace(g + Globals::getDistance(destination, getPosition(nodeID)), nodeID);
+		}
+	};
+
+	bool destinationReached = false;
+	while (!destinationReached && !openList.empty())
+	{
+		const OpenListNode current = openList.top();
+		openList.pop();
+		const int currentNodeID = current.second;
+		if (current.first > search.g[currentNodeID] + Globals::getDistance(destination, getPosition(currentNodeID)))
+		{
+			continue;
+		}
+
+		if (currentNodeID == destinationNodeID)
+		{
+			destinationReached = true;
+		}
+		else if (currentNodeID == startingNodeID)
+		{
+			for (const auto& edge : search.startingEdges)
+			{
+				addToOpenList(currentNodeID, edge.nodeID, edge.cost);
+			}
+		}
+		else
+		{
+			for (const auto& edge : m_nodes[currentNodeID].edges)
+			{
+				addToOpenList(currentNodeID, edge.nodeID, edge.cost);
+			}
+
+			if (m_nodes[currentNodeID].clusterID == destinationClusterID)
+			{
+				auto edge = std::find_if(search.destinationEdges.cbegin(), search.destinationEdges.cend(), [currentNodeID](const auto& edge)
+				{
+					return edge.nodeID == currentNodeID;
+				});
+				if (edge != search.destinationEdges.cend())
+				{
+					addToOpenList(currentNodeID, destinationNodeID, edge->cost);
+				}
+			}
+		}
+	}
+
+	if (destinationReached)
+	{
+		for (int nodeID = destinationNodeID; nodeID != startingNodeID; nodeID = search.cameFrom[nodeID])
+		{
+			path.push_back(getPosition(nodeID));
+		}
+		std::reverse(path.begin(), path.end());
+	}
+
+	return destinationReached;
+}
+
+int ClusterGraph::getClusterID(glm::ivec2 position) const
+{
+	return (position.x / CLUSTER_SIZE) * m_clusterCount.y + position.y / CLUSTER_SIZE;
+}
+
+glm::ivec2 ClusterGraph::getClusterMin(int clusterID) const
+{
+	return { (clusterID / m_clusterCount.y) * CLUSTER_SIZE, (clusterID % m_clusterCount.y) * CLUSTER_SIZE };
+}
+
+glm::ivec2 ClusterGraph::getClusterMax(int clusterID) const
+{
+	return glm::min(getClusterMin(clusterID) + glm::ivec2(CLUSTER_SIZE - 1), m_mapSize - glm::ivec2(1));
+}
+
+int ClusterGraph::getOrAddNode(int clusterID, glm::ivec2 position)
+{
+	std::vector<int>& nodeIDs = m_clusters[clusterID].nodeIDs;
+	auto nodeID = std::find_if(nodeIDs.cbegin(), nodeIDs.cend(), [this, position](int nodeID)
+	{
+		return m_nodes[nodeID].position == position;
+	});
+	if (nodeID != nodeIDs.cend())
+	{
+		return *nodeID;
+	}
+
+	int newNodeID = static_cast<int>(m_nodes.size());
+	if (!m_freeNodeIDs.empty())
+	{
+		newNodeID = m_freeNodeIDs.back();
+		m_freeNodeIDs.pop_back();
+	}
+	else
+	{
+		m_nodes.emplace_back();
+	}
+
+	m_nodes[newNodeID].position = position;
+	m_nodes[newNodeID].clusterID = clusterID;
+	assert(m_nodes[newNodeID].edges.empty());
+	nodeIDs.push_back(newNodeID);
+
+	return newNodeID;
+}
+
+void ClusterGraph::removeEdgesToCluster(int clusterID, int targetClusterID)
+{
+	for (int nodeID : m_clusters[clusterID].nodeIDs)
+	{
+		std::vector<ClusterGraphEdge>& edges = m_nodes[nodeID].edges;
+		edges.erase(std::remove_if(edges.begin(), edges.end(), [this, targetClusterID](const auto& edge)
+		{
+			return m_nodes[edge.nodeID].clusterID == targetClusterID;
+		}), edges.end());
+	}
+}
+
+void ClusterGraph::removeUnusedNodes(int clusterID)
+{
+	std::vector<int>& nodeIDs = m_clusters[clusterID].nodeIDs;
+	nodeIDs.erase(std::remove_if(nodeIDs.begin(), nodeIDs.end(), [this, clusterID](int nodeID)
+	{
+		ClusterGraphNode& node = m_nodes[nodeID];
+		auto interClusterEdge = std::find_if(node.edges.cbegin(), node.edges.cend(), [this, clusterID](const auto& edge)
+		{
+			return m_nodes[edge.nodeID].clusterID != clusterID;
+		});
+		if (interClusterEdge != node.edges.cend())
+		{
+			return false;
+		}
+
+		node.edges.clear();
+		node.clusterID = -1;
+		m_freeNodeIDs.push_back(nodeID);
+		return true;
+	}), nodeIDs.end());
+}
+
+void ClusterGraph::addPortal(int clusterID, glm::ivec2 position, int adjacentClusterID, glm::ivec2 adjacentPosition)
+{
+	const int nodeID = getOrAddNode(clusterID, position);
+	const int adjacentNodeID = getOrAddNode(adjacentClusterID, adjacentPosition);
+	m_nodes[nodeID].edges.push_back({ adjacentNodeID, INTER_CLUSTER_COST });
+	m_nodes[adjacentNodeID].edges.push_back({ nodeID, INTER_CLUSTER_COST });
+}
+
+void ClusterGraph::addPortals(int clusterID, int adjacentClusterID, const Map& map)
+{
+	const glm::ivec2 clusterMin = getClusterMin(clusterID);
+	const glm::ivec2 clusterMax = getClusterMax(clusterID);
+	const glm::ivec2 direction = glm::sign(getClusterMin(adjacentClusterID) - clusterMin);
+	assert(std::abs(direction.x) + std::abs(direction.y) == 1);
+
+	//Walk along the shared border - each run of nodes free on both sides is an entrance
+	glm::ivec2 borderStart = { direction.x > 0 ? clusterMax.x : clusterMin.x, direction.y > 0 ? clusterMax.y : clusterMin.y };
+	const glm::ivec2 step = { direction.x == 0 ? 1 : 0, direction.y == 0 ? 1 : 0 };
+	const int borderLength = direction.x == 0 ? clusterMax.x - clusterMin.x + 1 : clusterMax.y - clusterMin.y + 1;
+	int entranceStart = -1;
+	for (int i = 0; i <= borderLength; ++i)
+	{
+		const glm::ivec2 position = borderStart + step * i;
+		const bool free = i < borderLength && !map.isPositionOccupied(position) && !map.isPositionOccupied(position + direction);
+		if (free && entranceStart == -1)
+		{
+			entranceStart = i;
+		}
+		else if (!free && entranceStart != -1)
+		{
+			const int entranceEnd = i - 1;
+			if (entranceEnd - entranceStart + 1 < MIN_ENTRANCE_SIZE_FOR_TWO_PORTALS)
+			{
+				const glm::ivec2 portalPosition = borderStart + step * ((entranceStart + entranceEnd) / 2);
+				addPortal(clusterID, portalPosition, adjacentClusterID, portalPosition + direction);
+			}
+			else
+			{
+				addPortal(clusterID, borderStart + step * entranceStart, adjacentClusterID, borderStart + step * entranceStart + direction);
+				addPortal(clusterID, borderStart + step * entranceEnd, adjacentClusterID, borderStart + step * entranceEnd + direction);
+			}
+
+			entranceStart = -1;
+		}
+	}
+}
+
+void ClusterGraph::setClusterCosts(int clusterID, glm::ivec2 position, const Map& map, std::vector<float>& clusterCosts) const
+{
+	const glm::ivec2 clusterMin = getClusterMin(clusterID);
+	const glm::ivec2 clusterMax = getClusterMax(clusterID);
+	clusterCosts.assign(static_cast<size_t>(CLUSTER_SIZE * CLUSTER_SIZE), UNREACHABLE_COST);
+
+	OpenList openList;
+	clusterCosts[getLocalIndex(position, clusterMin)] = 0.f;
+	openList.emplace(0.f, getLocalIndex(position, clusterMin));
+	while (!openList.empty())
+	{
+		const OpenListNode current = openList.top();
+		openList.pop();
+		if (current.first > clusterCosts[current.second])
+		{
+			continue;
+		}
+
+		const glm::ivec2 currentPosition = clusterMin + glm::ivec2(current.second / CLUSTER_SIZE, current.second % CLUSTER_SIZE);
+		for (const auto& direction : ALL_DIRECTIONS_ON_GRID)
+		{
+			const glm::ivec2 adjacentPosition = currentPosition + direction;
+			if (isWithinCluster(adjacentPosition, clusterMin, clusterMax) && !map.isPositionOccupied(adjacentPosition))
+			{
+				const float cost = current.first + Globals::getDistance(adjacentPosition, currentPosition);
+				float& adjacentCost = clusterCosts[getLocalIndex(adjacentPosition, clusterMin)];
+				if (cost < adjacentCost)
+				{
+					adjacentCost = cost;
+					openList.emplace(cost, getLocalIndex(adjacentPosition, clusterMin));
+				}
+			}
+		}
+	}
+}
+
+void ClusterGraph::setIntraClusterEdges(int clusterID, const Map& map)
+{
+	const glm::ivec2 clusterMin = getClusterMin(clusterID);
+	const std::vector<int>& nodeIDs = m_clusters[clusterID].nodeIDs;
+	for (int nodeID : nodeIDs)
+	{
+		setClusterCosts(clusterID, m_nodes[nodeID].position, map, m_clusterCosts);
+		for (int adjacentNodeID : nodeIDs)
+		{
+			const float cost = m_clusterCosts[getLocalIndex(m_nodes[adjacentNodeID].position, clusterMin)];
+			if (adjacentNodeID != nodeID && cost != UNREACHABLE_COST)
+			{
+				m_nodes[nodeID].edges.push_back({ adjacentNodeID, cost });
+			}
+		}
+	}
+}
+
+void ClusterGraph::setEdgesToPosition(glm::ivec2 position, const Map& map, std::vector<float>& clusterCosts, 
+	std::vector<ClusterGraphEdge>& edges) const
+{
+	edges.clear();
+	const int clusterID = getClusterID(position);
+	const glm::ivec2 clusterMin = getClusterMin(clusterID);
+	setClusterCosts(clusterID, position, map, clusterCosts);
+	for (int nodeID : m_clusters[clusterID].nodeIDs)
+	{
+		const float cost = clusterCosts[getLocalIndex(m_nodes[nodeID].position, clusterMin)];
+		if (cost != UNREACHABLE_COST)
+		{
+			edges.push_back({ nodeID, cost });
+		}
+	}
+}
+
+void ClusterGraph::update(const Map& map)
+{
+	if (!m_dirty || m_mapSize != map.getSize())
+	{
+		return;
+	}
+
+	std::vector<int> dirtyClusterIDs;
+	for (int clusterID = 0; clusterID < static_cast<int>(m_clusters.size()); ++clusterID)
+	{
+		if (m_clusters[clusterID].dirty)
+		{
+			dirtyClusterIDs.push_back(clusterID);
+		}
+	}
+
+	//Rebuild every border of a dirty cluster once, then the intra cluster edges of every cluster touching those borders
+	std::vector<std::pair<int, int>> borders;
+	std::vector<bool> affectedClusters(m_clusters.size(), false);
+	for (int clusterID : dirtyClusterIDs)
+	{
+		const glm::ivec2 cluster = getClusterMin(clusterID) / CLUSTER_SIZE;
+		affectedClusters[clusterID] = true;
+		for (const auto& direction : { glm::ivec2(1, 0), glm::ivec2(-1, 0), glm::ivec2(0, 1), glm::ivec2(0, -1) })
+		{
+			const glm::ivec2 adjacentCluster = cluster + direction;
+			if (adjacentCluster.x < 0 || adjacentCluster.x >= m_clusterCount.x ||
+				adjacentCluster.y < 0 || adjacentCluster.y >= m_clusterCount.y)
+			{
+				continue;
+			}
+
+			const int adjacentClusterID = adjacentCluster.x * m_clusterCount.y + adjacentCluster.y;
+			affectedClusters[adjacentClusterID] = true;
+			if (!m_clusters[adjacentClusterID].dirty || clusterID < adjacentClusterID)
+			{
+				borders.emplace_back(clusterID, adjacentClusterID);
+			}
+		}
+	}
+
+	for (const auto& border : borders)
+	{
+		removeEdgesToCluster(border.first, border.second);
+		removeEdgesToCluster(border.second, border.first);
+	}
+	for (const auto& border : borders)
+	{
+		addPortals(border.first, border.second, map);
+	}
+	for (int clusterID = 0; clusterID < static_cast<int>(m_clusters.size()); ++clusterID)
+	{
+		if (affectedClusters[clusterID])
+		{
+			removeEdgesToCluster(clusterID, clusterID);
+			removeUnusedNodes(clusterID);
+			setIntraClusterEdges(clusterID, map);
+			m_clusters[clusterID].dirty = false;
+		}
+	}
+
+	m_dirty = false;
+}
+
+void ClusterGraph::markDirty(const AABB& AABB)
+{
+	if (m_clusters.empty())
+	{
+		return;
+	}
+
+	const glm::ivec2 minimum = glm::clamp(Globals::convertToGridPosition({ AABB.getLeft(), Globals::GROUND_HEIGHT, AABB.getBack() }),
+		glm::ivec2(0), m_mapSize - glm::ivec2(1));
+	const glm::ivec2 maximum = glm::clamp(Globals::convertToGridPosition({ AABB.getRight() - 1.f, Globals::GROUND_HEIGHT, AABB.getForward() - 1.f }),
+		glm::ivec2(0), m_mapSize - glm::ivec2(1));
+	for (int x = minimum.x / CLUSTER_SIZE; x <= maximum.x / CLUSTER_SIZE; ++x)
+	{
+		for (int y = minimum.y / CLUSTER_SIZE; y <= maximum.y / CLUSTER_SIZE; ++y)
+		{
+			m_clusters[x * m_clusterCount.y + y].dirty = true;
+		}
+	}
+
+	m_dirty = true;
+}
+
+void ClusterGraph::onNewMapSize(const GameMessages::MapSize& gameMessage)
+{
+	m_mapSize = gameMessage.mapSize;
+	m_clusterCount = (m_mapSize + glm::ivec2(CLUSTER_SIZE - 1)) / CLUSTER_SIZE;
+	m_clusters.clear();
+	m_clusters.resize(static_cast<size_t>(m_clusterCount.x) * static_cast<size_t>(m_clusterCount.y));
+	m_nodes.clear();
+	m_freeNodeIDs.clear();
+	m_dirty = true;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include "Events/GameMessenger.h"
+#include <vector>
+
+//Hierarchical (HPA*) abstraction of the static map - the map is split into clusters connected through portals on their borders.
+//Clusters touched by AddAABBToMap/RemoveAABBFromMap are marked dirty and rebuilt on the next query.
+struct ClusterGraphEdge
+{
+	int nodeID{ 0 };
+	float cost{ 0.f };
+};
+
+struct ClusterGraphNode
+{
+	glm::ivec2 position{ 0, 0 };
+	int clusterID{ -1 };
+	std::vector<ClusterGraphEdge> edges;
+};
+
+struct Cluster
+{
+	std::vector<int> nodeIDs;
+	bool dirty{ true };
+};
+
+//Scratch state for one search at a time - searches with different scratch can run in parallel
+struct ClusterGraphSearch
+{
+	std::vector<float> g;
+	std::vector<int> cameFrom;
+	std::vector<unsigned int> searchIDs;
+	unsigned int searchID{ 0 };
+	std::vector<float> clusterCosts;
+	std::vector<ClusterGraphEdge> startingEdges;
+	std::vector<ClusterGraphEdge> destinationEdges;
+};
+
+namespace GameMessages
+{
+	struct MapSize;
+	struct AddAABBToMap;
+	struct RemoveAABBFromMap;
+}
+class AABB;
+class Map;
+class ClusterGraph
+{
+public:
+	ClusterGraph();
+	ClusterGraph(const ClusterGraph&) = delete;
+	ClusterGraph& operator=(const ClusterGraph&) = delete;
+	ClusterGraph(ClusterGraph&&) = delete;
+	ClusterGraph& operator=(ClusterGraph&&) = delete;
+
+	int getNodeCount() const;
+
+	void update(const Map& map);
+
+	//Waypoints from startingPosition (excluded) to destination (included) - both have to be free on the static map.
+	//The graph has to be updated beforehand
+	bool getPath(glm::ivec2 startingPosition, glm::ivec2 destination, const Map& map, ClusterGraphSearch& search,
+		std::vector<glm::ivec2>& path) const;
+
+private:
+	glm::ivec2 m_mapSize;
+	glm::ivec2 m_clusterCount;
+	std::vector<Cluster> m_clusters;
+	std::vector<ClusterGraphNode> m_nodes;
+	std::vector<int> m_freeNodeIDs;
+	bool m_dirty;
+	std::vector<float> m_clusterCosts;
+	BroadcasterSub<GameMessages::MapSize> m_onNewMapSizeID;
+	BroadcasterSub<GameMessages::AddAABBToMap> m_onAddAABBID;
+	BroadcasterSub<GameMessages::RemoveAABBFromMap> m_onRemoveAABBID;
+
+	int getClusterID(glm::ivec2 position) const;
+	glm::ivec2 getClusterMin(int clusterID) const;
+	glm::ivec2 getClusterMax(int clusterID) const;
+	int getOrAddNode(int clusterID, glm::ivec2 position);
+	void removeEdgesToCluster(int clusterID, int targetClusterID);
+	void removeUnusedNodes(int clusterID);
+	void addPortal(int clusterID, glm::ivec2 position, int adjacentClusterID, glm::ivec2 adjacentPosition);
+	void addPortals(int clusterID, int adjacentClusterID, const Map& map);
+	void setClusterCosts(int clusterID, glm::ivec2 position, const Map& map, std::vector<float>& clusterCosts) const;
+	void setIntraClusterEdges(int clusterID, const Map& map);
+	void setEdgesToPosition(glm::ivec2 position, const Map& map, std::vector<float>& clusterCosts, 
+		std::vector<ClusterGraphEdge>& edges) const;
+	void markDirty(const AABB& AABB);
+	void onNewMapSize(const GameMessages::MapSize& gameMessage);
+};
@@ -0,0 +1,82 @@
+#include "Core/EntityList.h"
+#include "Entities/Entity.h"
+#include <assert.h>
+
+EntityList::EntityList()
+	: m_nodes(),
+	m_freeNodes(),
+	m_entityNodes(),
+	m_first(INVALID_NODE),
+	m_last(INVALID_NODE)
+{}
+
+bool EntityList::empty() const
+{
+	return m_entityNodes.empty();
+}
+
+size_t EntityList::size() const
+{
+	return m_entityNodes.size();
+}
+
+void EntityList::reserve(size_t capacity)
+{
+	m_nodes.reserve(capacity);
+	m_freeNodes.reserve(capacity);
+	m_entityNodes.reserve(capacity);
+}
+
+void EntityList::push_back(Entity& entity)
+{
+	assert(m_entityNodes.find(entity.getID()) == m_entityNodes.cend());
+	int node = INVALID_NODE;
+	if (!m_freeNodes.empty())
+	{
+		node = m_freeNodes.back();
+		m_freeNodes.pop_back();
+	}
+	else
+	{
+		node = static_cast<int>(m_nodes.size());
+		m_nodes.emplace_back();
+	}
+
+	m_nodes[node] = { &entity, m_last, INVALID_NODE };
+	if (m_last != INVALID_NODE)
+	{
+		m_nodes[m_last].next = node;
+	}
+	else
+	{
+		m_first = node;
+	}
+	m_last = node;
+	m_entityNodes.emplace(entity.getID(), node);
+}
+
+void EntityList::remove(const Entity& entity)
+{
+	const auto entityNode = m_entityNodes.find(entity.getID());
+	assert(entityNode != m_entityNodes.end() && m_nodes[entityNode->second].entity == &entity);
+	const Node& node = m_nodes[entityNode->second];
+	if (node.previous != INVALID_NODE)
+	{
+		m_nodes[node.previous].next = node.next;
+	}
+	else
+	{
+		m_first = node.next;
+	}
+	if (node.next != INVALID_NODE)
+	{
+		m_nodes[node.next].previous = node.previous;
+	}
+	else
+	{
+		m_last = node.previous;
+	}
+
+	m_freeNodes.push_back(entityNode->second);
+	m_entityNodes.erase(entityNode);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+//Every entity a faction owns in the order they were created, linked through stable nodes so adding and
+//removing are O(1) and the order the rest are walked in never changes.
+class Entity;
+class EntityList
+{
+	static constexpr int INVALID_NODE = -1;
+
+	struct Node
+	{
+		Entity* entity	= nullptr;
+		int previous	= INVALID_NODE;
+		int next		= INVALID_NODE;
+	};
+
+public:
+	template <typename Element, typename NodeArray>
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Entity*;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Element*;
+		using reference = Element&;
+
+		Iterator(NodeArray* nodes, int node)
+			: m_nodes(nodes),
+			m_node(node)
+		{}
+
+		reference operator*() const { return m_nodes[m_node].entity; }
+		pointer operator->() const { return &m_nodes[m_node].entity; }
+		Iterator& operator++() { m_node = m_nodes[m_node].next; return *this; }
+		Iterator operator++(int) { Iterator iterator = *this; ++*this; return iterator; }
+		bool operator==(const Iterator& rhs) const { return m_node == rhs.m_node; }
+		bool operator!=(const Iterator& rhs) const { return m_node != rhs.m_node; }
+
+	private:
+		NodeArray* m_nodes;
+		int m_node;
+	};
+
+	using iterator = Iterator<Entity*, Node>;
+	using const_iterator = Iterator<Entity* const, const Node>;
+
+	EntityList();
+
+	bool empty() const;
+	size_t size() const;
+
+	iterator begin() { return { m_nodes.data(), m_first }; }
+	iterator end() { return { m_nodes.data(), INVALID_NODE }; }
+	const_iterator begin() const { return cbegin(); }
+	const_iterator end() const { return cend(); }
+	const_iterator cbegin() const { return { m_nodes.data(), m_first }; }
+	const_iterator cend() const { return { m_nodes.data(), INVALID_NODE }; }
+
+	void reserve(size_t capacity);
+	void push_back(Entity& entity);
+	void remove(const Entity& entity);
+
+private:
+	std::vector<Node> m_nodes;
+	std::vector<int> m_freeNodes;
+	std::unordered_map<int, int> m_entityNodes;
+	int m_first;
+	int m_last;
+};
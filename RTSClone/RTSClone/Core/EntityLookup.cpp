@@ -0,0 +1,31 @@
+#include "Core/EntityLookup.h"
+#include "Entities/Entity.h"
+#include <assert.h>
+
+EntityLookup::EntityLookup()
+	: m_entities()
+{}
+
+const Entity* EntityLookup::get(int entityID) const
+{
+	const auto entity = m_entities.find(entityID);
+	return entity != m_entities.cend() ? entity->second : nullptr;
+}
+
+Entity* EntityLookup::get(int entityID)
+{
+	const auto entity = m_entities.find(entityID);
+	return entity != m_entities.end() ? entity->second : nullptr;
+}
+
+void EntityLookup::set(Entity& entity)
+{
+	m_entities[entity.getID()] = &entity;
+}
+
+void EntityLookup::remove(int entityID)
+{
+	const auto entity = m_entities.find(entityID);
+	assert(entity != m_entities.end());
+	m_entities.erase(entity);
+}
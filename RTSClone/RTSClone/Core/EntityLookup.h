@@ -0,0 +1,20 @@
+#pragma once
+
+#include <unordered_map>
+
+//Entity by ID in constant time, in place of searching a faction's entities.
+class Entity;
+class EntityLookup
+{
+public:
+	EntityLookup();
+
+	const Entity* get(int entityID) const;
+	Entity* get(int entityID);
+
+	void set(Entity& entity);
+	void remove(int entityID);
+
+private:
+	std::unordered_map<int, Entity*> m_entities;
+};
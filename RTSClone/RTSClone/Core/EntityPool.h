@@ -0,0 +1,193 @@
+#pragma once
+
+#include <assert.h>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//Fixed capacity storage whose elements never move - adding and removing are O(1) and leave the address
+//of every other element valid, so pointers and references to entities only go stale when they die.
+//Removed slots are reused. Iteration is in the order elements were added, linked through their slots.
+template <typename T>
+class EntityPool
+{
+	static constexpr int INVALID_SLOT = -1;
+
+	struct Slot
+	{
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+		int previous	= INVALID_SLOT;
+		int next		= INVALID_SLOT;
+	};
+
+public:
+	template <typename Element, typename SlotArray>
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Element*;
+		using reference = Element&;
+
+		Iterator(SlotArray* slots, int slot)
+			: m_slots(slots),
+			m_slot(slot)
+		{}
+
+		reference operator*() const { return *std::launder(reinterpret_cast<pointer>(&m_slots[m_slot].storage)); }
+		pointer operator->() const { return &**this; }
+		Iterator& operator++() { m_slot = m_slots[m_slot].next; return *this; }
+		Iterator operator++(int) { Iterator iterator = *this; ++*this; return iterator; }
+		bool operator==(const Iterator& rhs) const { return m_slot == rhs.m_slot; }
+		bool operator!=(const Iterator& rhs) const { return m_slot != rhs.m_slot; }
+
+	private:
+		SlotArray* m_slots;
+		int m_slot;
+	};
+
+	using iterator = Iterator<T, Slot>;
+	using const_iterator = Iterator<const T, const Slot>;
+
+	explicit EntityPool(int capacity);
+	EntityPool(const EntityPool&) = delete;
+	EntityPool& operator=(const EntityPool&) = delete;
+	EntityPool(EntityPool&&) = delete;
+	EntityPool& operator=(EntityPool&&) = delete;
+	~EntityPool();
+
+	bool empty() const { return m_size == 0; }
+	int size() const { return m_size; }
+	int capacity() const { return m_capacity; }
+	T& front() { assert(!empty()); return *begin(); }
+	const T& front() const { assert(!empty()); return *cbegin(); }
+	bool contains(const T& element) const;
+
+	iterator begin() { return { m_slots.get(), m_first }; }
+	iterator end() { return { m_slots.get(), INVALID_SLOT }; }
+	const_iterator begin() const { return cbegin(); }
+	const_iterator end() const { return cend(); }
+	const_iterator cbegin() const { return { m_slots.get(), m_first }; }
+	const_iterator cend() const { return { m_slots.get(), INVALID_SLOT }; }
+
+	template <typename ...ConstructParams>
+	T& emplace_back(ConstructParams&&... constructParams);
+	void erase(const T& element);
+
+private:
+	std::unique_ptr<Slot[]> m_slots;
+	std::vector<int> m_freeSlots;
+	int m_capacity;
+	int m_size;
+	int m_first;
+	int m_last;
+
+	int getSlot(const T& element) const;
+	T& get(int slot);
+};
+
+template <typename T>
+EntityPool<T>::EntityPool(int capacity)
+	: m_slots(std::make_unique<Slot[]>(capacity)),
+	m_freeSlots(),
+	m_capacity(capacity),
+	m_size(0),
+	m_first(INVALID_SLOT),
+	m_last(INVALID_SLOT)
+{
+	m_freeSlots.reserve(capacity);
+	for (int slot = capacity - 1; slot >= 0; --slot)
+	{
+		m_freeSlots.push_back(slot);
+	}
+}
+
+template <typename T>
+EntityPool<T>::~EntityPool()
+{
+	for (int slot = m_first; slot != INVALID_SLOT;)
+	{
+		const int next = m_slots[slot].next;
+		get(slot).~T();
+		slot = next;
+	}
+}
+
+template <typename T>
+bool EntityPool<T>::contains(const T& element) const
+{
+	const Slot* slot = reinterpret_cast<const Slot*>(&element);
+	return slot >= m_slots.get() && slot < m_slots.get() + m_capacity;
+}
+
+template <typename T>
+template <typename ...ConstructParams>
+T& EntityPool<T>::emplace_back(ConstructParams&&... constructParams)
+{
+	assert(!m_freeSlots.empty());
+	const int slot = m_freeSlots.back();
+	T* element = new (&m_slots[slot].storage) T(std::forward<ConstructParams>(constructParams)...);
+	m_freeSlots.pop_back();
+
+	m_slots[slot].previous = m_last;
+	m_slots[slot].next = INVALID_SLOT;
+	if (m_last != INVALID_SLOT)
+	{
+		m_slots[m_last].next = slot;
+	}
+	else
+	{
+		m_first = slot;
+	}
+	m_last = slot;
+	++m_size;
+
+	return *element;
+}
+
+template <typename T>
+void EntityPool<T>::erase(const T& element)
+{
+	const int slot = getSlot(element);
+	const int previous = m_slots[slot].previous;
+	const int next = m_slots[slot].next;
+	if (previous != INVALID_SLOT)
+	{
+		m_slots[previous].next = next;
+	}
+	else
+	{
+		m_first = next;
+	}
+	if (next != INVALID_SLOT)
+	{
+		m_slots[next].previous = previous;
+	}
+	else
+	{
+		m_last = previous;
+	}
+
+	--m_size;
+	m_freeSlots.push_back(slot);
+	get(slot).~T();
+}
+
+//The element is the first member of its slot
+template <typename T>
+int EntityPool<T>::getSlot(const T& element) const
+{
+	assert(contains(element));
+	return static_cast<int>(reinterpret_cast<const Slot*>(&element) - m_slots.get());
+}
+
+template <typename T>
+T& EntityPool<T>::get(int slot)
+{
+	return *std::launder(reinterpret_cast<T*>(&m_slots[slot].storage));
+}
@@ -0,0 +1,203 @@
+#include "Core/EntitySpatialIndex.h"
+#include "Core/AABB.h"
+#include "Core/Globals.h"
+#include "Entities/Entity.h"
+#include <algorithm>
+#include <assert.h>
+#include <iterator>
+
+namespace
+{
+	constexpr float CELL_SIZE = static_cast<float>(Globals::NODE_SIZE * 8);
+
+	void sortCandidates(std::vector<EntitySpatialEntry>& candidates)
+	{
+		std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b)
+		{
+			return a.order < b.order;
+		});
+		candidates.erase(std::unique(candidates.begin(), candidates.end(), [](const auto& a, const auto& b)
+		{
+			return a.order == b.order;
+		}), candidates.end());
+	}
+}
+
+EntitySpatialIndex::EntitySpatialIndex()
+	: m_buckets(),
+	m_entityBuckets(),
+	m_maxExtent(0.f),
+	m_nextOrder(0),
+	m_candidates(),
+	m_entities()
+{}
+
+//Same selection as walking every entity in creation order - a unit in range replaces a building
+const Entity* EntitySpatialIndex::getClosestEntity(const glm::vec3& position, float maxDistance, bool prioritizeUnits) const
+{
+	getEntities(position, maxDistance, m_entities);
+
+	const Entity* closestEntity = nullptr;
+	float closestEntityDistance = maxDistance * maxDistance;
+	for (const auto& entity : m_entities)
+	{
+		float distance = Globals::getSqrDistance(entity->getPosition(), position);
+		if (prioritizeUnits && closestEntity && Globals::BUILDING_TYPES.isMatch(closestEntity->getEntityType()) &&
+			Globals::UNIT_TYPES.isMatch(entity->getEntityType()))
+		{
+			closestEntity = entity;
+			closestEntityDistance = distance;
+		}
+		else if (distance < closestEntityDistance)
+		{
+			closestEntity = entity;
+			closestEntityDistance = distance;
+		}
+	}
+
+	return closestEntity;
+}
+
+const Entity* EntitySpatialIndex::getEntity(const glm::vec3& position) const
+{
+	getEntities(AABB(position.x, position.x, position.z, position.z), m_entities);
+
+	const auto entity = std::find_if(m_entities.cbegin(), m_entities.cend(), [&position](const auto& entity)
+	{
+		return entity->getAABB().contains(position);
+	});
+
+	return entity != m_entities.cend() ? *entity : nullptr;
+}
+
+//Entities strictly within maxDistance
+void EntitySpatialIndex::getEntities(const glm::vec3& position, float maxDistance, std::vector<const Entity*>& entities) const
+{
+	m_candidates.clear();
+	addCandidates(getCell(position - maxDistance), getCell(position + maxDistance), [&position, maxDistance](const auto& entry)
+	{
+		return Globals::getSqrDistance(entry.position, position) < maxDistance * maxDistance;
+	}, m_candidates);
+	sortCandidates(m_candidates);
+
+	entities.clear();
+	for (const auto& candidate : m_candidates)
+	{
+		entities.push_back(candidate.entity);
+	}
+}
+
+//Entities whose AABB overlaps or touches the AABB on the ground
+void EntitySpatialIndex::getEntities(const AABB& aabb, std::vector<const Entity*>& entities) const
+{
+	m_candidates.clear();
+	const AABB expandedAABB(aabb.getLeft() - m_maxExtent, aabb.getRight() + m_maxExtent,
+		aabb.getForward() + m_maxExtent, aabb.getBack() - m_maxExtent);
+	addCandidates(getCell({ expandedAABB.getLeft(), 0.f, expandedAABB.getBack() }),
+		getCell({ expandedAABB.getRight(), 0.f, expandedAABB.getForward() }), [&aabb](const auto& entry)
+	{
+		const AABB& entityAABB = entry.entity->getAABB();
+		return entityAABB.getLeft() <= aabb.getRight() &&
+			entityAABB.getRight() >= aabb.getLeft() &&
+			entityAABB.getBack() <= aabb.getForward() &&
+			entityAABB.getForward() >= aabb.getBack();
+	}, m_candidates);
+	sortCandidates(m_candidates);
+
+	entities.clear();
+	for (const auto& candidate : m_candidates)
+	{
+		entities.push_back(candidate.entity);
+	}
+}
+
+void EntitySpatialIndex::add(const Entity& entity)
+{
+	assert(m_entityBuckets.find(entity.getID()) == m_entityBuckets.cend());
+	const int bucket = getBucket(getCell(entity.getPosition()));
+	m_buckets[bucket].push_back({ &entity, entity.getPosition(), entity.getID(), m_nextOrder++ });
+	m_entityBuckets.emplace(entity.getID(), bucket);
+
+	const AABB& aabb = entity.getAABB();
+	const glm::vec3& position = entity.getPosition();
+	m_maxExtent = glm::max(m_maxExtent, glm::max(glm::max(position.x - aabb.getLeft(), aabb.getRight() - position.x),
+		glm::max(position.z - aabb.getBack(), aabb.getForward() - position.z)));
+}
+
+void EntitySpatialIndex::remove(int entityID)
+{
+	const auto entityBucket = m_entityBuckets.find(entityID);
+	assert(entityBucket != m_entityBuckets.cend());
+	auto& bucket = m_buckets[entityBucket->second];
+	const auto entry = std::find_if(bucket.begin(), bucket.end(), [entityID](const auto& entry)
+	{
+		return entry.ID == entityID;
+	});
+	assert(entry != bucket.end());
+	*entry = bucket.back();
+	bucket.pop_back();
+	m_entityBuckets.erase(entityBucket);
+}
+
+void EntitySpatialIndex::update(const Entity& entity)
+{
+	const auto entityBucket = m_entityBuckets.find(entity.getID());
+	assert(entityBucket != m_entityBuckets.cend());
+	auto& bucket = m_buckets[entityBucket->second];
+	const auto entry = std::find_if(bucket.begin(), bucket.end(), [ID = entity.getID()](const auto& entry)
+	{
+		return entry.ID == ID;
+	});
+	assert(entry != bucket.end());
+	entry->entity = &entity;
+	entry->position = entity.getPosition();
+
+	const int newBucket = getBucket(getCell(entity.getPosition()));
+	if (newBucket != entityBucket->second)
+	{
+		m_buckets[newBucket].push_back(*entry);
+		*entry = bucket.back();
+		bucket.pop_back();
+		entityBucket->second = newBucket;
+	}
+}
+
+int EntitySpatialIndex::getBucket(glm::ivec2 cell) const
+{
+	const unsigned int hash = (static_cast<unsigned int>(cell.x) * 73856093u) ^ (static_cast<unsigned int>(cell.y) * 19349663u);
+	return static_cast<int>(hash % BUCKET_COUNT);
+}
+
+glm::ivec2 EntitySpatialIndex::getCell(const glm::vec3& position) const
+{
+	return glm::ivec2(glm::floor(glm::vec2(position.x, position.z) / CELL_SIZE));
+}
+
+//Cells sharing a bucket add its entities more than once - callers sort and remove duplicates
+template <typename Predicate>
+void EntitySpatialIndex::addCandidates(glm::ivec2 minimum, glm::ivec2 maximum, Predicate predicate,
+	std::vector<EntitySpatialEntry>& candidates) const
+{
+	auto addBucket = [&predicate, &candidates](const std::vector<EntitySpatialEntry>& bucket)
+	{
+		std::copy_if(bucket.cbegin(), bucket.cend(), std::back_inserter(candidates), predicate);
+	};
+
+	if ((maximum.x - minimum.x + 1) * (maximum.y - minimum.y + 1) >= BUCKET_COUNT)
+	{
+		for (const auto& bucket : m_buckets)
+		{
+			addBucket(bucket);
+		}
+
+		return;
+	}
+
+	for (int x = minimum.x; x <= maximum.x; ++x)
+	{
+		for (int y = minimum.y; y <= maximum.y; ++y)
+		{
+			addBucket(m_buckets[getBucket({ x, y })]);
+		}
+	}
+}
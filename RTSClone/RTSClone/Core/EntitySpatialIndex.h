@@ -0,0 +1,51 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+//Spatial hash of a faction's entities, bucketed by the coarse cell their position is in so range and area
+//queries only look at the entities near them rather than every entity the faction owns.
+//Entities have to be updated whenever they move - candidates are returned in the order they were added
+//so results match walking the faction's entities in creation order. Queries fill the index's own scratch buffers,
+//so an index is only ever queried from one thread at a time.
+class AABB;
+class Entity;
+struct EntitySpatialEntry
+{
+	const Entity* entity		= nullptr;
+	glm::vec3 position			= {};
+	int ID						= 0;
+	int order					= 0;
+};
+
+class EntitySpatialIndex
+{
+public:
+	EntitySpatialIndex();
+
+	const Entity* getClosestEntity(const glm::vec3& position, float maxDistance, bool prioritizeUnits) const;
+	const Entity* getEntity(const glm::vec3& position) const;
+	void getEntities(const glm::vec3& position, float maxDistance, std::vector<const Entity*>& entities) const;
+	void getEntities(const AABB& aabb, std::vector<const Entity*>& entities) const;
+
+	void add(const Entity& entity);
+	void remove(int entityID);
+	void update(const Entity& entity);
+
+private:
+	static constexpr int BUCKET_COUNT = 256;
+
+	std::array<std::vector<EntitySpatialEntry>, BUCKET_COUNT> m_buckets;
+	std::unordered_map<int, int> m_entityBuckets;
+	float m_maxExtent;
+	int m_nextOrder;
+	mutable std::vector<EntitySpatialEntry> m_candidates;
+	mutable std::vector<const Entity*> m_entities;
+
+	int getBucket(glm::ivec2 cell) const;
+	glm::ivec2 getCell(const glm::vec3& position) const;
+	template <typename Predicate>
+	void addCandidates(glm::ivec2 minimum, glm::ivec2 maximum, Predicate predicate, std::vector<EntitySpatialEntry>& candidates) const;
+};
@@ -0,0 +1,141 @@
+#include "Core/FlowField.h"
+#include "Core/Globals.h"
+#include "Core/Map.h"
+#include "Events/GameMessages.h"
+#include "Model/AdjacentPositions.h"
+#include <algorithm>
+#include <cstdlib>
+
+FlowField::FlowField()
+	: m_nodes(),
+	m_frontier(),
+	m_frontierSize(0),
+	m_frontierCost(0),
+	m_mapSize(0, 0),
+	m_goal(0, 0),
+	m_groupPosition(0, 0),
+	m_fieldID(0),
+	m_valid(false),
+	m_onNewMapSizeID([this](const GameMessages::MapSize& gameMessage) { return onNewMapSize(gameMessage); }),
+	m_onAddAABBID([this](const GameMessages::AddAABBToMap&) { m_valid = false; }),
+	m_onRemoveAABBID([this](const GameMessages::RemoveAABBFromMap&) { m_valid = false; })
+{}
+
+bool FlowField::isCovering(glm::ivec2 destination, float radius, const Map& map) const
+{
+	return m_valid && m_mapSize == map.getSize() && Globals::getDistance(destination, m_goal) <= radius;
+}
+
+void FlowField::setGoal(glm::ivec2 goal, glm::ivec2 groupPosition, const Map& map)
+{
+	if (m_mapSize != map.getSize() || (m_valid && goal == m_goal))
+	{
+		return;
+	}
+
+	if (++m_fieldID == 0)
+	{
+		std::fill(m_nodes.begin(), m_nodes.end(), FlowFieldNode());
+		m_fieldID = 1;
+	}
+
+	m_goal = goal;
+	m_groupPosition = groupPosition;
+	m_valid = map.isWithinBounds(goal) && !map.isPositionOccupied(goal);
+	for (auto& bucket : m_frontier)
+	{
+		bucket.clear();
+	}
+	m_frontierSize = 0;
+	m_frontierCost = getCost(goal, 0);
+	if (m_valid)
+	{
+		m_nodes[Globals::convertTo1D(goal, m_mapSize)] = { 0, m_fieldID, false };
+		addToFrontier(goal, 0);
+	}
+}
+
+bool FlowField::getDistance(glm::ivec2 position, const Map& map, int& distance)
+{
+	assert(m_valid && m_mapSize == map.getSize() && map.isWithinBounds(position));
+
+	const FlowFieldNode& node = m_nodes[Globals::convertTo1D(position, m_mapSize)];
+	while (!(node.fieldID == m_fieldID && node.settled) && m_frontierSize > 0)
+	{
+		integrate(map);
+	}
+
+	return getSettledDistance(position, map, distance);
+}
+
+bool FlowField::getSettledDistance(glm::ivec2 position, const Map& map, int& distance) const
+{
+	const FlowFieldNode& node = m_nodes[Globals::convertTo1D(position, map.getSize())];
+	if (node.fieldID != m_fieldID || !node.settled)
+	{
+		return false;
+	}
+
+	distance = node.distance;
+	return true;
+}
+
+int FlowField::getCost(glm::ivec2 position, int distance) const
+{
+	const int x = std::abs(m_groupPosition.x - position.x);
+	const int y = std::abs(m_groupPosition.y - position.y);
+	return distance + FLOW_FIELD_DIAGONAL_COST * std::min(x, y) + FLOW_FIELD_STRAIGHT_COST * (std::max(x, y) - std::min(x, y));
+}
+
+void FlowField::addToFrontier(glm::ivec2 position, int distance)
+{
+	m_frontier[getCost(position, distance) % m_frontier.size()].push_back(position);
+	++m_frontierSize;
+}
+
+void FlowField::integrate(const Map& map)
+{
+	while (m_frontier[m_frontierCost % m_frontier.size()].empty())
+	{
+		++m_frontierCost;
+	}
+
+	std::vector<glm::ivec2>& bucket = m_frontier[m_frontierCost % m_frontier.size()];
+	const glm::ivec2 position = bucket.back();
+	bucket.pop_back();
+	--m_frontierSize;
+
+	//Positions are added again rather than moved when a shorter distance is found
+	FlowFieldNode& node = m_nodes[Globals::convertTo1D(position, m_mapSize)];
+	if (node.settled || getCost(position, node.distance) != m_frontierCost)
+	{
+		return;
+	}
+
+	node.settled = true;
+	for (const auto& adjacentPosition : getAdjacentPositions(position, map))
+	{
+		if (!adjacentPosition.valid)
+		{
+			continue;
+		}
+
+		FlowFieldNode& adjacentNode = m_nodes[Globals::convertTo1D(adjacentPosition.position, m_mapSize)];
+		const glm::ivec2 direction = adjacentPosition.position - position;
+		const int distance = node.distance + (direction.x != 0 && direction.y != 0 ? FLOW_FIELD_DIAGONAL_COST : FLOW_FIELD_STRAIGHT_COST);
+		if (adjacentNode.fieldID != m_fieldID || (!adjacentNode.settled && distance < adjacentNode.distance))
+		{
+			adjacentNode = { distance, m_fieldID, false };
+			addToFrontier(adjacentPosition.position, distance);
+		}
+	}
+}
+
+void FlowField::onNewMapSize(const GameMessages::MapSize& gameMessage)
+{
+	m_mapSize = gameMessage.mapSize;
+	m_nodes.clear();
+	m_nodes.resize(static_cast<size_t>(m_mapSize.x) * static_cast<size_t>(m_mapSize.y));
+	m_fieldID = 0;
+	m_valid = false;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include "Events/GameMessenger.h"
+#include <array>
+#include <vector>
+
+//Distance to the goal over the static map for each position - integrated outwards from the goal on demand,
+//so positions are only settled once a query needs them. Kept until the goal changes or the map is edited.
+//The frontier is ordered towards the group given with the goal, which stays exact as the heuristic is consistent.
+//Distances are in fifths of a node so the frontier can be a bucket queue rather than a heap.
+constexpr int FLOW_FIELD_STRAIGHT_COST = 5;
+constexpr int FLOW_FIELD_DIAGONAL_COST = 7;
+
+struct FlowFieldNode
+{
+	int distance{ 0 };
+	unsigned int fieldID{ 0 };
+	bool settled{ false };
+};
+
+namespace GameMessages
+{
+	struct MapSize;
+	struct AddAABBToMap;
+	struct RemoveAABBFromMap;
+}
+class Map;
+class FlowField
+{
+public:
+	FlowField();
+	FlowField(const FlowField&) = delete;
+	FlowField& operator=(const FlowField&) = delete;
+	FlowField(FlowField&&) = delete;
+	FlowField& operator=(FlowField&&) = delete;
+
+	bool isCovering(glm::ivec2 destination, float radius, const Map& map) const;
+
+	void setGoal(glm::ivec2 goal, glm::ivec2 groupPosition, const Map& map);
+	bool getDistance(glm::ivec2 position, const Map& map, int& distance);
+	bool getSettledDistance(glm::ivec2 position, const Map& map, int& distance) const;
+
+private:
+	std::vector<FlowFieldNode> m_nodes;
+	std::array<std::vector<glm::ivec2>, FLOW_FIELD_DIAGONAL_COST * 2 + 1> m_frontier;
+	size_t m_frontierSize;
+	int m_frontierCost;
+	glm::ivec2 m_mapSize;
+	glm::ivec2 m_goal;
+	glm::ivec2 m_groupPosition;
+	unsigned int m_fieldID;
+	bool m_valid;
+	BroadcasterSub<GameMessages::MapSize> m_onNewMapSizeID;
+	BroadcasterSub<GameMessages::AddAABBToMap> m_onAddAABBID;
+	BroadcasterSub<GameMessages::RemoveAABBFromMap> m_onRemoveAABBID;
+
+	int getCost(glm::ivec2 position, int distance) const;
+	void addToFrontier(glm::ivec2 position, int distance);
+	void integrate(const Map& map);
+	void onNewMapSize(const GameMessages::MapSize& gameMessage);
+};
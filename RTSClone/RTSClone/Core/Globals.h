@@ -314,22 +314,32 @@ namespace Globals
 		return currentPosition + glm::vec3(targetPosition - currentPosition) / magnitude * maxDistanceDelta;
 	}
 
-	inline int getRandomNumber(int min, int max)
+	inline std::mt19937& getRandomEngine()
 	{
 		static std::random_device rd;  //Will be used to obtain a seed for the random number engine
 		static std::mt19937 gen(rd()); //Standard mersenne_twister_engine seeded with rd()
+
+		return gen;
+	}
+
+	//Allows for reproducible runs - call before the level is constructed
+	inline void setRandomSeed(unsigned int seed)
+	{
+		getRandomEngine().seed(seed);
+	}
+
+	inline int getRandomNumber(int min, int max)
+	{
 		std::uniform_int_distribution<> dis(min, max);
 
-		return dis(gen);
+		return dis(getRandomEngine());
 	}
 
 	inline float getRandomNumber(float min, float max)
 	{
-		static std::random_device rd;  //Will be used to obtain a seed for the random number engine
-		static std::mt19937 gen(rd()); //Standard mersenne_twister_engine seeded with rd()
 		std::uniform_real_distribution<float> distrib(min, max);
 
-		return distrib(gen);
+		return distrib(getRandomEngine());
 	}
 
 	inline float getAngle(const glm::vec3& positionB, const glm::vec3& positionA, float offsetYRotation = 90.0f)
@@ -10,10 +10,10 @@ Graph::Graph()
 
 void Graph::add(glm::ivec2 position, glm::ivec2 cameFromPosition, const Map& map)
 {
-	assert(map.isWithinBounds(position) && !m_graph[Globals::convertTo1D(position, map.getSize())]);
-	if (map.isWithinBounds(position) && !m_graph[Globals::convertTo1D(position, map.getSize())])
+	assert(map.isWithinBounds(position) && !is_position_visited(position, map));
+	if (map.isWithinBounds(position) && !is_position_visited(position, map))
 	{
-		m_graph[Globals::convertTo1D(position, map.getSize())] = cameFromPosition;
+		m_graph[Globals::convertTo1D(position, map.getSize())] = { cameFromPosition, m_searchID };
 		m_frontier.push(position);
 		assert(m_frontier.size() <= (m_size.x * m_size.y));
 	}
@@ -22,15 +22,20 @@ void Graph::add(glm::ivec2 position, glm::ivec2 cameFromPosition, const Map& map
 void Graph::new_map_size(const GameMessages::MapSize& gameMessage)
 {
 	m_size = gameMessage.mapSize;
-	m_graph.resize(static_cast<size_t>(m_size.x * m_size.y));
-	m_graph.assign(m_graph.size(), {});
+	m_graph.assign(static_cast<size_t>(m_size.x * m_size.y), {});
+	m_searchID = 0;
 }
 
 void Graph::reset(glm::ivec2 startingPosition)
 {
 	m_frontier = {};
 	m_frontier.push(startingPosition);
-	m_graph.assign(m_graph.size(), {});
+	++m_searchID;
+	if (m_searchID == 0)
+	{
+		m_graph.assign(m_graph.size(), {});
+		m_searchID = 1;
+	}
 }
 
 bool Graph::is_frontier_empty() const
@@ -51,7 +56,7 @@ bool Graph::is_position_visited(glm::ivec2 position, const Map& map) const
 	assert(map.isWithinBounds(position));
 	if (map.isWithinBounds(position))
 	{
-		return m_graph[Globals::convertTo1D(position, map.getSize())].has_value();
+		return m_graph[Globals::convertTo1D(position, map.getSize())].searchID == m_searchID;
 	}
 
 	return false;
@@ -8,6 +8,12 @@
 #include <queue>
 #include <optional>
 
+struct GraphNode
+{
+	glm::ivec2 cameFrom = { 0, 0 };
+	unsigned int searchID = 0;
+};
+
 namespace GameMessages
 {
 	struct MapSize;
@@ -28,7 +34,8 @@ public:
 private:
 	std::queue<glm::ivec2> m_frontier = {};
 	glm::ivec2 m_size = { 0, 0 };
-	std::vector<std::optional<glm::ivec2>> m_graph = {};
+	std::vector<GraphNode> m_graph = {};
+	unsigned int m_searchID = 0;
 	BroadcasterSub<GameMessages::MapSize> m_onNewMapSizeID;
 	
 	void new_map_size(const GameMessages::MapSize& gameMessage);
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include <stdlib.h>
+
+//Every node the line between the centres of two nodes passes through, in order from the start and stepping in whole
+//nodes only - both sides are visited where it passes exactly through a corner, so it can't slip between two diagonal nodes.
+//The starting node isn't visited
+namespace GridLine
+{
+	//Stops at and returns true on the first node isFound returns true for
+	template <typename IsFound>
+	bool find(glm::ivec2 start, glm::ivec2 end, IsFound isFound)
+	{
+		const glm::ivec2 step(end.x > start.x ? 1 : -1, end.y > start.y ? 1 : -1);
+		const int dx = abs(end.x - start.x);
+		const int dy = abs(end.y - start.y);
+		int error = dx - dy;
+		glm::ivec2 position = start;
+		for (int remaining = dx + dy; remaining > 0; --remaining)
+		{
+			if (error > 0)
+			{
+				position.x += step.x;
+				error -= 2 * dy;
+			}
+			else if (error < 0)
+			{
+				position.y += step.y;
+				error += 2 * dx;
+			}
+			else
+			{
+				if (isFound(glm::ivec2(position.x + step.x, position.y)) || isFound(glm::ivec2(position.x, position.y + step.y)))
+				{
+					return true;
+				}
+
+				position += step;
+				error += 2 * (dx - dy);
+				--remaining;
+			}
+
+			if (isFound(position))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
@@ -1,55 +1,66 @@
 #include "Core/Level.h"
 #include "Core/LevelFileHandler.h"
+#include "Core/PathFinding.h"
 #include "Events/GameMessenger.h"
 #include "Events/GameMessages.h"
 #include "Graphics/ModelManager.h"
+#ifndef HEADLESS
 #include "UI/UIManager.h"
 #include "Core/Camera.h"
-#include "AI/AIConstants.h"
 #include <imgui/imgui.h>
+#endif // HEADLESS
+#include "AI/AIConstants.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
 
 namespace
 {
 	constexpr glm::vec3 TERRAIN_COLOR = { 0.9098039f, 0.5176471f, 0.3882353f };
-	std::queue<GameEvent> gameEvents = {};
-
-	bool is_hit_entity(const Projectile& projectile, FactionHandler& factionHandler)
+	constexpr int TICKS_PER_SECOND = 30;
+	constexpr float TICK_TIME = 1.0f / TICKS_PER_SECOND;
+	constexpr float MAX_FRAME_TIME = 0.25f;
+	constexpr int DELAYED_UPDATES_PER_SECOND = 10;
+	static_assert(TICKS_PER_SECOND % DELAYED_UPDATES_PER_SECOND == 0, "Delayed update has to fall on a tick");
+	constexpr size_t PARALLEL_MOVEMENT_ENTITIES = 2000;
+	GameEventQueue gameEvents;
+	bool movingFactions = false;
+
+	int getDelayedUpdateTicks(float deltaTime)
 	{
-		const Entity* entity = nullptr;
-		if (const Faction* targetFaction = factionHandler.getFaction(projectile.getSenderEvent().targetFaction))
-		{
-			entity =
-				targetFaction->getEntity(projectile.getAABB(), projectile.getSenderEvent().targetID);
-		}
-
-		return entity;
+		return std::max(1, static_cast<int>(std::lround(1.0f / (DELAYED_UPDATES_PER_SECOND * deltaTime))));
 	}
 }
 
 //Level
-Level::Level(LevelDetailsFromFile&& levelDetails, glm::ivec2 windowSize)
+Level::Level(LevelDetailsFromFile&& levelDetails, [[maybe_unused]] glm::ivec2 windowSize, bool AIControlledPlayer)
 	: m_baseHandler(std::move(levelDetails.bases)),
 	m_scenery(std::move(levelDetails.scenery)),
 	m_playableArea(levelDetails.size, TERRAIN_COLOR),
 	m_map(m_scenery, m_baseHandler.getBases(), levelDetails.gridSize),
-	m_factionHandler(m_baseHandler, levelDetails)
+	m_frameTime(0.0f),
+	m_interpolation(1.0f),
+	m_delayedUpdateTick(0),
+	m_delayedUpdateStaggered(true),
+	m_parallelMovementEntities(PARALLEL_MOVEMENT_ENTITIES),
+	m_localAvoidance(),
+	m_pathSegments(levelDetails.gridSize),
+	m_factionHandler(m_baseHandler, levelDetails, AIControlledPlayer),
+	m_pathRequests()
 {
+	//Avoids building the whole cluster graph on the first long path query
+	PathFinding::getInstance().buildClusterGraph(m_map);
+
 	for (auto& faction : m_factionHandler.getFactions())
 	{
-		switch (faction->getController())
+		if (m_factionHandler.isAIControlled(faction->getController()))
 		{
-		case eFactionController::Player:
-			break;
-		case eFactionController::AI_1:
-		case eFactionController::AI_2:
-		case eFactionController::AI_3:
 			static_cast<FactionAI&>(*faction.get()).setTargetFaction(m_factionHandler);
-			break;
-		default:
-			assert(false);
 		}
 	}
 	
+#ifndef HEADLESS
 	glm::vec2 cameraStartingPosition = {};
 	if (FactionPlayer* player = m_factionHandler.getFactionPlayer())
 	{
@@ -73,16 +84,21 @@ Level::Level(LevelDetailsFromFile&& levelDetails, glm::ivec2 windowSize)
 	m_camera.setPosition({ cameraStartingPosition.x, m_camera.position.y, cameraStartingPosition.y }, 
 		m_playableArea.getSize(), windowSize, true);
 	m_camera.maxDistanceFromGround = m_camera.position.y;
+#endif // HEADLESS
 }
 
 std::optional<LevelDetailsFromFile> Level::load(std::string_view levelName, glm::ivec2 windowSize)
 {
+	//Anything still queued was raised by the previous level, some of it by its headquarters as it was destroyed
+	gameEvents.clear();
+
 	return LevelFileHandler::loadLevelFromFile(levelName);
 }
 
 void Level::add_event(const GameEvent& gameEvent)
 {
-	gameEvents.push(gameEvent);
+	assert(!movingFactions);
+	gameEvents.add(gameEvent);
 }
 
 const std::vector<SceneryGameObject>& Level::getSceneryGameObjects() const
@@ -95,6 +111,12 @@ const BaseHandler& Level::getBaseHandler() const
 	return m_baseHandler;
 }
 
+const Map& Level::getMap() const
+{
+	return m_map;
+}
+
+#ifndef HEADLESS
 const Camera& Level::getCamera() const
 {
 	return m_camera;
@@ -104,6 +126,7 @@ bool Level::isMinimapInteracted() const
 {
 	return m_minimap.isUserInteracted();
 }
+#endif // HEADLESS
 
 const std::vector<std::unique_ptr<Faction>>& Level::getFactions() const
 {
@@ -117,8 +140,10 @@ const glm::vec3& Level::getSize() const
 
 Level::~Level()
 {
+#ifndef HEADLESS
 	broadcast<GameMessages::UIClearDisplaySelectedEntity>({});
 	broadcast<GameMessages::UIClearSelectedMineral>({});
+#endif // HEADLESS
 }
 
 const Faction* Level::getWinningFaction() const
@@ -136,6 +161,37 @@ const Faction* Level::getWinningFaction() const
 	return nullptr;
 }
 
+const GameEventStats& Level::getGameEventStats() const
+{
+	return m_gameEventStats;
+}
+
+float Level::getInterpolation() const
+{
+	return m_interpolation;
+}
+
+const PathRequestStats& Level::getPathRequestStats() const
+{
+	return m_pathRequests.getStats();
+}
+
+void Level::setPathRequestBudget(int expandedNodes, int microseconds)
+{
+	m_pathRequests.setBudget(expandedNodes, microseconds);
+}
+
+void Level::setDelayedUpdateStaggered(bool staggered)
+{
+	m_delayedUpdateStaggered = staggered;
+}
+
+void Level::setParallelMovementEntities(size_t entityCount)
+{
+	m_parallelMovementEntities = entityCount;
+}
+
+#ifndef HEADLESS
 void Level::handleInput(glm::uvec2 windowSize, const sf::Window& window, const sf::Event& currentSFMLEvent, UIManager& uiManager)
 {
 	if (ImGui::IsWindowHovered(ImGuiHoveredFlags_::ImGuiHoveredFlags_AnyWindow))
@@ -160,19 +216,11 @@ void Level::handleInput(glm::uvec2 windowSize, const sf::Window& window, const s
 		case sf::Event::MouseButtonPressed:
 		{
 			glm::vec3 position = m_camera.getRayToGroundPlaneIntersection(window);
-			std::for_each(m_factionHandler.getFactions().begin(), m_factionHandler.getFactions().end(), [&position](auto& faction)
+			std::for_each(m_factionHandler.getFactions().begin(), m_factionHandler.getFactions().end(), [&position, this](auto& faction)
 			{
-				switch (faction.get()->getController())
+				if (m_factionHandler.isAIControlled(faction->getController()))
 				{
-				case eFactionController::AI_1:
-				case eFactionController::AI_2:
-				case eFactionController::AI_3:
 					static_cast<FactionAI&>(*faction).selectEntity(position);
-					break;
-				case eFactionController::Player:
-					break;
-				default:
-					assert(false);
 				}
 			});
 
@@ -209,50 +257,140 @@ void Level::update(float deltaTime, UIManager& uiManager, glm::uvec2 windowSize,
 		m_camera.update(deltaTime, window, windowSize, m_playableArea.getSize());
 	}
 
-	for (auto& faction : m_factionHandler.getFactions())
+	updateTicks(deltaTime, &uiManager);
+
+	uiManager.update(m_factionHandler);
+}
+#endif // HEADLESS
+
+void Level::update(float deltaTime)
+{
+	updateSimulation(deltaTime, nullptr);
+}
+
+int Level::updateFrame(float frameTime)
+{
+	return updateTicks(frameTime, nullptr);
+}
+
+//The simulation steps at a fixed rate however often frames are rendered, what's left over of the frame
+//is rendered as the fraction of the way from the previous tick to the last one
+int Level::updateTicks(float frameTime, UIManager* uiManager)
+{
+	m_frameTime += std::min(frameTime, MAX_FRAME_TIME);
+	int ticks = 0;
+	for (; m_frameTime >= TICK_TIME; ++ticks)
 	{
-		faction->update(deltaTime, m_map, m_factionHandler, m_baseHandler);
+		updateSimulation(TICK_TIME, uiManager);
+		m_frameTime -= TICK_TIME;
 	}
 
-	const auto now = std::chrono::high_resolution_clock::now();
-	if (now - m_lastDelayedUpdate >= std::chrono::milliseconds(100))
+	m_interpolation = m_frameTime / TICK_TIME;
+	return ticks;
+}
+
+void Level::updateSimulation(float deltaTime, UIManager* uiManager)
+{
+	SimulationClock::advance(deltaTime);
+
+	//Each faction only moves its own, so the result doesn't depend on which thread moves which faction or when.
+	//Every faction has moved before any of them acts, acting stays in faction order as it reads the others
+	const std::vector<std::unique_ptr<Faction>>& factions = m_factionHandler.getFactions();
+	const size_t entityCount = std::accumulate(factions.cbegin(), factions.cend(), size_t(0), [](size_t count, const auto& faction)
+	{
+		return count + faction->getEntities().size();
+	});
+	//Below this handing the factions to the pool costs more than it saves
+	const bool parallel = entityCount >= m_parallelMovementEntities;
+	//Every faction steers round where every unit of every faction was as the tick started
+	const LocalAvoidance* localAvoidance = nullptr;
+	if (PathFinding::getInstance().isLocalAvoidance())
 	{
-		for (auto& faction : m_factionHandler.getFactions())
+		m_localAvoidance.clear();
+		for (const auto& faction : factions)
 		{
-			faction->delayed_update(m_map, m_factionHandler);
+			m_localAvoidance.add(faction->get_movement_core());
 		}
-		m_lastDelayedUpdate = now;
+
+		m_localAvoidance.sortByCell();
+		localAvoidance = &m_localAvoidance;
 	}
 
-	for (auto& projectile : m_projectiles)
+	movingFactions = true;
+	if (parallel)
 	{
-		projectile.update(deltaTime);
+		PathFinding::getInstance().runJobs(factions.size(), [this, &factions, localAvoidance, deltaTime](size_t factionIndex, int)
+		{
+			factions[factionIndex]->update_movement(deltaTime, m_map, localAvoidance);
+		});
 	}
-
-	m_projectiles.erase(std::remove_if(m_projectiles.begin(), m_projectiles.end(), [this](auto& projectile)
+	else
 	{
-		bool hitEntity = is_hit_entity(projectile, this->m_factionHandler);
-		if (hitEntity)
+		for (auto& faction : factions)
 		{
-			Level::add_event(GameEvent::create<TakeDamageEvent>({ projectile.getSenderEvent().senderFaction,
-				projectile.getSenderEvent().senderID, projectile.getSenderEvent().senderEntityType, projectile.getSenderEvent().targetFaction,
-				projectile.getSenderEvent().targetID, projectile.getSenderEvent().damage }));
+			faction->update_movement(deltaTime, m_map, localAvoidance);
 		}
-		return hitEntity || projectile.isReachedDestination();
-	}), m_projectiles.end());
+	}
+	movingFactions = false;
 
-	const size_t gameEventsSize = gameEvents.size();
-	for (size_t i = 0; i < gameEventsSize; ++i)
+	for (auto& faction : factions)
 	{
-		handleEvent(gameEvents.front(), m_map);
-		uiManager.handleEvent(gameEvents.front());
+		faction->update(deltaTime, m_map, m_factionHandler, m_baseHandler);
+	}
 
-		gameEvents.pop();
+	//Every unit and worker still gets one every delayed update period, a bucket of them each tick of it
+	//rather than all of them together on its last tick
+	const int delayedUpdateTicks = getDelayedUpdateTicks(deltaTime);
+	m_delayedUpdateTick = (m_delayedUpdateTick + 1) % delayedUpdateTicks;
+	if (m_delayedUpdateStaggered || m_delayedUpdateTick == 0)
+	{
+		const int bucketCount = m_delayedUpdateStaggered ? delayedUpdateTicks : 1;
+		const int bucket = m_delayedUpdateTick % bucketCount;
+		//Nothing moves or is removed until the delayed update is over, so units can look for what's in range of them
+		//before any of them acts. A faction's spatial index is only searched by the job it's given
+		const auto findTargetsInRange = [&factions, bucket, bucketCount](size_t factionIndex)
+		{
+			for (const auto& faction : factions)
+			{
+				if (faction != factions[factionIndex])
+				{
+					faction->find_targets_in_range(*factions[factionIndex], bucket, bucketCount);
+				}
+			}
+		};
+		if (parallel)
+		{
+			PathFinding::getInstance().runJobs(factions.size(), [&findTargetsInRange](size_t factionIndex, int)
+			{
+				findTargetsInRange(factionIndex);
+			});
+		}
+		else
+		{
+			for (size_t factionIndex = 0; factionIndex < factions.size(); ++factionIndex)
+			{
+				findTargetsInRange(factionIndex);
+			}
+		}
+		for (auto& faction : factions)
+		{
+			faction->delayed_update(m_map, m_factionHandler, bucket, bucketCount);
+		}
 	}
 
-	uiManager.update(m_factionHandler);
+	m_projectiles.update(deltaTime, m_factionHandler, m_projectileHits);
+	for (const auto& projectileHit : m_projectileHits)
+	{
+		Level::add_event(GameEvent::create(projectileHit));
+	}
+	m_projectileHits.clear();
+
+	handleEvents(uiManager);
+
+	m_pathRequests.update(m_factionHandler, m_map);
 }
 
+#ifndef HEADLESS
 void Level::renderEntitySelector(const sf::Window& window, ShaderHandler& shaderHandler) const
 {
 	if (const FactionPlayer* factionPlayer = m_factionHandler.getFactionPlayer())
@@ -260,6 +398,7 @@ void Level::renderEntitySelector(const sf::Window& window, ShaderHandler& shader
 		factionPlayer->renderEntitySelector(window, shaderHandler);
 	}
 }
+#endif // HEADLESS
 
 void Level::renderPlannedBuildings(ShaderHandler& shaderHandler) const
 {
@@ -269,13 +408,15 @@ void Level::renderPlannedBuildings(ShaderHandler& shaderHandler) const
 	});
 }
 
+#ifndef HEADLESS
 void Level::renderEntityStatusBars(ShaderHandler& shaderHandler, glm::uvec2 windowSize) const
 {
 	std::for_each(m_factionHandler.getFactions().cbegin(), m_factionHandler.getFactions().cend(), [&shaderHandler, windowSize, this](auto& faction)
 	{	
-		faction->renderEntityStatusBars(shaderHandler, m_camera, windowSize);	
+		faction->renderEntityStatusBars(shaderHandler, m_camera, windowSize, m_interpolation);	
 	});
 }
+#endif // HEADLESS
 
 void Level::renderTerrain(ShaderHandler& shaderHandler) const
 {
@@ -295,10 +436,12 @@ void Level::renderBasePositions(ShaderHandler& shaderHandler) const
 	m_baseHandler.renderBasePositions(shaderHandler);
 }
 
+#ifndef HEADLESS
 void Level::renderMinimap(ShaderHandler& shaderHandler, glm::uvec2 windowSize, const sf::Window& window) const
 {
 	m_minimap.render(shaderHandler, windowSize, *this, m_camera, window);
 }
+#endif // HEADLESS
 
 void Level::render(ShaderHandler& shaderHandler) const
 {
@@ -307,16 +450,13 @@ void Level::render(ShaderHandler& shaderHandler) const
 		gameObject.render(shaderHandler);
 	});
 
-	std::for_each(m_factionHandler.getFactions().cbegin(), m_factionHandler.getFactions().cend(), [&shaderHandler](auto& faction)
+	std::for_each(m_factionHandler.getFactions().cbegin(), m_factionHandler.getFactions().cend(), [&shaderHandler, this](auto& faction)
 	{
-		faction->render(shaderHandler); 
+		faction->render(shaderHandler, m_interpolation); 
 	});
 
 	m_baseHandler.renderMinerals(shaderHandler);
-	for (const auto& projectile : m_projectiles)
-	{
-		projectile.render(shaderHandler);
-	}
+	m_projectiles.render(shaderHandler, m_interpolation);
 }
 
 #ifdef RENDER_AABB
@@ -351,6 +491,45 @@ void Level::renderPathing(ShaderHandler& shaderHandler)
 }
 #endif // RENDER_PATHING
 
+//Events raised while handling these are left for the next frame
+void Level::handleEvents([[maybe_unused]] UIManager* uiManager)
+{
+	const auto start = std::chrono::steady_clock::now();
+	m_gameEvents.swap(gameEvents);
+	m_gameEventStats.handled = static_cast<int>(m_gameEvents.getSize());
+	m_gameEventStats.takeDamage = 0;
+	for (const auto& gameEvent : m_gameEvents.getOrderedEvents())
+	{
+		handleEvent(gameEvent, m_map);
+#ifndef HEADLESS
+		if (uiManager)
+		{
+			uiManager->handleEvent(gameEvent);
+		}
+#endif // HEADLESS
+	}
+
+	for (auto& faction : m_factionHandler.getFactions())
+	{
+		std::vector<TakeDamageEvent>& takeDamageEvents = m_gameEvents.getTakeDamageEvents(faction->getController());
+		m_gameEventStats.takeDamage += static_cast<int>(takeDamageEvents.size());
+		faction->handleEvents(takeDamageEvents, m_map, m_factionHandler);
+	}
+
+	for (auto& faction : m_factionHandler.getFactions())
+	{
+		faction->handleEvents(m_gameEvents.getEntityIdleEvents(faction->getController()), m_map, m_factionHandler, m_baseHandler);
+	}
+
+	for (const auto& spawnProjectileEvent : m_gameEvents.getSpawnProjectileEvents())
+	{
+		m_projectiles.add(spawnProjectileEvent);
+	}
+
+	m_gameEvents.clear();
+	m_gameEventStats.microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
 void Level::handleEvent(const GameEvent& gameEvent, const Map& map)
 {
 	Faction* faction = { nullptr };
@@ -359,9 +538,6 @@ void Level::handleEvent(const GameEvent& gameEvent, const Map& map)
 	case eGameEventType::IncreaseFactionShield:
 		faction = m_factionHandler.getFaction(gameEvent.data.increaseFactionShield.factionController);
 		break;
-	case eGameEventType::TakeDamage:
-		faction = m_factionHandler.getFaction(gameEvent.data.takeDamage.targetFaction);
-		break;
 	case eGameEventType::RepairEntity:
 		faction = m_factionHandler.getFaction(gameEvent.data.repairEntity.factionController);
 		break;
@@ -369,7 +545,7 @@ void Level::handleEvent(const GameEvent& gameEvent, const Map& map)
 	case eGameEventType::PlayerSpawnEntity:
 		if (FactionPlayer* factionPlayer = m_factionHandler.getFactionPlayer())
 		{
-			factionPlayer->handleEvent(gameEvent, map, m_factionHandler, m_baseHandler);
+			factionPlayer->handleEvent(gameEvent);
 		}
 		break;
 	case eGameEventType::AttachFactionToBase:
@@ -383,35 +559,41 @@ void Level::handleEvent(const GameEvent& gameEvent, const Map& map)
 	case eGameEventType::ForceSelfDestructEntity:
 		faction = m_factionHandler.getFaction(gameEvent.data.forceSelfDestructEntity.factionController);
 		break;
-	case eGameEventType::EntityIdle:
-		faction = m_factionHandler.getFaction(gameEvent.data.entityIdle.faction);
-		break;
 	case eGameEventType::AddFactionResources:
 		faction = m_factionHandler.getFaction(gameEvent.data.addFactionResources.faction);
 		break;
+	default:
+		break;
 	}
 
 	if (faction) 
 	{
-		faction->handleEvent(gameEvent, map, m_factionHandler, m_baseHandler);
+		faction->handleEvent(gameEvent);
+		if ((gameEvent.type == eGameEventType::AttachFactionToBase || gameEvent.type == eGameEventType::DetachFactionFromBase)
+			&& m_factionHandler.isAIControlled(faction->getController()))
+		{
+			static_cast<FactionAI&>(*faction).handleBaseEvent(gameEvent, map, m_baseHandler);
+		}
 	}
 
 	switch (gameEvent.type)
 	{
 	case eGameEventType::RevalidateMovementPaths:
-		std::for_each(m_factionHandler.getFactions().begin(), m_factionHandler.getFactions().end(), [&gameEvent, &map, this](auto& faction)
-		{
-			faction->handleEvent(gameEvent, map, m_factionHandler, m_baseHandler);	
-		});
+	{
+		const auto& bounds = gameEvent.data.revalidateMovementPaths;
+		m_pathSegments.addPathRequests({ bounds.left, bounds.right, bounds.forward, bounds.back }, m_factionHandler, m_pathRequests);
+	}
 		break;
 	case eGameEventType::HeadquartersDestroyed:
 	{
-		if (m_factionHandler.getFaction(gameEvent.data.headquartersDestroyed.factionController)->get_headquarters_count() == 0
+		//Already removed when more than one of its headquarters was destroyed in the same frame
+		if (const Faction* faction = m_factionHandler.getFaction(gameEvent.data.headquartersDestroyed.factionController);
+			faction && faction->get_headquarters_count() == 0
 			&& m_factionHandler.removeFaction(gameEvent.data.headquartersDestroyed.factionController))
 		{
 			for (auto& faction : m_factionHandler.getFactions())
 			{
-				if (faction->getController() != eFactionController::Player)
+				if (m_factionHandler.isAIControlled(faction->getController()))
 				{
 					static_cast<FactionAI&>(*faction).onFactionElimination(
 						m_factionHandler, gameEvent.data.headquartersDestroyed.factionController);
@@ -420,8 +602,7 @@ void Level::handleEvent(const GameEvent& gameEvent, const Map& map)
 		}
 	}
 		break;
-	case eGameEventType::SpawnProjectile:
-		m_projectiles.emplace_back(gameEvent.data.spawnProjectile);
+	default:
 		break;
 	}
 }
\ No newline at end of file
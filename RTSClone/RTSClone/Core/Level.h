@@ -1,20 +1,26 @@
 #pragma once
 
-#include "Model/Projectile.h"
+#include "Model/ProjectilePool.h"
 #include "Factions/FactionPlayer.h"
 #include "Factions/FactionAI.h"
 #include "Scene/SceneryGameObject.h"
 #include "Factions/FactionHandler.h"
 #include "Core/Base.h"
 #include "Graphics/Quad.h"
+#ifndef HEADLESS
 #include "UI/MiniMap.h"
 #include "Core/Camera.h"
+#endif // HEADLESS
+#include "Core/Timer.h"
+#include "Core/PathRequestQueue.h"
+#include "Core/LocalAvoidance.h"
+#include "Core/PathSegmentIndex.h"
+#include "Events/GameEventQueue.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <SFML/Graphics.hpp>
 #include <optional>
-#include <chrono>
 
 struct LevelDetailsFromFile
 {
@@ -32,7 +38,7 @@ class ShaderHandler;
 class Level
 {
 public:
-	Level(LevelDetailsFromFile&& levelDetails, glm::ivec2 windowSize);
+	Level(LevelDetailsFromFile&& levelDetails, glm::ivec2 windowSize, bool AIControlledPlayer = false);
 	Level(const Level&) = delete;
 	Level& operator=(const Level&) = delete;
 	Level(Level&&) noexcept = default;
@@ -44,21 +50,35 @@ public:
 
 	const std::vector<SceneryGameObject>& getSceneryGameObjects() const;
 	const BaseHandler& getBaseHandler() const;
+	const Map& getMap() const;
+#ifndef HEADLESS
 	const Camera& getCamera() const;
 	bool isMinimapInteracted() const;
+#endif // HEADLESS
 	const std::vector<std::unique_ptr<Faction>>& getFactions() const;
 	const glm::vec3& getSize() const;
 	const Faction* getWinningFaction() const;
+	const PathRequestStats& getPathRequestStats() const;
+	const GameEventStats& getGameEventStats() const;
+	float getInterpolation() const;
 
+	void setPathRequestBudget(int expandedNodes, int microseconds);
+	void setDelayedUpdateStaggered(bool staggered);
+	void setParallelMovementEntities(size_t entityCount);
+
+#ifndef HEADLESS
 	void handleInput(glm::uvec2 windowSize, const sf::Window& window, const sf::Event& currentSFMLEvent, UIManager& uiManager);
 	void update(float deltaTime, UIManager& uiManager, glm::uvec2 windowSize, const sf::Window& window);
 	void renderEntitySelector(const sf::Window& window, ShaderHandler& shaderHandler) const;
-	void renderPlannedBuildings(ShaderHandler& shaderHandler) const;
 	void renderEntityStatusBars(ShaderHandler& shaderHandler, glm::uvec2 windowSize) const;
+	void renderMinimap(ShaderHandler& shaderHandler, glm::uvec2 windowSize, const sf::Window& window) const;
+#endif // HEADLESS
+	void update(float deltaTime);
+	int updateFrame(float frameTime);
+	void renderPlannedBuildings(ShaderHandler& shaderHandler) const;
 	void renderTerrain(ShaderHandler& shaderHandler) const;
 	void renderPlayerPlannedBuilding(ShaderHandler& shaderHandler) const;
 	void renderBasePositions(ShaderHandler& shaderHandler) const;
-	void renderMinimap(ShaderHandler& shaderHandler, glm::uvec2 windowSize, const sf::Window& window) const;
 	void render(ShaderHandler& shaderHandler) const;
 
 #ifdef RENDER_AABB
@@ -73,12 +93,27 @@ private:
 	BaseHandler m_baseHandler;
 	std::vector<SceneryGameObject> m_scenery;
 	Map m_map;
-	std::vector<Projectile> m_projectiles;
+	ProjectilePool m_projectiles;
+	std::vector<TakeDamageEvent> m_projectileHits;
 	Quad m_playableArea;
+#ifndef HEADLESS
 	Camera m_camera;
 	MiniMap m_minimap;
-	std::chrono::high_resolution_clock::time_point m_lastDelayedUpdate = std::chrono::high_resolution_clock::now();
+#endif // HEADLESS
+	float m_frameTime;
+	float m_interpolation;
+	int m_delayedUpdateTick;
+	bool m_delayedUpdateStaggered;
+	size_t m_parallelMovementEntities;
+	LocalAvoidance m_localAvoidance;
+	PathSegmentIndex m_pathSegments;
 	FactionHandler m_factionHandler;
+	PathRequestQueue m_pathRequests;
+	GameEventQueue m_gameEvents;
+	GameEventStats m_gameEventStats;
 
+	int updateTicks(float frameTime, UIManager* uiManager);
+	void updateSimulation(float deltaTime, UIManager* uiManager);
+	void handleEvents(UIManager* uiManager);
 	void handleEvent(const GameEvent& gameEvent, const Map& map);
 };	
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "Core/LineOfSightCache.h"
+
+namespace
+{
+	constexpr int ENTRY_BITS = 16;
+	constexpr size_t ENTRY_COUNT = size_t(1) << ENTRY_BITS;
+	constexpr int NODE_BITS = 24;
+	constexpr int LINE_BITS = 2 * NODE_BITS;
+	constexpr uint64_t MAX_EDIT = (uint64_t(1) << (64 - 1 - LINE_BITS)) - 1;
+	constexpr uint64_t HASH_MULTIPLIER = 11400714819323198485ull;
+
+	bool isCacheable(glm::ivec2 mapSize)
+	{
+		return static_cast<uint64_t>(mapSize.x) * static_cast<uint64_t>(mapSize.y) <= (uint64_t(1) << NODE_BITS);
+	}
+}
+
+LineOfSightCache::LineOfSightCache(glm::ivec2 mapSize)
+	: m_mapSize(mapSize),
+	m_enabled(isCacheable(mapSize)),
+	m_edit(1),
+	m_entries(std::make_unique<std::atomic<uint64_t>[]>(ENTRY_COUNT))
+{}
+
+bool LineOfSightCache::find(glm::ivec2 start, glm::ivec2 end, bool& occupied) const
+{
+	if (!m_enabled)
+	{
+		return false;
+	}
+
+	const uint64_t line = getLine(start, end);
+	const uint64_t entry = getEntry(line).load(std::memory_order_relaxed);
+	if ((entry >> 1) != ((m_edit << LINE_BITS) | line))
+	{
+		return false;
+	}
+
+	occupied = entry & 1;
+	return true;
+}
+
+void LineOfSightCache::add(glm::ivec2 start, glm::ivec2 end, bool occupied)
+{
+	if (m_enabled)
+	{
+		const uint64_t line = getLine(start, end);
+		getEntry(line).store((((m_edit << LINE_BITS) | line) << 1) | static_cast<uint64_t>(occupied), std::memory_order_relaxed);
+	}
+}
+
+//Only called between searches - entries from before the edit counter wraps round are wiped so they can't match again
+void LineOfSightCache::clear()
+{
+	if (++m_edit > MAX_EDIT)
+	{
+		for (size_t i = 0; i < ENTRY_COUNT; ++i)
+		{
+			m_entries[i].store(0, std::memory_order_relaxed);
+		}
+
+		m_edit = 1;
+	}
+}
+
+void LineOfSightCache::setEnabled(bool enabled)
+{
+	m_enabled = enabled && isCacheable(m_mapSize);
+	clear();
+}
+
+uint64_t LineOfSightCache::getLine(glm::ivec2 start, glm::ivec2 end) const
+{
+	const uint64_t startNode = static_cast<uint64_t>(start.y) * static_cast<uint64_t>(m_mapSize.x) + static_cast<uint64_t>(start.x);
+	const uint64_t endNode = static_cast<uint64_t>(end.y) * static_cast<uint64_t>(m_mapSize.x) + static_cast<uint64_t>(end.x);
+	return (startNode << NODE_BITS) | endNode;
+}
+
+std::atomic<uint64_t>& LineOfSightCache::getEntry(uint64_t line) const
+{
+	return m_entries[(line * HASH_MULTIPLIER) >> (64 - ENTRY_BITS)];
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+//Whether the line from one node to another is occupied, kept until the map is next edited.
+//Each entry is a single word holding both nodes, the edit it was found after and the result, so every thread
+//searching paths reads and writes it without a lock - an entry since taken by another line or left from before
+//the last edit is only a miss.
+class LineOfSightCache
+{
+public:
+	LineOfSightCache(glm::ivec2 mapSize);
+	LineOfSightCache(const LineOfSightCache&) = delete;
+	LineOfSightCache& operator=(const LineOfSightCache&) = delete;
+	LineOfSightCache(LineOfSightCache&&) = delete;
+	LineOfSightCache& operator=(LineOfSightCache&&) = delete;
+
+	bool find(glm::ivec2 start, glm::ivec2 end, bool& occupied) const;
+
+	void add(glm::ivec2 start, glm::ivec2 end, bool occupied);
+	void clear();
+	void setEnabled(bool enabled);
+
+private:
+	glm::ivec2 m_mapSize;
+	bool m_enabled;
+	uint64_t m_edit;
+	std::unique_ptr<std::atomic<uint64_t>[]> m_entries;
+
+	uint64_t getLine(glm::ivec2 start, glm::ivec2 end) const;
+	std::atomic<uint64_t>& getEntry(uint64_t line) const;
+};
@@ -0,0 +1,211 @@
+#include "Core/LocalAvoidance.h"
+#include "Core/Globals.h"
+#include "Core/Map.h"
+#include "Core/MovementCore.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	constexpr float RADIUS = static_cast<float>(Globals::NODE_SIZE) * 0.4f;
+	constexpr float NEIGHBOUR_DISTANCE = static_cast<float>(Globals::NODE_SIZE) * 3.f;
+	constexpr float ARRIVAL_DISTANCE = static_cast<float>(Globals::NODE_SIZE);
+	constexpr float TIME_HORIZON = 1.f;
+	constexpr float COLLISION_WEIGHT = 5.f;
+	constexpr float MIN_TIME_TO_COLLISION = 0.01f;
+	constexpr int MAX_NEIGHBOURS = 16;
+	constexpr std::array<float, 7> CANDIDATE_ANGLES = { 0.f, 25.f, -25.f, 50.f, -50.f, 80.f, -80.f };
+	constexpr std::array<float, 3> CANDIDATE_SPEEDS = { 1.f, 0.5f, 0.f };
+
+	struct Candidate
+	{
+		glm::vec2 direction		= {};
+		float speed				= 0.f;
+		float deviation			= 0.f;
+	};
+
+	//Least turned from heading straight on at full speed first, so scoring can stop at the first candidate
+	//turning further than the best one's whole penalty
+	std::array<Candidate, CANDIDATE_ANGLES.size() * 2 + 1> createCandidates()
+	{
+		std::array<Candidate, CANDIDATE_ANGLES.size() * 2 + 1> candidates;
+		size_t i = 0;
+		for (float speed : CANDIDATE_SPEEDS)
+		{
+			for (float angle : CANDIDATE_ANGLES)
+			{
+				if (i < candidates.size() && (speed > 0.f || angle == 0.f))
+				{
+					const float radians = glm::radians(angle);
+					const glm::vec2 direction(std::cos(radians), std::sin(radians));
+					candidates[i] = { direction, speed, glm::distance(direction * speed, glm::vec2(1.f, 0.f)) };
+					++i;
+				}
+			}
+		}
+
+		std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b)
+		{
+			return a.deviation < b.deviation;
+		});
+
+		return candidates;
+	}
+
+	const auto CANDIDATES = createCandidates();
+
+	glm::vec2 getPlanarPosition(const glm::vec3& position)
+	{
+		return { position.x, position.z };
+	}
+
+	glm::ivec2 getCell(const glm::vec2& position)
+	{
+		return { static_cast<int>(std::floor(position.x / NEIGHBOUR_DISTANCE)), static_cast<int>(std::floor(position.y / NEIGHBOUR_DISTANCE)) };
+	}
+
+	uint64_t getCellKey(const glm::ivec2& cell)
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(cell.x)) << 32) | static_cast<uint32_t>(cell.y);
+	}
+
+	glm::vec2 rotate(const glm::vec2& v, const glm::vec2& direction)
+	{
+		return { v.x * direction.x - v.y * direction.y, v.x * direction.y + v.y * direction.x };
+	}
+
+	//Seconds until two discs meet moving apart at relativeVelocity - none when they don't, none when already
+	//overlapping unless closing in further
+	float getTimeToCollision(const glm::vec2& relativePosition, const glm::vec2& relativeVelocity)
+	{
+		const float c = glm::dot(relativePosition, relativePosition) - 4.f * RADIUS * RADIUS;
+		const float b = glm::dot(relativePosition, relativeVelocity);
+		if (c < 0.f)
+		{
+			return b > 0.f ? 0.f : std::numeric_limits<float>::max();
+		}
+
+		const float a = glm::dot(relativeVelocity, relativeVelocity);
+		const float discriminant = b * b - a * c;
+		if (b <= 0.f || a <= 0.f || discriminant < 0.f)
+		{
+			return std::numeric_limits<float>::max();
+		}
+
+		return (b - std::sqrt(discriminant)) / a;
+	}
+}
+
+LocalAvoidance::LocalAvoidance()
+	: m_neighbours()
+{}
+
+bool LocalAvoidance::getVelocity(const MovementCore& movementCore, int slot, const Map& map, float deltaTime, glm::vec3& velocity) const
+{
+	const glm::vec3& position3D = movementCore.getPosition(slot);
+	const glm::vec2 position = getPlanarPosition(position3D);
+	const glm::vec2 toWaypoint = getPlanarPosition(movementCore.getWaypoint(slot)) - position;
+	const float waypointDistance = glm::length(toWaypoint);
+	if (waypointDistance <= ARRIVAL_DISTANCE || m_neighbours.empty())
+	{
+		return false;
+	}
+
+	std::array<const Neighbour*, MAX_NEIGHBOURS> neighbours;
+	int neighbourCount = 0;
+	const glm::ivec2 cell = getCell(position);
+	for (int x = cell.x - 1; x <= cell.x + 1 && neighbourCount < MAX_NEIGHBOURS; ++x)
+	{
+		for (int y = cell.y - 1; y <= cell.y + 1 && neighbourCount < MAX_NEIGHBOURS; ++y)
+		{
+			const uint64_t key = getCellKey({ x, y });
+			auto neighbour = std::lower_bound(m_neighbours.cbegin(), m_neighbours.cend(), key,
+				[](const Neighbour& neighbour, uint64_t key) { return neighbour.cell < key; });
+			for (; neighbour != m_neighbours.cend() && neighbour->cell == key && neighbourCount < MAX_NEIGHBOURS; ++neighbour)
+			{
+				if ((neighbour->movementCore != &movementCore || neighbour->slot != slot) &&
+					glm::distance(neighbour->position, position) <= NEIGHBOUR_DISTANCE)
+				{
+					neighbours[neighbourCount++] = &(*neighbour);
+				}
+			}
+		}
+	}
+
+	const glm::vec2 currentVelocity = getPlanarPosition(movementCore.getVelocity(slot));
+	const float speed = movementCore.getSpeed(slot);
+	const glm::vec2 preferredVelocity = toWaypoint / waypointDistance * speed;
+	//Stops once it's no better than the lowest so far
+	auto getPenalty = [&](const glm::vec2& candidateVelocity, float deviation, float lowestPenalty)
+	{
+		float timeToCollision = std::numeric_limits<float>::max();
+		float penalty = deviation;
+		for (int i = 0; i < neighbourCount && penalty < lowestPenalty; ++i)
+		{
+			timeToCollision = std::min(timeToCollision, getTimeToCollision(neighbours[i]->position - position,
+				2.f * candidateVelocity - currentVelocity - neighbours[i]->velocity));
+			if (timeToCollision < TIME_HORIZON)
+			{
+				penalty = deviation + COLLISION_WEIGHT / std::max(timeToCollision, MIN_TIME_TO_COLLISION);
+			}
+		}
+
+		return penalty;
+	};
+
+	float lowestPenalty = getPenalty(preferredVelocity, 0.f, std::numeric_limits<float>::max());
+	if (lowestPenalty <= 0.f)
+	{
+		return false;
+	}
+
+	const glm::ivec2 node = Globals::convertToGridPosition(position3D);
+	const glm::ivec2 waypointNode = Globals::convertToGridPosition(movementCore.getWaypoint(slot));
+	bool steered = false;
+	for (size_t i = 1; i < CANDIDATES.size() && CANDIDATES[i].deviation * speed < lowestPenalty; ++i)
+	{
+		const glm::vec2 candidateVelocity = rotate(preferredVelocity, CANDIDATES[i].direction) * CANDIDATES[i].speed;
+		const float penalty = getPenalty(candidateVelocity, CANDIDATES[i].deviation * speed, lowestPenalty);
+		if (penalty < lowestPenalty)
+		{
+			const glm::vec3 end = position3D + glm::vec3(candidateVelocity.x, 0.f, candidateVelocity.y) * deltaTime;
+			const glm::ivec2 endNode = Globals::convertToGridPosition(end);
+			if (!map.isPositionOccupied(endNode) && !map.isLineOccupied(node, endNode) && !map.isLineOccupied(endNode, waypointNode))
+			{
+				lowestPenalty = penalty;
+				velocity = { candidateVelocity.x, 0.f, candidateVelocity.y };
+				steered = true;
+			}
+		}
+	}
+
+	return steered;
+}
+
+void LocalAvoidance::clear()
+{
+	m_neighbours.clear();
+}
+
+void LocalAvoidance::add(const MovementCore& movementCore)
+{
+	for (int slot = 0; slot < movementCore.getSlotCount(); ++slot)
+	{
+		if (movementCore.isAvoiding(slot))
+		{
+			const glm::vec2 position = getPlanarPosition(movementCore.getPosition(slot));
+			m_neighbours.push_back({ getCellKey(getCell(position)), &movementCore, slot, position, getPlanarPosition(movementCore.getVelocity(slot)) });
+		}
+	}
+}
+
+//Stable so neighbours are always met in the same order
+void LocalAvoidance::sortByCell()
+{
+	std::stable_sort(m_neighbours.begin(), m_neighbours.end(), [](const Neighbour& a, const Neighbour& b)
+	{
+		return a.cell < b.cell;
+	});
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include <stdint.h>
+#include <vector>
+
+//Where every avoiding slot of every faction is and how fast it's going as the tick starts, bucketed into cells as wide
+//as the distance neighbours are looked for over, so each moving unit only looks at the units around it.
+//A moving unit heading into a neighbour picks its velocity as in reciprocal velocity obstacles - candidates fanned out
+//either side of heading straight for its waypoint are scored on how far they turn from it and how soon they'd meet a
+//neighbour, taking each neighbour to turn away by as much, so both sides of a meeting share the turn. Candidates are only
+//picked when the line they sweep is clear and their waypoint is still in sight from where they end, so heading straight
+//for it afterwards never cuts through anything. Units close to their waypoint always head straight for it.
+class MovementCore;
+class Map;
+class LocalAvoidance
+{
+public:
+	LocalAvoidance();
+
+	//False when heading straight for the waypoint is best
+	bool getVelocity(const MovementCore& movementCore, int slot, const Map& map, float deltaTime, glm::vec3& velocity) const;
+
+	void clear();
+	void add(const MovementCore& movementCore);
+	void sortByCell();
+
+private:
+	struct Neighbour
+	{
+		uint64_t cell						= 0;
+		const MovementCore* movementCore	= nullptr;
+		int slot							= 0;
+		glm::vec2 position					= {};
+		glm::vec2 velocity					= {};
+	};
+
+	std::vector<Neighbour> m_neighbours;
+};
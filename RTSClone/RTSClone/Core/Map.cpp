@@ -9,12 +9,13 @@
 
 Map::Map(const std::vector<SceneryGameObject>& sceneryGameObjects, const std::vector<Base>& bases, glm::ivec2 size)
 	: m_size(size),
-	m_map(static_cast<size_t>(m_size.x)* static_cast<size_t>(m_size.y), false),
+	m_occupancy(m_size),
+	m_lineOfSightCache(m_size),
 	m_unitMap(static_cast<size_t>(m_size.x)* static_cast<size_t>(m_size.y), Globals::INVALID_ENTITY_ID),
 	m_addABBID([this](GameMessages::AddAABBToMap&& message) { return addAABB(std::move(message)); }),
 	m_removeABBBFromMapID([this](GameMessages::RemoveAABBFromMap&& message) { return removeAABB(std::move(message)); }),
-	m_addUnitPositionToMapID([this](GameMessages::AddUnitPositionToMap&& message) { return addUnitPosition(std::move(message)); }),
-	m_removeUnitPositionFromMapID([this](GameMessages::RemoveUnitPositionFromMap&& message) { return removeUnitPosition(std::move(message)); })
+	m_addUnitPositionToMapID(*this),
+	m_removeUnitPositionFromMapID(*this)
 {
 	broadcast<GameMessages::MapSize>({ size });
 	for (const auto& gameObject : sceneryGameObjects)
@@ -34,7 +35,7 @@ Map::Map(const std::vector<SceneryGameObject>& sceneryGameObjects, const std::ve
 bool Map::isCollidable(const glm::vec3& position) const
 {
 	assert(isWithinBounds(position));
-	return m_map[Globals::convertTo1D(Globals::convertToGridPosition(position), m_size)];
+	return m_occupancy.isOccupied(Globals::convertToGridPosition(position));
 }
 
 const glm::ivec2& Map::getSize() const
@@ -70,25 +71,42 @@ bool Map::isWithinBounds(const glm::ivec2& position) const
 
 bool Map::isAABBOccupied(const AABB& AABB) const
 {
-	for (int x = static_cast<int>(AABB.getLeft()); x < static_cast<int>(AABB.getRight()); ++x)
+	glm::ivec2 minimum;
+	glm::ivec2 maximum;
+	if (!getGridRectangle(AABB, minimum, maximum))
 	{
-		for (int y = static_cast<int>(AABB.getBack()); y < static_cast<int>(AABB.getForward()); ++y)
-		{
-			if (m_map[Globals::convertTo1D(Globals::convertToGridPosition({ x, Globals::GROUND_HEIGHT, y }), m_size)])
-			{
-				return true;
-			}
-		}
+		return false;
+	}
+	else if (!isWithinBounds(minimum) || !isWithinBounds(maximum))
+	{
+		return true;
 	}
 
-	return false;
+	return m_occupancy.isRectangleOccupied(minimum, maximum);
+}
+
+bool Map::isLineOccupied(glm::ivec2 start, glm::ivec2 end) const
+{
+	if (!isWithinBounds(start) || !isWithinBounds(end))
+	{
+		return true;
+	}
+
+	bool occupied = false;
+	if (!m_lineOfSightCache.find(start, end, occupied))
+	{
+		occupied = m_occupancy.isLineOccupied(start, end);
+		m_lineOfSightCache.add(start, end, occupied);
+	}
+
+	return occupied;
 }
 
 bool Map::isPositionOccupied(const glm::vec3& position) const
 {
 	if (isWithinBounds(position))
 	{
-		return m_map[Globals::convertTo1D(Globals::convertToGridPosition(position), m_size)];
+		return m_occupancy.isOccupied(Globals::convertToGridPosition(position));
 	}
 
 	return true;
@@ -98,7 +116,7 @@ bool Map::isPositionOccupied(const glm::ivec2& position) const
 {
 	if (isWithinBounds(position))
 	{
-		return m_map[Globals::convertTo1D(position, m_size)];
+		return m_occupancy.isOccupied(position);
 	}
 
 	return true;
@@ -135,6 +153,16 @@ void Map::removeUnitPosition(GameMessages::RemoveUnitPositionFromMap&& message)
 	editUnitMap(message.position, message.ID, false);
 }
 
+void StaticListener<GameMessages::AddUnitPositionToMap>::receive(Map& map, GameMessages::AddUnitPositionToMap&& message)
+{
+	map.addUnitPosition(std::move(message));
+}
+
+void StaticListener<GameMessages::RemoveUnitPositionFromMap>::receive(Map& map, GameMessages::RemoveUnitPositionFromMap&& message)
+{
+	map.removeUnitPosition(std::move(message));
+}
+
 int Map::getIDOnUnitMap(glm::ivec2 position) const
 {
 	if (isWithinBounds(position))
@@ -145,22 +173,45 @@ int Map::getIDOnUnitMap(glm::ivec2 position) const
 	return Globals::INVALID_ENTITY_ID;
 }
 
+//Nodes covering every whole world position within the AABB
+bool Map::getGridRectangle(const AABB& AABB, glm::ivec2& minimum, glm::ivec2& maximum) const
+{
+	const glm::ivec2 start(static_cast<int>(AABB.getLeft()), static_cast<int>(AABB.getBack()));
+	const glm::ivec2 end(static_cast<int>(AABB.getRight()), static_cast<int>(AABB.getForward()));
+	if (start.x >= end.x || start.y >= end.y)
+	{
+		return false;
+	}
+
+	minimum = Globals::convertToGridPosition({ start.x, Globals::GROUND_HEIGHT, start.y });
+	maximum = Globals::convertToGridPosition({ end.x - 1, Globals::GROUND_HEIGHT, end.y - 1 });
+	return true;
+}
+
 void Map::editMap(const AABB& AABB, bool occupyAABB)
 {
-	for (int x = static_cast<int>(AABB.getLeft()); x < static_cast<int>(AABB.getRight()); ++x)
+	glm::ivec2 minimum;
+	glm::ivec2 maximum;
+	if (!getGridRectangle(AABB, minimum, maximum))
 	{
-		for (int y = static_cast<int>(AABB.getBack()); y < static_cast<int>(AABB.getForward()); ++y)
-		{
-			glm::ivec2 positionOnGrid = Globals::convertToGridPosition({ x, Globals::GROUND_HEIGHT, y });
-			assert(isWithinBounds(positionOnGrid));
-			if (isWithinBounds(positionOnGrid))
-			{
-				m_map[Globals::convertTo1D(positionOnGrid, m_size)] = occupyAABB;
-			}
-		}
+		return;
+	}
+
+	assert(isWithinBounds(minimum) && isWithinBounds(maximum));
+	minimum = glm::max(minimum, glm::ivec2(0));
+	maximum = glm::min(maximum, m_size - 1);
+	if (minimum.x <= maximum.x && minimum.y <= maximum.y)
+	{
+		m_occupancy.setRectangle(minimum, maximum, occupyAABB);
+		m_lineOfSightCache.clear();
 	}
 }
 
+void Map::setLineOfSightCaching(bool enabled)
+{
+	m_lineOfSightCache.setEnabled(enabled);
+}
+
 void Map::editUnitMap(const glm::vec3& position, int ID, bool occupy)
 {
 	assert(isWithinBounds(position));
@@ -2,19 +2,18 @@
 
 #include "Core/Globals.h"
 #include "Events/GameMessenger.h"
+#include "Events/GameMessages.h"
 #include "Scene/SceneryGameObject.h"
 #include "Core/Base.h"
+#include "Core/OccupancyGrid.h"
+#include "Core/LineOfSightCache.h"
 
-namespace GameMessages
-{
-	struct AddAABBToMap;
-	struct RemoveAABBFromMap;
-	struct AddUnitPositionToMap;
-	struct RemoveUnitPositionFromMap;
-}
 class AABB;
 class Map 
 {
+	friend struct StaticListener<GameMessages::AddUnitPositionToMap>;
+	friend struct StaticListener<GameMessages::RemoveUnitPositionFromMap>;
+
 public:
 	Map(const std::vector<SceneryGameObject>& sceneryGameObjects, const std::vector<Base>& bases, glm::ivec2 size);
 
@@ -24,21 +23,24 @@ public:
 	bool isWithinBounds(const glm::vec3& position) const;
 	bool isWithinBounds(const glm::ivec2& position) const;
 	bool isAABBOccupied(const AABB& AABB) const;
+	bool isLineOccupied(glm::ivec2 start, glm::ivec2 end) const;
 	bool isPositionOccupied(const glm::vec3& position) const;
 	bool isPositionOccupied(const glm::ivec2& position) const;
 	bool isPositionOnUnitMapAvailable(glm::ivec2 position, int senderID) const;
 
 	void editMap(const AABB& AABB, bool occupyAABB);
+	void setLineOfSightCaching(bool enabled);
 
 private:
 	glm::ivec2 m_size;
-	std::vector<bool> m_map;
+	OccupancyGrid m_occupancy;
+	mutable LineOfSightCache m_lineOfSightCache;
 	std::vector<int> m_unitMap;
 
 	BroadcasterSub<GameMessages::AddAABBToMap> m_addABBID;
 	BroadcasterSub<GameMessages::RemoveAABBFromMap> m_removeABBBFromMapID;
-	BroadcasterSub<GameMessages::AddUnitPositionToMap> m_addUnitPositionToMapID;
-	BroadcasterSub<GameMessages::RemoveUnitPositionFromMap> m_removeUnitPositionFromMapID;
+	StaticBroadcasterSub<GameMessages::AddUnitPositionToMap> m_addUnitPositionToMapID;
+	StaticBroadcasterSub<GameMessages::RemoveUnitPositionFromMap> m_removeUnitPositionFromMapID;
 
 	void addAABB(GameMessages::AddAABBToMap&& message);
 	void removeAABB(GameMessages::RemoveAABBFromMap&& message);
@@ -46,6 +48,7 @@ private:
 	void removeUnitPosition(GameMessages::RemoveUnitPositionFromMap&& message);
 
 	int getIDOnUnitMap(glm::ivec2 position) const;
+	bool getGridRectangle(const AABB& AABB, glm::ivec2& minimum, glm::ivec2& maximum) const;
 
 	void editUnitMap(const glm::vec3& position, int ID, bool occupy);
 };
\ No newline at end of file
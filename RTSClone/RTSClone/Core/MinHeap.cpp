@@ -1,7 +1,6 @@
 #include "MinHeap.h"
 #include "Core/Globals.h"
-#include "Events/GameMessages.h"
-#include "Events/GameMessenger.h"
+#include <algorithm>
 
 namespace 
 {
@@ -42,7 +41,8 @@ float MinHeapNode::getCost() const
 MinHeap::MinHeap()
 	: m_heap(),
 	m_indexes(),
-	m_onNewMapSizeID([this](const GameMessages::MapSize& gameMessage) { return onNewMapSize(gameMessage); })
+	m_mapSize(0, 0),
+	m_generation(1)
 {}
 
 bool MinHeap::isEmpty() const
@@ -52,97 +52,104 @@ bool MinHeap::isEmpty() const
 
 void MinHeap::add(const MinHeapNode& node)
 {
+	MinHeapIndex& index = getIndex(node.position);
+	assert(index.generation != m_generation);
+	index = { m_generation, m_heap.size() };
 	m_heap.push_back(node);
-	assert(m_indexes.find(m_heap.back().position) == m_indexes.cend());
-	m_indexes.emplace(node.position, m_heap.size() - 1);
-	sortNode(m_heap.size() - 1);
+	siftUp(m_heap.size() - 1);
 }
 
 MinHeapNode MinHeap::pop()
 {
 	assert(!isEmpty());
 	MinHeapNode node = m_heap.front();
-	findAndErase(node.position);
+	getIndex(node.position).generation = 0;
+	if (m_heap.size() > 1)
+	{
+		m_heap.front() = m_heap.back();
+		getIndex(m_heap.front().position).index = 0;
+		m_heap.pop_back();
+		siftDown(0);
+	}
+	else
+	{
+		m_heap.pop_back();
+	}
 
 	return node;
 }
 
-bool MinHeap::findAndErase(glm::ivec2 position)
+bool MinHeap::decreaseCost(glm::ivec2 position, glm::ivec2 cameFrom, float g)
 {
-	if (m_heap.size() > 1)
+	const MinHeapIndex& index = getIndex(position);
+	if (index.generation != m_generation)
 	{
-		assert(m_indexes.size() > 1);
-		auto iter = m_indexes.find(position);
-		if (iter != m_indexes.end())
-		{
-			size_t index = iter->second;
-			assert(index < m_heap.size() && iter->first == m_heap[index].position);
-			swap(index, m_heap.size() - 1);
-
-			iter = m_indexes.find(position);
-			assert(iter != m_indexes.end());
-			m_indexes.erase(iter);
-			m_heap.pop_back();
-
-			sortNode(index);
-			return true;
-		}
+		return false;
 	}
-	else if (m_heap.size() == 1)
-	{
-		assert(m_indexes.size() == 1);
-		if (m_heap[0].position == position)
-		{
-			m_indexes.clear();
-			m_heap.clear();
 
-			return true;
-		}
-	}
+	MinHeapNode& node = m_heap[index.index];
+	assert(node.position == position && g <= node.g);
+	node.cameFrom = cameFrom;
+	node.g = g;
+	siftUp(index.index);
 
-	return false;
+	return true;
 }
 
 void MinHeap::clear()
 {
 	m_heap.clear();
-	m_indexes.clear();
+	if (++m_generation == 0)
+	{
+		std::fill(m_indexes.begin(), m_indexes.end(), MinHeapIndex());
+		m_generation = 1;
+	}
+}
+
+void MinHeap::resize(glm::ivec2 mapSize)
+{
+	m_mapSize = mapSize;
+	m_heap.clear();
+	m_heap.reserve(static_cast<size_t>(m_mapSize.x) * static_cast<size_t>(m_mapSize.y));
+	m_indexes.assign(static_cast<size_t>(m_mapSize.x) * static_cast<size_t>(m_mapSize.y), MinHeapIndex());
+	m_generation = 1;
 }
 
-void MinHeap::sortNode(size_t i)
+MinHeapIndex& MinHeap::getIndex(glm::ivec2 position)
 {
-	if (i < m_heap.size() - 1)
+	assert(position.x >= 0 && position.x < m_mapSize.x && position.y >= 0 && position.y < m_mapSize.y);
+	return m_indexes[static_cast<size_t>(Globals::convertTo1D(position, m_mapSize))];
+}
+
+void MinHeap::siftUp(size_t i)
+{
+	size_t parentIndex = i;
+	while (getParentIndex(parentIndex) && m_heap[parentIndex].getCost() > m_heap[i].getCost())
 	{
-		while (getLeftChildIndex(i) < m_heap.size())
-		{
-			size_t smallestChildIndex = getLeftChildIndex(i);
-			if (getRightChildIndex(i) < m_heap.size() &&
-				m_heap[getRightChildIndex(i)].getCost() < m_heap[getLeftChildIndex(i)].getCost())
-			{
-				smallestChildIndex = getRightChildIndex(i);
-			}
-
-			if (m_heap[smallestChildIndex].getCost() < m_heap[i].getCost())
-			{
-				swap(smallestChildIndex, i);
-				i = smallestChildIndex;
-			}
-			else
-			{
-				break;
-			}
-		}
+		swap(parentIndex, i);
+		i = parentIndex;
 	}
-	else if (m_heap.size() >= 2 && i == m_heap.size() - 1)
+}
+
+void MinHeap::siftDown(size_t i)
+{
+	while (getLeftChildIndex(i) < m_heap.size())
 	{
-		size_t parentIndex = i;
-		while (getParentIndex(parentIndex))
+		size_t smallestChildIndex = getLeftChildIndex(i);
+		if (getRightChildIndex(i) < m_heap.size() &&
+			m_heap[getRightChildIndex(i)].getCost() < m_heap[getLeftChildIndex(i)].getCost())
 		{
-			if (m_heap[parentIndex].getCost() > m_heap[i].getCost())
-			{
-				swap(parentIndex, i);
-				i = parentIndex;
-			}
+			smallestChildIndex = getRightChildIndex(i);
+		}
+
+		if (m_heap[smallestChildIndex].getCost() < m_heap[i].getCost())
+		{
+			swap(smallestChildIndex, i);
+			i = smallestChildIndex;
+		}
+		else
+		{
+			break;
 		}
 	}
 }
@@ -151,18 +158,7 @@ void MinHeap::swap(size_t index1, size_t index2)
 {
 	assert(index1 < m_heap.size() && index2 < m_heap.size());
 
-	auto iter1 = m_indexes.find(m_heap[index1].position);
-	assert(iter1 != m_indexes.end() && iter1->second == index1);
-
-	auto iter2 = m_indexes.find(m_heap[index2].position);
-	assert(iter2 != m_indexes.end() && iter2->second == index2);
-
-	std::swap(iter1->second, iter2->second);
 	std::swap(m_heap[index2], m_heap[index1]);
-}
-
-void MinHeap::onNewMapSize(const GameMessages::MapSize& gameMessage)
-{
-	clear();
-	m_heap.resize(static_cast<size_t>(gameMessage.mapSize.x * gameMessage.mapSize.y), {});
-}
+	getIndex(m_heap[index1].position).index = index1;
+	getIndex(m_heap[index2].position).index = index2;
+}
\ No newline at end of file
@@ -3,9 +3,6 @@
 #pragma once
 
 #include "glm/glm.hpp"
-#include "glm/gtx/hash.hpp"
-#include "Events/GameMessenger.h"
-#include <unordered_map>
 #include <vector>
 
 struct MinHeapNode
@@ -21,10 +18,13 @@ struct MinHeapNode
 	float h{ 0.f };
 };
 
-namespace GameMessages
+//Position in the heap of the node at each map position - only valid when generation matches the heaps generation
+struct MinHeapIndex
 {
-	struct MapSize;
-}
+	unsigned int generation{ 0 };
+	size_t index{ 0 };
+};
+
 class MinHeap
 {
 public:
@@ -38,15 +38,18 @@ public:
 
 	void add(const MinHeapNode& node);
 	MinHeapNode pop();
-	bool findAndErase(glm::ivec2 position);
+	bool decreaseCost(glm::ivec2 position, glm::ivec2 cameFrom, float g);
 	void clear();
+	void resize(glm::ivec2 mapSize);
 
 private:
 	std::vector<MinHeapNode> m_heap;
-	std::unordered_map<glm::ivec2, size_t> m_indexes;
-	BroadcasterSub<GameMessages::MapSize> m_onNewMapSizeID;
+	std::vector<MinHeapIndex> m_indexes;
+	glm::ivec2 m_mapSize;
+	unsigned int m_generation;
 
-	void sortNode(size_t i);
+	MinHeapIndex& getIndex(glm::ivec2 position);
+	void siftUp(size_t i);
+	void siftDown(size_t i);
 	void swap(size_t index1, size_t index2);
-	void onNewMapSize(const GameMessages::MapSize& gameMessage);
 };
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "Core/MineralReservations.h"
+#include <assert.h>
+#include <utility>
+
+//MineralReservations
+MineralReservations::MineralReservations()
+	: m_reservations()
+{}
+
+bool MineralReservations::isReserved(const Mineral& mineral) const
+{
+	return m_reservations.find(&mineral) != m_reservations.cend();
+}
+
+void MineralReservations::reserve(const Mineral& mineral)
+{
+	++m_reservations[&mineral];
+}
+
+void MineralReservations::release(const Mineral& mineral)
+{
+	auto reservation = m_reservations.find(&mineral);
+	assert(reservation != m_reservations.end() && reservation->second > 0);
+	if (reservation != m_reservations.end() && --reservation->second <= 0)
+	{
+		m_reservations.erase(reservation);
+	}
+}
+
+//MineralReservation
+MineralReservation::MineralReservation(MineralReservations& mineralReservations)
+	: m_mineralReservations(&mineralReservations),
+	m_mineral(nullptr)
+{}
+
+MineralReservation::MineralReservation(MineralReservation&& rhs) noexcept
+	: m_mineralReservations(rhs.m_mineralReservations),
+	m_mineral(rhs.m_mineral)
+{
+	rhs.m_mineralReservations = nullptr;
+	rhs.m_mineral = nullptr;
+}
+
+MineralReservation& MineralReservation::operator=(MineralReservation&& rhs) noexcept
+{
+	std::swap(m_mineralReservations, rhs.m_mineralReservations);
+	std::swap(m_mineral, rhs.m_mineral);
+	return *this;
+}
+
+MineralReservation::~MineralReservation()
+{
+	set(nullptr);
+}
+
+const Mineral* MineralReservation::get() const
+{
+	return m_mineral;
+}
+
+//Reserves the new mineral before releasing the old so setting the same mineral again never drops it from the table
+void MineralReservation::set(const Mineral* mineral)
+{
+	assert(m_mineralReservations || !mineral);
+	if (m_mineralReservations && mineral)
+	{
+		m_mineralReservations->reserve(*mineral);
+	}
+	if (m_mineralReservations && m_mineral)
+	{
+		m_mineralReservations->release(*m_mineral);
+	}
+
+	m_mineral = mineral;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <unordered_map>
+
+//How many of a faction's workers are set on harvesting each mineral, in place of asking every worker.
+class Mineral;
+class MineralReservations
+{
+public:
+	MineralReservations();
+	MineralReservations(const MineralReservations&) = delete;
+	MineralReservations& operator=(const MineralReservations&) = delete;
+	MineralReservations(MineralReservations&&) = delete;
+	MineralReservations& operator=(MineralReservations&&) = delete;
+
+	bool isReserved(const Mineral& mineral) const;
+
+	void reserve(const Mineral& mineral);
+	void release(const Mineral& mineral);
+
+private:
+	std::unordered_map<const Mineral*, int> m_reservations;
+};
+
+//The mineral a worker is set on harvesting, released along with the worker - moving assigns swap,
+//mirroring MovementSlot.
+class MineralReservation
+{
+public:
+	MineralReservation() = default;
+	MineralReservation(MineralReservations& mineralReservations);
+	MineralReservation(const MineralReservation&) = delete;
+	MineralReservation& operator=(const MineralReservation&) = delete;
+	MineralReservation(MineralReservation&& rhs) noexcept;
+	MineralReservation& operator=(MineralReservation&& rhs) noexcept;
+	~MineralReservation();
+
+	const Mineral* get() const;
+
+	void set(const Mineral* mineral);
+
+private:
+	MineralReservations* m_mineralReservations	= nullptr;
+	const Mineral* m_mineral					= nullptr;
+};
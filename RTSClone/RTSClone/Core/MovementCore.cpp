@@ -0,0 +1,263 @@
+#include "Core/MovementCore.h"
+#include "Core/Globals.h"
+#include "Core/LocalAvoidance.h"
+#include "Core/Map.h"
+#include <assert.h>
+#include <utility>
+
+namespace
+{
+	bool isStepOccupied(const glm::vec3& position, const glm::vec3& nextPosition, const Map& map)
+	{
+		const glm::ivec2 node = Globals::convertToGridPosition(position);
+		const glm::ivec2 nextNode = Globals::convertToGridPosition(nextPosition);
+		return nextNode != node && (map.isPositionOccupied(nextNode) || map.isLineOccupied(node, nextNode));
+	}
+}
+
+//MovementCore
+MovementCore::MovementCore()
+	: m_positions(),
+	m_waypoints(),
+	m_velocities(),
+	m_steps(),
+	m_speeds(),
+	m_rotations(),
+	m_moving(),
+	m_avoiding(),
+	m_steered(),
+	m_blocked(),
+	m_freeSlots()
+{}
+
+const glm::vec3& MovementCore::getPosition(int slot) const
+{
+	assert(slot >= 0 && slot < static_cast<int>(m_positions.size()));
+	return m_positions[slot];
+}
+
+float MovementCore::getRotation(int slot) const
+{
+	assert(slot >= 0 && slot < static_cast<int>(m_rotations.size()));
+	return m_rotations[slot];
+}
+
+bool MovementCore::isMoving(int slot) const
+{
+	assert(slot >= 0 && slot < static_cast<int>(m_moving.size()));
+	return m_moving[slot];
+}
+
+const glm::vec3& MovementCore::getWaypoint(int slot) const
+{
+	assert(slot >= 0 && slot < static_cast<int>(m_waypoints.size()));
+	return m_waypoints[slot];
+}
+
+const glm::vec3& MovementCore::getVelocity(int slot) const
+{
+	assert(slot >= 0 && slot < static_cast<int>(m_velocities.size()));
+	return m_velocities[slot];
+}
+
+float MovementCore::getSpeed(int slot) const
+{
+	assert(slot >= 0 && slot < static_cast<int>(m_speeds.size()));
+	return m_speeds[slot];
+}
+
+bool MovementCore::isAvoiding(int slot) const
+{
+	assert(slot >= 0 && slot < static_cast<int>(m_avoiding.size()));
+	return m_avoiding[slot];
+}
+
+bool MovementCore::isBlocked(int slot) const
+{
+	assert(slot >= 0 && slot < static_cast<int>(m_blocked.size()));
+	return m_blocked[slot];
+}
+
+int MovementCore::getSlotCount() const
+{
+	return static_cast<int>(m_positions.size());
+}
+
+int MovementCore::add(const glm::vec3& position, float speed, bool avoiding)
+{
+	if (!m_freeSlots.empty())
+	{
+		const int slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+		m_positions[slot] = position;
+		m_waypoints[slot] = position;
+		m_velocities[slot] = glm::vec3(0.f);
+		m_steps[slot] = glm::vec3(0.f);
+		m_speeds[slot] = speed;
+		m_rotations[slot] = 0.f;
+		m_moving[slot] = false;
+		m_avoiding[slot] = avoiding;
+		m_steered[slot] = false;
+		m_blocked[slot] = false;
+		return slot;
+	}
+
+	m_positions.push_back(position);
+	m_waypoints.push_back(position);
+	m_velocities.push_back(glm::vec3(0.f));
+	m_steps.push_back(glm::vec3(0.f));
+	m_speeds.push_back(speed);
+	m_rotations.push_back(0.f);
+	m_moving.push_back(false);
+	m_avoiding.push_back(avoiding);
+	m_steered.push_back(false);
+	m_blocked.push_back(false);
+	return static_cast<int>(m_positions.size()) - 1;
+}
+
+void MovementCore::remove(int slot)
+{
+	assert(slot >= 0 && slot < static_cast<int>(m_moving.size()));
+	m_moving[slot] = false;
+	m_avoiding[slot] = false;
+	m_steered[slot] = false;
+	m_blocked[slot] = false;
+	m_velocities[slot] = glm::vec3(0.f);
+	m_freeSlots.push_back(slot);
+}
+
+//Paths are held back to front - the next waypoint is the back.
+//Heading only changes at waypoints so is worked out here rather than every tick
+void MovementCore::setPath(int slot, const glm::vec3& position, float rotation, const std::vector<glm::vec3>& path)
+{
+	assert(slot >= 0 && slot < static_cast<int>(m_moving.size()));
+	m_positions[slot] = position;
+	m_rotations[slot] = rotation;
+	m_moving[slot] = !path.empty();
+	m_steered[slot] = false;
+	m_blocked[slot] = false;
+	if (!path.empty())
+	{
+		m_waypoints[slot] = path.back();
+		if (path.back() != position)
+		{
+			m_rotations[slot] = Globals::getAngle(path.back(), position);
+		}
+	}
+}
+
+//Every avoiding slot picks its velocity from where every other one was at the start of the tick, so the order
+//slots and factions are steered in doesn't matter. Steered slots face the way they're going
+void MovementCore::avoid(const LocalAvoidance& localAvoidance, const Map& map, float deltaTime)
+{
+	for (int slot = 0; slot < static_cast<int>(m_positions.size()); ++slot)
+	{
+		if (m_moving[slot] && m_avoiding[slot])
+		{
+			glm::vec3 velocity(0.f);
+			m_steered[slot] = localAvoidance.getVelocity(*this, slot, map, deltaTime, velocity);
+			m_steps[slot] = velocity * deltaTime;
+			m_blocked[slot] = false;
+			if (!m_steered[slot] && isStepOccupied(m_positions[slot],
+				Globals::moveTowards(m_positions[slot], m_waypoints[slot], m_speeds[slot] * deltaTime), map))
+			{
+				const glm::vec3 middle = Globals::convertToWorldPosition(Globals::convertToGridPosition(m_positions[slot]));
+				m_steps[slot] = Globals::moveTowards(m_positions[slot], middle, m_speeds[slot] * deltaTime) - m_positions[slot];
+				m_steered[slot] = true;
+				m_blocked[slot] = m_positions[slot] == middle;
+			}
+			const glm::vec3 heading = m_steered[slot] ? m_positions[slot] + m_steps[slot] : m_waypoints[slot];
+			if (heading != m_positions[slot])
+			{
+				m_rotations[slot] = Globals::getAngle(heading, m_positions[slot]);
+			}
+		}
+	}
+}
+
+//Steered slots take the step they were given, the rest move straight on to their waypoint
+void MovementCore::integrate(float deltaTime)
+{
+	for (int slot = 0; slot < static_cast<int>(m_positions.size()); ++slot)
+	{
+		if (m_moving[slot])
+		{
+			const glm::vec3 position = m_positions[slot];
+			if (m_steered[slot])
+			{
+				m_positions[slot] += m_steps[slot];
+				m_steered[slot] = false;
+			}
+			else
+			{
+				m_positions[slot] = Globals::moveTowards(m_positions[slot], m_waypoints[slot], m_speeds[slot] * deltaTime);
+			}
+
+			m_velocities[slot] = deltaTime > 0.f ? (m_positions[slot] - position) / deltaTime : glm::vec3(0.f);
+		}
+		else
+		{
+			m_velocities[slot] = glm::vec3(0.f);
+		}
+	}
+}
+
+//MovementSlot
+MovementSlot::MovementSlot(MovementCore& movementCore, const glm::vec3& position, float speed, bool avoiding)
+	: m_movementCore(&movementCore),
+	m_slot(movementCore.add(position, speed, avoiding))
+{}
+
+MovementSlot::MovementSlot(MovementSlot&& rhs) noexcept
+	: m_movementCore(rhs.m_movementCore),
+	m_slot(rhs.m_slot)
+{
+	rhs.m_movementCore = nullptr;
+	rhs.m_slot = MovementCore::INVALID_SLOT;
+}
+
+MovementSlot& MovementSlot::operator=(MovementSlot&& rhs) noexcept
+{
+	std::swap(m_movementCore, rhs.m_movementCore);
+	std::swap(m_slot, rhs.m_slot);
+	return *this;
+}
+
+MovementSlot::~MovementSlot()
+{
+	if (m_movementCore)
+	{
+		m_movementCore->remove(m_slot);
+	}
+}
+
+const glm::vec3& MovementSlot::getPosition() const
+{
+	assert(m_movementCore);
+	return m_movementCore->getPosition(m_slot);
+}
+
+float MovementSlot::getRotation() const
+{
+	assert(m_movementCore);
+	return m_movementCore->getRotation(m_slot);
+}
+
+bool MovementSlot::isBlocked() const
+{
+	assert(m_movementCore);
+	return m_movementCore->isBlocked(m_slot);
+}
+
+bool MovementSlot::isMatchingPath(const std::vector<glm::vec3>& path) const
+{
+	assert(m_movementCore);
+	return path.empty() ? !m_movementCore->isMoving(m_slot) :
+		m_movementCore->isMoving(m_slot) && m_movementCore->getWaypoint(m_slot) == path.back();
+}
+
+void MovementSlot::setPath(const glm::vec3& position, float rotation, const std::vector<glm::vec3>& path)
+{
+	assert(m_movementCore);
+	m_movementCore->setPath(m_slot, position, rotation, path);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include <stdint.h>
+#include <vector>
+
+//Position, rotation and next waypoint of every moving entity a faction owns, held as parallel arrays so the
+//per tick movement pass walks contiguous memory rather than every Unit and Worker.
+//Entities keep their path and copy their position back after the pass - whenever their path changes
+//they have to set their slot again so the next pass moves them towards the new waypoint.
+//Slots are stable for as long as they're held.
+//Avoiding slots can be steered off the straight line to their waypoint for a tick by LocalAvoidance, and are seen
+//by it as neighbours whether moving or not. Waypoints are only known to be in sight from the middle of a node - an
+//avoiding slot that would cut through an occupied node heading straight on is steered back to the middle of its own,
+//and is blocked when it's already there, until it's given a new path.
+class LocalAvoidance;
+class Map;
+class MovementCore
+{
+public:
+	MovementCore();
+	MovementCore(const MovementCore&) = delete;
+	MovementCore& operator=(const MovementCore&) = delete;
+	MovementCore(MovementCore&&) = delete;
+	MovementCore& operator=(MovementCore&&) = delete;
+
+	static constexpr int INVALID_SLOT = -1;
+
+	const glm::vec3& getPosition(int slot) const;
+	float getRotation(int slot) const;
+	bool isMoving(int slot) const;
+	const glm::vec3& getWaypoint(int slot) const;
+	const glm::vec3& getVelocity(int slot) const;
+	float getSpeed(int slot) const;
+	bool isAvoiding(int slot) const;
+	bool isBlocked(int slot) const;
+	int getSlotCount() const;
+
+	int add(const glm::vec3& position, float speed, bool avoiding = false);
+	void remove(int slot);
+	void setPath(int slot, const glm::vec3& position, float rotation, const std::vector<glm::vec3>& path);
+	void avoid(const LocalAvoidance& localAvoidance, const Map& map, float deltaTime);
+	void integrate(float deltaTime);
+
+private:
+	std::vector<glm::vec3> m_positions;
+	std::vector<glm::vec3> m_waypoints;
+	std::vector<glm::vec3> m_velocities;
+	std::vector<glm::vec3> m_steps;
+	std::vector<float> m_speeds;
+	std::vector<float> m_rotations;
+	std::vector<uint8_t> m_moving;
+	std::vector<uint8_t> m_avoiding;
+	std::vector<uint8_t> m_steered;
+	std::vector<uint8_t> m_blocked;
+	std::vector<int> m_freeSlots;
+};
+
+//Owns a slot in a MovementCore, released along with the entity holding it - moving assigns swap slots,
+//mirroring UniqueID.
+class MovementSlot
+{
+public:
+	MovementSlot() = default;
+	MovementSlot(MovementCore& movementCore, const glm::vec3& position, float speed, bool avoiding = false);
+	MovementSlot(const MovementSlot&) = delete;
+	MovementSlot& operator=(const MovementSlot&) = delete;
+	MovementSlot(MovementSlot&& rhs) noexcept;
+	MovementSlot& operator=(MovementSlot&& rhs) noexcept;
+	~MovementSlot();
+
+	const glm::vec3& getPosition() const;
+	float getRotation() const;
+	bool isBlocked() const;
+	bool isMatchingPath(const std::vector<glm::vec3>& path) const;
+
+	void setPath(const glm::vec3& position, float rotation, const std::vector<glm::vec3>& path);
+
+private:
+	MovementCore* m_movementCore	= nullptr;
+	int m_slot						= MovementCore::INVALID_SLOT;
+};
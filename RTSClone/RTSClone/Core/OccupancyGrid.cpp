@@ -0,0 +1,162 @@
+#include "Core/OccupancyGrid.h"
+#include "Core/GridLine.h"
+#include <assert.h>
+
+namespace
+{
+	constexpr int WORD_BITS = 64;
+	constexpr uint64_t ALL_BITS = ~uint64_t(0);
+
+	uint64_t getFirstWordMask(int x)
+	{
+		return ALL_BITS << (x & (WORD_BITS - 1));
+	}
+
+	uint64_t getLastWordMask(int x)
+	{
+		return ALL_BITS >> (WORD_BITS - 1 - (x & (WORD_BITS - 1)));
+	}
+}
+
+OccupancyGrid::OccupancyGrid(glm::ivec2 size)
+	: m_size(size),
+	m_wordsPerRow((size.x + WORD_BITS - 1) / WORD_BITS),
+	m_words(static_cast<size_t>(m_wordsPerRow) * static_cast<size_t>(size.y), 0),
+	m_clearance(static_cast<size_t>(size.x) * static_cast<size_t>(size.y), 0)
+{
+	if (size.x > 0 && size.y > 0)
+	{
+		updateClearance({ 0, 0 }, size - 1);
+	}
+}
+
+bool OccupancyGrid::isOccupied(glm::ivec2 position) const
+{
+	assert(isWithinBounds(position));
+	return (m_words[static_cast<size_t>(position.y) * m_wordsPerRow + position.x / WORD_BITS] >> (position.x & (WORD_BITS - 1))) & 1;
+}
+
+int OccupancyGrid::getClearance(glm::ivec2 position) const
+{
+	assert(isWithinBounds(position));
+	return m_clearance[static_cast<size_t>(position.y) * m_size.x + position.x];
+}
+
+bool OccupancyGrid::isRectangleOccupied(glm::ivec2 minimum, glm::ivec2 maximum) const
+{
+	assert(isWithinBounds(minimum) && isWithinBounds(maximum) && minimum.x <= maximum.x && minimum.y <= maximum.y);
+	const glm::ivec2 size = maximum - minimum + 1;
+	const int clearance = getClearance(minimum);
+	if (clearance >= glm::max(size.x, size.y))
+	{
+		return false;
+	}
+	else if (clearance < MAX_CLEARANCE && clearance < glm::min(size.x, size.y))
+	{
+		return true;
+	}
+
+	const int firstWord = minimum.x / WORD_BITS;
+	const int lastWord = maximum.x / WORD_BITS;
+	const uint64_t firstMask = getFirstWordMask(minimum.x);
+	const uint64_t lastMask = getLastWordMask(maximum.x);
+	for (int y = minimum.y; y <= maximum.y; ++y)
+	{
+		const uint64_t* row = &m_words[static_cast<size_t>(y) * m_wordsPerRow];
+		if (firstWord == lastWord)
+		{
+			if (row[firstWord] & firstMask & lastMask)
+			{
+				return true;
+			}
+
+			continue;
+		}
+
+		uint64_t occupied = (row[firstWord] & firstMask) | (row[lastWord] & lastMask);
+		for (int word = firstWord + 1; word < lastWord; ++word)
+		{
+			occupied |= row[word];
+		}
+
+		if (occupied)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool OccupancyGrid::isLineOccupied(glm::ivec2 start, glm::ivec2 end) const
+{
+	assert(isWithinBounds(start) && isWithinBounds(end));
+	return GridLine::find(start, end, [this](glm::ivec2 position) { return isOccupied(position); });
+}
+
+void OccupancyGrid::set(glm::ivec2 position, bool occupied)
+{
+	assert(isWithinBounds(position));
+	uint64_t& word = m_words[static_cast<size_t>(position.y) * m_wordsPerRow + position.x / WORD_BITS];
+	const uint64_t bit = uint64_t(1) << (position.x & (WORD_BITS - 1));
+	word = occupied ? word | bit : word & ~bit;
+	updateClearance(position, position);
+}
+
+void OccupancyGrid::setRectangle(glm::ivec2 minimum, glm::ivec2 maximum, bool occupied)
+{
+	assert(isWithinBounds(minimum) && isWithinBounds(maximum) && minimum.x <= maximum.x && minimum.y <= maximum.y);
+	const int firstWord = minimum.x / WORD_BITS;
+	const int lastWord = maximum.x / WORD_BITS;
+	uint64_t firstMask = getFirstWordMask(minimum.x);
+	const uint64_t lastMask = getLastWordMask(maximum.x);
+	if (firstWord == lastWord)
+	{
+		firstMask &= lastMask;
+	}
+
+	for (int y = minimum.y; y <= maximum.y; ++y)
+	{
+		uint64_t* row = &m_words[static_cast<size_t>(y) * m_wordsPerRow];
+		for (int word = firstWord; word <= lastWord; ++word)
+		{
+			const uint64_t mask = word == firstWord ? firstMask : word == lastWord ? lastMask : ALL_BITS;
+			row[word] = occupied ? row[word] | mask : row[word] & ~mask;
+		}
+	}
+
+	updateClearance(minimum, maximum);
+}
+
+bool OccupancyGrid::isWithinBounds(glm::ivec2 position) const
+{
+	return position.x >= 0 &&
+		position.x < m_size.x &&
+		position.y >= 0 &&
+		position.y < m_size.y;
+}
+
+int OccupancyGrid::getClearanceOrZero(int x, int y) const
+{
+	return x < m_size.x && y < m_size.y ? m_clearance[static_cast<size_t>(y) * m_size.x + x] : 0;
+}
+
+//A node's clearance only depends on the nodes within MAX_CLEARANCE above it on both axes
+void OccupancyGrid::updateClearance(glm::ivec2 minimum, glm::ivec2 maximum)
+{
+	minimum = glm::max(minimum - (MAX_CLEARANCE - 1), glm::ivec2(0));
+	for (int y = maximum.y; y >= minimum.y; --y)
+	{
+		for (int x = maximum.x; x >= minimum.x; --x)
+		{
+			int clearance = 0;
+			if (!isOccupied({ x, y }))
+			{
+				clearance = glm::min(MAX_CLEARANCE, 1 + glm::min(getClearanceOrZero(x + 1, y),
+					glm::min(getClearanceOrZero(x, y + 1), getClearanceOrZero(x + 1, y + 1))));
+			}
+
+			m_clearance[static_cast<size_t>(y) * m_size.x + x] = static_cast<uint8_t>(clearance);
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include <stdint.h>
+#include <vector>
+
+//One bit per node, each row of the map packed into 64 bit words so rectangles are tested and edited
+//a word at a time rather than a node at a time.
+//Clearance is the side of the largest free square with its minimum corner on a node, capped at MAX_CLEARANCE -
+//kept up to date on every edit so most rectangle tests are answered from their minimum corner alone.
+//Rectangles are inclusive of both corners and have to be within bounds.
+//Lines are walked through GridLine - their starting node is never tested.
+constexpr int MAX_CLEARANCE = 15;
+class OccupancyGrid
+{
+public:
+	OccupancyGrid(glm::ivec2 size);
+
+	bool isOccupied(glm::ivec2 position) const;
+	int getClearance(glm::ivec2 position) const;
+	bool isRectangleOccupied(glm::ivec2 minimum, glm::ivec2 maximum) const;
+	bool isLineOccupied(glm::ivec2 start, glm::ivec2 end) const;
+
+	void set(glm::ivec2 position, bool occupied);
+	void setRectangle(glm::ivec2 minimum, glm::ivec2 maximum, bool occupied);
+
+private:
+	glm::ivec2 m_size;
+	int m_wordsPerRow;
+	std::vector<uint64_t> m_words;
+	std::vector<uint8_t> m_clearance;
+
+	bool isWithinBounds(glm::ivec2 position) const;
+	int getClearanceOrZero(int x, int y) const;
+	void updateClearance(glm::ivec2 minimum, glm::ivec2 maximum);
+};
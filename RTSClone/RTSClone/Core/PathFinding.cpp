@@ -1,6 +1,7 @@
 #include "Core/PathFinding.h"
 #include "Core/Globals.h"
 #include "Core/Map.h"
+#include "Core/GridLine.h"
 #include "Entities/Unit.h"
 #include "Entities/Worker.h"
 #include "Graphics/ModelManager.h"
@@ -10,33 +11,39 @@
 #include "Events/GameMessages.h"
 #include "Factions/FactionAI.h"
 #include "Core/Base.h"
+#include "Core/WorkerOccupancy.h"
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <queue>
 #include <random>
+#include <thread>
 
 namespace
 {
-	struct IsInLineOfSightObject
-	{
-		IsInLineOfSightObject(const glm::vec3& _startingPosition, const glm::vec3& _endingPosition)
-			: startingPosition(Globals::convertToMiddleGridPosition(Globals::convertToNodePosition(_startingPosition))),
-			endingPosition(Globals::convertToMiddleGridPosition(Globals::convertToNodePosition(_endingPosition))),
-			direction(glm::normalize(endingPosition - startingPosition)),
-			distance(glm::distance(endingPosition, startingPosition))
-		{}
-
-		IsInLineOfSightObject(glm::ivec2 startingPositionOnGrid, glm::ivec2 targetPositionOnGrid)
-			: startingPosition(Globals::convertToWorldPosition(startingPositionOnGrid)),
-			endingPosition(Globals::convertToWorldPosition(targetPositionOnGrid)),
-			direction(glm::normalize(endingPosition - startingPosition)),
-			distance(glm::distance(endingPosition, startingPosition))
-		{}
-
-		glm::vec3 startingPosition;
-		glm::vec3 endingPosition;
-		glm::vec3 direction;
-		float distance;
-	};
+	constexpr float HIERARCHICAL_PATH_MIN_DISTANCE = 24.0f;
+	constexpr float FLOW_FIELD_GOAL_RADIUS = 12.0f;
+	constexpr float FLOW_FIELD_LINE_OF_SIGHT_DISTANCE = 16.0f;
+	constexpr size_t BUILD_POSITION_CANDIDATES = 5;
+
+	//Walks the line until it's inside the target's AABB or on a node that blocks it
+	template <typename IsBlocking>
+	bool isTargetVisible(glm::ivec2 startingPositionOnGrid, glm::ivec2 targetPositionOnGrid, const Entity& targetEntity, IsBlocking isBlocking)
+	{
+		bool visible = true;
+		GridLine::find(startingPositionOnGrid, targetPositionOnGrid, [&targetEntity, &isBlocking, &visible](glm::ivec2 position)
+		{
+			if (targetEntity.getAABB().contains(Globals::convertToWorldPosition(position)))
+			{
+				return true;
+			}
+
+			visible = !isBlocking(position);
+			return !visible;
+		});
+
+		return visible;
+	}
 
 	bool isPathWithinSizeLimit(const std::vector<glm::vec3>& pathToPosition, const glm::ivec2& mapSize)
 	{
@@ -59,92 +66,99 @@ ThetaStarGraphNode::ThetaStarGraphNode()
 	: position(0, 0),
 	cameFrom(0, 0),
 	g(0.f),
-	h(0.f)
+	h(0.f),
+	searchID(0)
 {}
 
-ThetaStarGraphNode::ThetaStarGraphNode(glm::ivec2 position, glm::ivec2 cameFrom, float g, float h)
+ThetaStarGraphNode::ThetaStarGraphNode(glm::ivec2 position, glm::ivec2 cameFrom, float g, float h, unsigned int searchID)
 	: position(position),
 	cameFrom(cameFrom),
 	g(g),
-	h(h)
+	h(h),
+	searchID(searchID)
 {}
 
-float ThetaStarGraphNode::getF() const
+//PathSearch
+void PathSearch::resize(glm::ivec2 mapSize)
 {
-	return g + h;
+	thetaGraph.clear();
+	thetaGraph.resize(static_cast<size_t>(mapSize.x) * static_cast<size_t>(mapSize.y));
+	thetaSearchID = 0;
+	thetaFrontier.resize(mapSize);
 }
 
 //PathFinding
 PathFinding::PathFinding()
-	: m_onNewMapSizeID([this](GameMessages::MapSize&& gameMessage) { return onNewMapSize(std::move(gameMessage)); })
-{}
+	: m_hierarchicalPathing(true),
+	m_localAvoidance(true),
+	m_searches(),
+	m_threadPool(),
+	m_mapSize(0, 0),
+	m_onNewMapSizeID([this](GameMessages::MapSize&& gameMessage) { return onNewMapSize(std::move(gameMessage)); })
+{
+	m_searches.push_back(std::make_unique<PathSearch>());
+	setThreadCount(static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+}
 
-bool PathFinding::getClosestAvailablePosition(const Worker& worker, const std::vector<Worker>& workers, const Map& map, glm::vec3& outPosition)
+bool PathFinding::getClosestAvailablePosition(const Worker& worker, const WorkerOccupancy& workerOccupancy, const Map& map, glm::vec3& outPosition)
 {
 	m_bfsGraph.reset(Globals::convertToGridPosition(worker.getPosition()));
 	bool availablePositionFound = false;
-	int workerID = worker.getID();
-	auto workerCollision = [workerID, &workers](glm::ivec2 position) -> bool
-	{
-		auto worker = std::find_if(workers.cbegin(), workers.cend(), [workerID, position](auto& worker)
-		{
-			return worker.getID() != workerID && !worker.getAABB().contains(Globals::convertToWorldPosition(position));
-		});
-		return worker != workers.cend();
-	};
-
 	while (!availablePositionFound && !m_bfsGraph.is_frontier_empty())
 	{
 		glm::ivec2 position = m_bfsGraph.pop_frontier();
 		for (const auto& adjacentPosition : getAdjacentPositions(position, map))
 		{
-			if (adjacentPosition.valid && workerCollision(adjacentPosition.position))
+			//Visited positions were already found to be blocked or occupied
+			if (m_bfsGraph.is_position_visited(adjacentPosition.position, map))
+			{
+				continue;
+			}
+			else if (adjacentPosition.valid && !workerOccupancy.isPositionOccupied(adjacentPosition.position, worker.getID()))
 			{
 				outPosition = Globals::convertToWorldPosition(adjacentPosition.position);
 				availablePositionFound = true;
 				break;
 			}
-			else if (!m_bfsGraph.is_position_visited(adjacentPosition.position, map))
-			{
-				m_bfsGraph.add(adjacentPosition.position, position, map);
-			}
+
+			m_bfsGraph.add(adjacentPosition.position, position, map);
 		}
 	}
 
 	return availablePositionFound;
 }
 
+//One sweep gives the same candidates as a fresh sweep per candidate that skips the ones already found
 bool PathFinding::isBuildingSpawnAvailable(const glm::vec3& startingPosition, eEntityType buildingEntityType, const Map& map, 
-	glm::vec3& buildPosition, const FactionAI& owningFaction, const BaseHandler& baseHandler)
+	glm::vec3& buildPosition, const FactionAI& owningFaction)
 {
 	m_sharedContainer.clear();
 	AABB buildingAABB(startingPosition, ModelManager::getInstance().getModel(buildingEntityType));
-	for (int i = 0; i < 5; ++i)
+	m_bfsGraph.reset(Globals::convertToGridPosition(startingPosition));
+	while (!m_bfsGraph.is_frontier_empty() && m_sharedContainer.size() < BUILD_POSITION_CANDIDATES)
 	{
-		m_bfsGraph.reset(Globals::convertToGridPosition(startingPosition));
-		bool buildPositionFound = false;
-		while (!m_bfsGraph.is_frontier_empty() && !buildPositionFound)
+		glm::ivec2 position = m_bfsGraph.pop_frontier();
+		for (const auto& adjacentPosition : getAllAdjacentPositions(position, map))
 		{
-			glm::ivec2 position = m_bfsGraph.pop_frontier();
-			for (const auto& adjacentPosition : getAllAdjacentPositions(position, map))
+			if (adjacentPosition.valid)
 			{
-				if (adjacentPosition.valid)
+				const glm::vec3 adjacentWorldPosition = Globals::convertToWorldPosition(adjacentPosition.position);
+				buildingAABB.update(adjacentWorldPosition);
+				if (!owningFaction.isWithinRangeOfBuildings(adjacentPosition.position) &&
+					!owningFaction.isWithinRangeOfMinerals(adjacentPosition.position) &&
+					!map.isAABBOccupied(buildingAABB) &&
+					!isWithinBuildingPositionsRange(m_sharedContainer, adjacentWorldPosition))
 				{
-					buildingAABB.update(Globals::convertToWorldPosition(adjacentPosition.position));
-					if (!map.isAABBOccupied(buildingAABB) &&
-						!owningFaction.isWithinRangeOfBuildings(Globals::convertToWorldPosition(adjacentPosition.position), Globals::NODE_SIZE * 6.0f) && 
-						!baseHandler.isWithinRangeOfMinerals(Globals::convertToWorldPosition(adjacentPosition.position), Globals::NODE_SIZE * 8.0f) &&
-						!isWithinBuildingPositionsRange(m_sharedContainer, Globals::convertToWorldPosition(adjacentPosition.position)))
+					m_sharedContainer.emplace_back(adjacentWorldPosition);
+					if (m_sharedContainer.size() == BUILD_POSITION_CANDIDATES)
 					{
-						buildPositionFound = true;
-						m_sharedContainer.emplace_back(Globals::convertToWorldPosition(adjacentPosition.position));
 						break;
 					}
 				}
-				if (!m_bfsGraph.is_position_visited(adjacentPosition.position, map))
-				{
-					m_bfsGraph.add(adjacentPosition.position, position, map);
-				}
+			}
+			if (!m_bfsGraph.is_position_visited(adjacentPosition.position, map))
+			{
+				m_bfsGraph.add(adjacentPosition.position, position, map);
 			}
 		}
 	}
@@ -158,83 +172,62 @@ bool PathFinding::isBuildingSpawnAvailable(const glm::vec3& startingPosition, eE
 	return false;
 }
 
+//Every line of sight is first tested against the map's occupancy, which is cached and shared by every query -
+//only a line that's clear of it for a unit, or occupied for a target, has to be walked again
 bool PathFinding::isPositionInLineOfSight(glm::ivec2 startingPositionOnGrid, glm::ivec2 targetPositionOnGrid, const Map& map, const Entity& entity) const
 {
-	 IsInLineOfSightObject lineOfSightObject(startingPositionOnGrid, targetPositionOnGrid);
-	 for (int i = Globals::NODE_SIZE; i <= static_cast<int>(glm::ceil(lineOfSightObject.distance)); i += Globals::NODE_SIZE)
-	 {
-		 glm::vec3 position = lineOfSightObject.startingPosition+ lineOfSightObject.direction * static_cast<float>(i);
-		 if (map.isPositionOccupied(position) ||
-			 (entity.getEntityType() == eEntityType::Unit && !map.isPositionOnUnitMapAvailable(Globals::convertToGridPosition(position), entity.getID())))
-		 {
-			return false;
-		 }
-	 }
+	if (map.isLineOccupied(startingPositionOnGrid, targetPositionOnGrid))
+	{
+		return false;
+	}
+	else if (entity.getEntityType() == eEntityType::Unit && !m_localAvoidance)
+	{
+		const int ID = entity.getID();
+		return !GridLine::find(startingPositionOnGrid, targetPositionOnGrid, [&map, ID](glm::ivec2 position)
+		{
+			return !map.isPositionOnUnitMapAvailable(position, ID);
+		});
+	}
 
-	 return true;
+	return true;
 }
 
 bool PathFinding::isTargetInLineOfSight(const glm::vec3& startingPosition, const Entity& targetEntity, const Map& map) const
 {
-	IsInLineOfSightObject lineOfSightObject(startingPosition, targetEntity.getPosition());
-	bool targetEntityVisible = true;
-	for (int i = Globals::NODE_SIZE; i <= static_cast<int>(glm::ceil(lineOfSightObject.distance)); i += Globals::NODE_SIZE)
+	const glm::ivec2 startingPositionOnGrid = Globals::convertToGridPosition(startingPosition);
+	const glm::ivec2 targetPositionOnGrid = Globals::convertToGridPosition(targetEntity.getPosition());
+	return !map.isLineOccupied(startingPositionOnGrid, targetPositionOnGrid) ||
+		isTargetVisible(startingPositionOnGrid, targetPositionOnGrid, targetEntity, [&map](glm::ivec2 position)
 	{
-		glm::vec3 position = lineOfSightObject.startingPosition+ lineOfSightObject.direction * static_cast<float>(i);
-		if (targetEntity.getAABB().contains(position))
-		{
-			break;
-		}
-		else if (map.isPositionOccupied(position))
-		{
-			targetEntityVisible = false;
-			break;
-		}
-	}
-
-	return targetEntityVisible;
+		return map.isPositionOccupied(position);
+	});
 }
 
 bool PathFinding::isTargetInLineOfSight(const glm::vec3& startingPosition, const Entity& targetEntity, const Map& map, const AABB& senderAABB) const
 {
-	IsInLineOfSightObject lineOfSightObject(startingPosition, targetEntity.getPosition());
-	bool targetEntityVisible = true;
-	for (int i = Globals::NODE_SIZE; i <= static_cast<int>(glm::ceil(lineOfSightObject.distance)); i += Globals::NODE_SIZE)
+	const glm::ivec2 startingPositionOnGrid = Globals::convertToGridPosition(startingPosition);
+	const glm::ivec2 targetPositionOnGrid = Globals::convertToGridPosition(targetEntity.getPosition());
+	return !map.isLineOccupied(startingPositionOnGrid, targetPositionOnGrid) ||
+		isTargetVisible(startingPositionOnGrid, targetPositionOnGrid, targetEntity, [&map, &senderAABB](glm::ivec2 position)
 	{
-		glm::vec3 position = lineOfSightObject.startingPosition + lineOfSightObject.direction * static_cast<float>(i);
-		if (targetEntity.getAABB().contains(position))
-		{
-			break;
-		}
-		else if (!senderAABB.contains(position) && map.isPositionOccupied(position))
-		{
-			targetEntityVisible = false;
-			break;
-		}
-	}
-
-	return targetEntityVisible;
+		return !senderAABB.contains(Globals::convertToWorldPosition(position)) && map.isPositionOccupied(position);
+	});
 }
 
 bool PathFinding::isTargetInLineOfSight(const Unit& unit, const Entity& targetEntity, const Map& map) const
 {
-	IsInLineOfSightObject lineOfSightObject(unit.getPosition(), targetEntity.getPosition());
-	bool targetEntityVisible = true;
-	for (int i = Globals::NODE_SIZE; i <= static_cast<int>(glm::ceil(lineOfSightObject.distance)); i += Globals::NODE_SIZE)
+	const glm::ivec2 startingPositionOnGrid = Globals::convertToGridPosition(unit.getPosition());
+	const glm::ivec2 targetPositionOnGrid = Globals::convertToGridPosition(targetEntity.getPosition());
+	return !map.isLineOccupied(startingPositionOnGrid, targetPositionOnGrid) ||
+		isTargetVisible(startingPositionOnGrid, targetPositionOnGrid, targetEntity, [&map, &unit](glm::ivec2 position)
 	{
-		glm::vec3 position = lineOfSightObject.startingPosition + lineOfSightObject.direction * static_cast<float>(i);
-		if (targetEntity.getAABB().contains(position))
-		{
-			break;
-		}
-		else if (!map.isPositionOnUnitMapAvailable(Globals::convertToGridPosition(position), unit.getID()) && map.isPositionOccupied(position))
-		{
-			targetEntityVisible = false;
-			break;
-		}
-	}
+		return !map.isPositionOnUnitMapAvailable(position, unit.getID()) && map.isPositionOccupied(position);
+	});
+}
 
-	return targetEntityVisible;
+bool PathFinding::isLocalAvoidance() const
+{
+	return m_localAvoidance;
 }
 
 bool PathFinding::getClosestAvailableEntitySpawnPosition(const EntitySpawnerBuilding& building, const Map& map, glm::vec3& spawnPosition)
@@ -262,6 +255,33 @@ bool PathFinding::getClosestAvailableEntitySpawnPosition(const EntitySpawnerBuil
 	return availablePositionFound;
 }
 
+size_t PathFinding::getExpandedNodeCount() const
+{
+	size_t expandedNodeCount = 0;
+	for (const auto& search : m_searches)
+	{
+		expandedNodeCount += search->expandedNodeCount;
+	}
+
+	return expandedNodeCount;
+}
+
+size_t PathFinding::getPathCount() const
+{
+	size_t pathCount = 0;
+	for (const auto& search : m_searches)
+	{
+		pathCount += search->pathCount;
+	}
+
+	return pathCount;
+}
+
+int PathFinding::getThreadCount() const
+{
+	return m_threadPool.getThreadCount();
+}
+
 bool PathFinding::getRandomPositionOutsideAABB(const Entity& building, const Map& map, glm::vec3& positionOutsideAABB)
 {
 	m_bfsGraph.reset(Globals::convertToGridPosition(building.getPosition()));
@@ -318,45 +338,46 @@ bool PathFinding::setUnitAttackPosition(const Unit& unit, const Entity& targetEn
 
 	glm::ivec2 startingPositionOnGrid = Globals::convertToGridPosition(unit.getPosition());
 	glm::ivec2 destinationOnGrid = Globals::convertToGridPosition(targetEntity.getPosition());
-	std::fill(m_thetaGraph.begin(), m_thetaGraph.end(), ThetaStarGraphNode());
-	m_thetaFrontier.clear();
-	m_thetaFrontier.add({ startingPositionOnGrid, startingPositionOnGrid, 0.f, Globals::getDistance(destinationOnGrid, startingPositionOnGrid) });
+	PathSearch& search = *m_searches.front();
+	++search.pathCount;
+	beginThetaSearch(search);
+	search.thetaFrontier.clear();
+	search.thetaFrontier.add({ startingPositionOnGrid, startingPositionOnGrid, 0.f, Globals::getDistance(destinationOnGrid, startingPositionOnGrid) });
 	bool positionFound = false;
 
-	while (!positionFound && !m_thetaFrontier.isEmpty())
+	while (!positionFound && !search.thetaFrontier.isEmpty())
 	{
-		MinHeapNode currentNode = m_thetaFrontier.pop();
-		if (Globals::getSqrDistance(targetEntity.getPosition(), Globals::convertToWorldPosition(currentNode.position)) <=
+		MinHeapNode currentNode = search.thetaFrontier.pop();
+		const bool inRange = Globals::getSqrDistance(targetEntity.getPosition(), Globals::convertToWorldPosition(currentNode.position)) <=
 			unit.getAttackRange() * unit.getAttackRange() &&
-			isTargetInLineOfSight(unit, targetEntity, map))
+			isTargetInLineOfSight(unit, targetEntity, map);
+		if (inRange && currentNode.position == startingPositionOnGrid)
 		{
-			if (currentNode.position == startingPositionOnGrid)
+			if (map.isPositionOnUnitMapAvailable(startingPositionOnGrid, unit.getID()))
 			{
-				if (map.isPositionOnUnitMapAvailable(startingPositionOnGrid, unit.getID()))
+				positionFound = true;
+				if (Globals::convertToWorldPosition(currentNode.position) != unit.getPosition())
 				{
-					positionFound = true;
-					if (Globals::convertToWorldPosition(currentNode.position) != unit.getPosition())
-					{
-						pathToPosition.push_back(Globals::convertToWorldPosition(startingPositionOnGrid));
-					}
+					pathToPosition.push_back(Globals::convertToWorldPosition(startingPositionOnGrid));
 				}
 			}
-			else
+		}
+		//Searches that step over other units still can't end where one stands
+		else if (inRange && map.isPositionOnUnitMapAvailable(currentNode.position, unit.getID()))
+		{
+			positionFound = true;
+			glm::ivec2 position = currentNode.position;
+			while (position != startingPositionOnGrid)
 			{
-				positionFound = true;
-				glm::ivec2 position = currentNode.position;
-				while (position != startingPositionOnGrid)
-				{
-					pathToPosition.push_back(Globals::convertToWorldPosition(position));
-					position = m_thetaGraph[Globals::convertTo1D(position, map.getSize())].cameFrom;
+				pathToPosition.push_back(Globals::convertToWorldPosition(position));
+				position = getThetaNode(position, map, search).cameFrom;
 
-					assert(isPathWithinSizeLimit(pathToPosition, map.getSize()));
-				}
+				assert(isPathWithinSizeLimit(pathToPosition, map.getSize()));
 			}
 		}
 		else
 		{
-			expandFrontier(currentNode, map, destinationOnGrid, createAdjacentPositions(map, unit), unit);
+			expandFrontier(currentNode, map, destinationOnGrid, createAdjacentPositions(map, unit), unit, search);
 		}
 	}
 
@@ -365,6 +386,78 @@ bool PathFinding::setUnitAttackPosition(const Unit& unit, const Entity& targetEn
 
 void PathFinding::getPathToPosition(const Entity& entity, const glm::vec3& destination, std::vector<glm::vec3>& pathToPosition, 
 	const Map& map, AdjacentPositions adjacentPositions)
+{
+	if (m_hierarchicalPathing)
+	{
+		m_clusterGraph.update(map);
+	}
+	getPathToPosition(entity, destination, pathToPosition, map, adjacentPositions, *m_searches.front(), true);
+}
+
+//Threads stop taking queries once the ones already solved have reached the budget, and which those were depends on timing -
+//a query skipped that comes before the budget is reached in order is solved afterwards, so the result doesn't depend on the thread count
+size_t PathFinding::getPaths(std::vector<PathQuery>& queries, const Map& map, size_t expandedNodeBudget)
+{
+	if (m_hierarchicalPathing)
+	{
+		m_clusterGraph.update(map);
+	}
+
+	auto solve = [&map, this](PathQuery& query, PathSearch& search)
+	{
+		assert(query.entity);
+		const size_t startingExpandedNodeCount = search.expandedNodeCount;
+		getPathToPosition(*query.entity, query.destination, query.path, map, query.adjacentPositions, search, false);
+		query.expandedNodeCount = search.expandedNodeCount - startingExpandedNodeCount;
+		query.solved = true;
+	};
+
+	std::atomic<size_t> expandedNodeCount(0);
+	m_threadPool.run(queries.size(), [&queries, &solve, &expandedNodeCount, expandedNodeBudget, this](size_t queryIndex, int threadIndex)
+	{
+		PathQuery& query = queries[queryIndex];
+		query.solved = false;
+		if (expandedNodeCount.load(std::memory_order_relaxed) < expandedNodeBudget)
+		{
+			solve(query, *m_searches[threadIndex]);
+			expandedNodeCount.fetch_add(query.expandedNodeCount, std::memory_order_relaxed);
+		}
+	});
+
+	size_t solvedQueryCount = 0;
+	size_t solvedExpandedNodeCount = 0;
+	for (; solvedQueryCount < queries.size() && solvedExpandedNodeCount < expandedNodeBudget; ++solvedQueryCount)
+	{
+		PathQuery& query = queries[solvedQueryCount];
+		if (!query.solved)
+		{
+			solve(query, *m_searches.front());
+		}
+		solvedExpandedNodeCount += query.expandedNodeCount;
+	}
+
+	return solvedQueryCount;
+}
+
+//Shares the search threads with other per tick work, never while a search is running
+void PathFinding::runJobs(size_t jobCount, const PathJob& job)
+{
+	m_threadPool.run(jobCount, job);
+}
+
+void PathFinding::setThreadCount(int threadCount)
+{
+	assert(threadCount > 0);
+	m_threadPool.setThreadCount(threadCount);
+	while (static_cast<int>(m_searches.size()) < threadCount)
+	{
+		m_searches.push_back(std::make_unique<PathSearch>());
+		m_searches.back()->resize(m_mapSize);
+	}
+}
+
+void PathFinding::getPathToPosition(const Entity& entity, const glm::vec3& destination, std::vector<glm::vec3>& pathToPosition, 
+	const Map& map, const AdjacentPositions& adjacentPositions, PathSearch& search, bool flowField)
 {
 	glm::ivec2 destinationOnGrid = Globals::convertToGridPosition(destination);
 	pathToPosition.clear();
@@ -375,16 +468,63 @@ void PathFinding::getPathToPosition(const Entity& entity, const glm::vec3& desti
 		return;
 	}
 
+	//No search ever ends on a destination held by another unit
+	++search.pathCount;
+	if (entity.getEntityType() == eEntityType::Unit && !map.isPositionOnUnitMapAvailable(destinationOnGrid, entity.getID()))
+	{
+		return;
+	}
+
 	glm::ivec2 startingPositionOnGrid = Globals::convertToGridPosition(entity.getPosition());
+	if (!(flowField && getFlowFieldPath(entity, startingPositionOnGrid, destinationOnGrid, pathToPosition, map, adjacentPositions)) &&
+		!getHierarchicalPath(entity, startingPositionOnGrid, destinationOnGrid, pathToPosition, map, adjacentPositions, search))
+	{
+		getThetaStarPath(entity, startingPositionOnGrid, destinationOnGrid, pathToPosition, map, adjacentPositions, search);
+	}
+
+	if (entity.getEntityType() == eEntityType::Worker)
+	{
+		if (isPositionInLineOfSight(startingPositionOnGrid, destinationOnGrid, map, entity) && !pathToPosition.empty())
+		{
+			*pathToPosition.begin() = destination;
+		}
+	}
+}
+
+void PathFinding::setHierarchicalPathing(bool enabled)
+{
+	m_hierarchicalPathing = enabled;
+}
 
-	std::fill(m_thetaGraph.begin(), m_thetaGraph.end(), ThetaStarGraphNode());
-	m_thetaFrontier.clear();
-	m_thetaFrontier.add({ startingPositionOnGrid, startingPositionOnGrid, 0.f, Globals::getDistance(destinationOnGrid, startingPositionOnGrid) });
+void PathFinding::setLocalAvoidance(bool enabled)
+{
+	m_localAvoidance = enabled;
+}
+
+void PathFinding::buildClusterGraph(const Map& map)
+{
+	m_clusterGraph.update(map);
+}
+
+void PathFinding::setFlowFieldGoal(const glm::vec3& destination, const glm::vec3& groupPosition, const Map& map)
+{
+	if (map.isWithinBounds(destination))
+	{
+		m_flowField.setGoal(Globals::convertToGridPosition(destination), Globals::convertToGridPosition(groupPosition), map);
+	}
+}
+
+bool PathFinding::getThetaStarPath(const Entity& entity, glm::ivec2 startingPositionOnGrid, glm::ivec2 destinationOnGrid, 
+	std::vector<glm::vec3>& pathToPosition, const Map& map, const AdjacentPositions& adjacentPositions, PathSearch& search) const
+{
+	beginThetaSearch(search);
+	search.thetaFrontier.clear();
+	search.thetaFrontier.add({ startingPositionOnGrid, startingPositionOnGrid, 0.f, Globals::getDistance(destinationOnGrid, startingPositionOnGrid) });
 	bool destinationReached = false;
 
-	while (!destinationReached && !m_thetaFrontier.isEmpty())
+	while (!destinationReached && !search.thetaFrontier.isEmpty())
 	{
-		MinHeapNode currentNode = m_thetaFrontier.pop();
+		MinHeapNode currentNode = search.thetaFrontier.pop();
 		if (currentNode.position == destinationOnGrid)
 		{
 			if (currentNode.position == startingPositionOnGrid)
@@ -405,30 +545,142 @@ void PathFinding::getPathToPosition(const Entity& entity, const glm::vec3& desti
 				while (position != startingPositionOnGrid)
 				{
 					pathToPosition.push_back(Globals::convertToWorldPosition(position));
-					position = m_thetaGraph[Globals::convertTo1D(position, map.getSize())].cameFrom;
+					position = getThetaNode(position, map, search).cameFrom;
 
 					assert(isPathWithinSizeLimit(pathToPosition, map.getSize()));
 				}
 			}
+		}
+		else
+		{
+			expandFrontier(currentNode, map, destinationOnGrid, adjacentPositions, entity, search);
+		}
+	}
+
+	return destinationReached;
+}
+
+bool PathFinding::getFlowFieldPath(const Entity& entity, glm::ivec2 startingPositionOnGrid, glm::ivec2 destinationOnGrid, 
+	std::vector<glm::vec3>& pathToPosition, const Map& map, const AdjacentPositions& adjacentPositions)
+{
+	int distance = 0;
+	if (!m_flowField.isCovering(destinationOnGrid, FLOW_FIELD_GOAL_RADIUS, map) ||
+		map.isPositionOccupied(startingPositionOnGrid) ||
+		!m_flowField.getDistance(startingPositionOnGrid, map, distance))
+	{
+		return false;
+	}
 
-			if (entity.getEntityType() == eEntityType::Worker)
+	//Descend the field until the destination is in line of sight
+	m_flowFieldPath.clear();
+	glm::ivec2 position = startingPositionOnGrid;
+	while (position != destinationOnGrid && 
+		!(Globals::getDistance(destinationOnGrid, position) <= FLOW_FIELD_LINE_OF_SIGHT_DISTANCE &&
+		isPositionInLineOfSight(position, destinationOnGrid, map, entity)))
+	{
+		m_flowFieldPath.push_back(position);
+		bool nextPositionFound = false;
+		for (const auto& adjacentPosition : adjacentPositions(position))
+		{
+			int adjacentDistance = 0;
+			if (adjacentPosition.valid && m_flowField.getSettledDistance(adjacentPosition.position, map, adjacentDistance) &&
+				adjacentDistance < distance)
 			{
-				if (isPositionInLineOfSight(startingPositionOnGrid, destinationOnGrid, map, entity) && !pathToPosition.empty())
-				{
-					*pathToPosition.begin() = destination;
-				}
+				distance = adjacentDistance;
+				position = adjacentPosition.position;
+				nextPositionFound = true;
 			}
 		}
-		else
+
+		if (!nextPositionFound)
+		{
+			return false;
+		}
+	}
+	m_flowFieldPath.push_back(position);
+	if (position != destinationOnGrid)
+	{
+		m_flowFieldPath.push_back(destinationOnGrid);
+	}
+
+	//Only keep the positions where line of sight is lost - pathToPosition is stored in reverse
+	size_t waypointCount = 0;
+	glm::ivec2 lineOfSightPosition = startingPositionOnGrid;
+	for (size_t i = 1; i < m_flowFieldPath.size(); ++i)
+	{
+		if (!isPositionInLineOfSight(lineOfSightPosition, m_flowFieldPath[i], map, entity))
 		{
-			expandFrontier(currentNode, map, destinationOnGrid, adjacentPositions, entity);
+			lineOfSightPosition = m_flowFieldPath[i - 1];
+			if (i > 1)
+			{
+				m_flowFieldPath[waypointCount++] = lineOfSightPosition;
+			}
 		}
 	}
+
+	pathToPosition.push_back(Globals::convertToWorldPosition(destinationOnGrid));
+	for (size_t i = waypointCount; i > 0; --i)
+	{
+		pathToPosition.push_back(Globals::convertToWorldPosition(m_flowFieldPath[i - 1]));
+	}
+
+	return true;
 }
 
-void PathFinding::expandFrontier(const MinHeapNode& currentNode, const Map& map, glm::ivec2 destinationOnGrid, AdjacentPositions adjacentPositions,
-	const Entity& entity)
+bool PathFinding::getHierarchicalPath(const Entity& entity, glm::ivec2 startingPositionOnGrid, glm::ivec2 destinationOnGrid, 
+	std::vector<glm::vec3>& pathToPosition, const Map& map, const AdjacentPositions& adjacentPositions, PathSearch& search) const
 {
+	std::vector<glm::ivec2>& hierarchicalPath = search.hierarchicalPath;
+	if (!m_hierarchicalPathing ||
+		Globals::getDistance(destinationOnGrid, startingPositionOnGrid) < HIERARCHICAL_PATH_MIN_DISTANCE ||
+		!m_clusterGraph.getPath(startingPositionOnGrid, destinationOnGrid, map, search.clusterGraphSearch, hierarchicalPath))
+	{
+		return false;
+	}
+
+	hierarchicalPath.erase(std::unique(hierarchicalPath.begin(), hierarchicalPath.end()), hierarchicalPath.end());
+	if (hierarchicalPath.front() == startingPositionOnGrid)
+	{
+		hierarchicalPath.erase(hierarchicalPath.begin());
+	}
+
+	//Refine each segment between waypoints locally - segments are added from the destination backwards 
+	//as pathToPosition is stored in reverse
+	std::vector<size_t> waypointIndexes;
+	for (int i = static_cast<int>(hierarchicalPath.size()) - 1; i >= 0; --i)
+	{
+		glm::ivec2 segmentStart = i > 0 ? hierarchicalPath[i - 1] : startingPositionOnGrid;
+		if (!getThetaStarPath(entity, segmentStart, hierarchicalPath[i], pathToPosition, map, adjacentPositions, search))
+		{
+			pathToPosition.clear();
+			return false;
+		}
+
+		if (i > 0)
+		{
+			waypointIndexes.push_back(pathToPosition.size());
+		}
+	}
+
+	//Remove waypoints the entity can see past
+	for (auto waypointIndex = waypointIndexes.crbegin(); waypointIndex != waypointIndexes.crend(); ++waypointIndex)
+	{
+		assert(*waypointIndex > 0 && *waypointIndex < pathToPosition.size());
+		glm::ivec2 previousPosition = *waypointIndex + 1 < pathToPosition.size() ? 
+			Globals::convertToGridPosition(pathToPosition[*waypointIndex + 1]) : startingPositionOnGrid;
+		if (isPositionInLineOfSight(previousPosition, Globals::convertToGridPosition(pathToPosition[*waypointIndex - 1]), map, entity))
+		{
+			pathToPosition.erase(pathToPosition.begin() + *waypointIndex);
+		}
+	}
+
+	return true;
+}
+
+void PathFinding::expandFrontier(const MinHeapNode& currentNode, const Map& map, glm::ivec2 destinationOnGrid, const AdjacentPositions& adjacentPositions,
+	const Entity& entity, PathSearch& search) const
+{
+	++search.expandedNodeCount;
 	for (const auto& adjacentPosition : adjacentPositions(currentNode.position))
 	{
 		if (!adjacentPosition.valid)
@@ -436,14 +688,14 @@ void PathFinding::expandFrontier(const MinHeapNode& currentNode, const Map& map,
 			continue;
 		}
 
-		if (m_thetaGraph[Globals::convertTo1D(adjacentPosition.position, map.getSize())].getF() == 0.f)
+		if (!isThetaNodeVisited(adjacentPosition.position, map, search))
 		{
 			float costFromStart = 0.f;
 			float costFromEnd = Globals::getDistance(destinationOnGrid, adjacentPosition.position);
 			glm::ivec2 cameFrom(0, 0);
 			if (isPositionInLineOfSight(currentNode.cameFrom, adjacentPosition.position, map, entity))
 			{
-				const ThetaStarGraphNode& currentPositionGraphNode = m_thetaGraph[Globals::convertTo1D(currentNode.cameFrom, map.getSize())];
+				const ThetaStarGraphNode currentPositionGraphNode = getThetaNode(currentNode.cameFrom, map, search);
 				costFromStart = currentPositionGraphNode.g + Globals::getDistance(adjacentPosition.position, currentNode.cameFrom);
 				cameFrom = currentNode.cameFrom;
 			}
@@ -453,53 +705,68 @@ void PathFinding::expandFrontier(const MinHeapNode& currentNode, const Map& map,
 				cameFrom = currentNode.position;
 			}
 
-			m_thetaFrontier.add({ adjacentPosition.position, cameFrom, costFromStart, costFromEnd });
-			m_thetaGraph[Globals::convertTo1D(adjacentPosition.position, map.getSize())] =
-			{ adjacentPosition.position, cameFrom, costFromStart, costFromEnd };
+			search.thetaFrontier.add({ adjacentPosition.position, cameFrom, costFromStart, costFromEnd });
+			search.thetaGraph[Globals::convertTo1D(adjacentPosition.position, map.getSize())] =
+			{ adjacentPosition.position, cameFrom, costFromStart, costFromEnd, search.thetaSearchID };
 		}
 		else
 		{
-			ThetaStarGraphNode& adjacentGraphNode = m_thetaGraph[Globals::convertTo1D(adjacentPosition.position, map.getSize())];
+			ThetaStarGraphNode& adjacentGraphNode = search.thetaGraph[Globals::convertTo1D(adjacentPosition.position, map.getSize())];
 			float costFromStart = 0.f;
 			glm::ivec2 cameFrom(0, 0);
-			float cameFromG = 0.f;
 			if (isPositionInLineOfSight(currentNode.cameFrom, adjacentPosition.position, map, entity))
 			{
-				const ThetaStarGraphNode& camefromGraphNode = m_thetaGraph[Globals::convertTo1D(currentNode.cameFrom, map.getSize())];
-				costFromStart = camefromGraphNode.g + Globals::getDistance(adjacentPosition.position, camefromGraphNode.position);
-				cameFrom = camefromGraphNode.position;
-				cameFromG = camefromGraphNode.g;
+				//The starting node is never added to the graph so its position has to come from the current node
+				const ThetaStarGraphNode camefromGraphNode = getThetaNode(currentNode.cameFrom, map, search);
+				costFromStart = camefromGraphNode.g + Globals::getDistance(adjacentPosition.position, currentNode.cameFrom);
+				cameFrom = currentNode.cameFrom;
 			}
 			else
 			{
 				costFromStart = currentNode.g + Globals::getDistance(adjacentPosition.position, currentNode.position);
 				cameFrom = currentNode.position;
-				cameFromG = currentNode.g;
 			}
 
 			if (costFromStart < adjacentGraphNode.g)
 			{
 				adjacentGraphNode.g = costFromStart;
 				adjacentGraphNode.cameFrom = cameFrom;
-				if (m_thetaFrontier.findAndErase(adjacentPosition.position))
-				{
-					m_thetaFrontier.add({ adjacentPosition.position,
-					cameFrom,
-					cameFromG + Globals::getDistance(adjacentPosition.position, cameFrom),
-					adjacentGraphNode.h });
-				}
+				search.thetaFrontier.decreaseCost(adjacentPosition.position, cameFrom, costFromStart);
 			}
 		}
 	}
 }
 
+void PathFinding::beginThetaSearch(PathSearch& search) const
+{
+	++search.thetaSearchID;
+	if (search.thetaSearchID == 0)
+	{
+		std::fill(search.thetaGraph.begin(), search.thetaGraph.end(), ThetaStarGraphNode());
+		search.thetaSearchID = 1;
+	}
+}
+
+bool PathFinding::isThetaNodeVisited(glm::ivec2 position, const Map& map, const PathSearch& search) const
+{
+	return search.thetaGraph[Globals::convertTo1D(position, map.getSize())].searchID == search.thetaSearchID;
+}
+
+ThetaStarGraphNode PathFinding::getThetaNode(glm::ivec2 position, const Map& map, const PathSearch& search) const
+{
+	const ThetaStarGraphNode& node = search.thetaGraph[Globals::convertTo1D(position, map.getSize())];
+	return node.searchID == search.thetaSearchID ? node : ThetaStarGraphNode();
+}
+
 void PathFinding::onNewMapSize(GameMessages::MapSize&& gameMessage)
 {
 	m_sharedContainer.clear();
 	m_sharedContainer.reserve(
 		static_cast<size_t>(gameMessage.mapSize.x) * static_cast<size_t>(gameMessage.mapSize.y));
 
-	m_thetaGraph.clear();
-	m_thetaGraph.resize(
-		static_cast<size_t>(gameMessage.mapSize.x) * static_cast<size_t>(gameMessage.mapSize.y));
+	m_mapSize = gameMessage.mapSize;
+	for (auto& search : m_searches)
+	{
+		search->resize(m_mapSize);
+	}
 }
\ No newline at end of file
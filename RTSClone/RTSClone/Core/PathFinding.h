@@ -5,6 +5,9 @@
 #include "Entities/Unit.h"
 #include "Core/Map.h"
 #include "Core/Graph.h"
+#include "Core/ClusterGraph.h"
+#include "Core/FlowField.h"
+#include "Core/PathThreadPool.h"
 #include "Entities/Worker.h"
 #include "MinHeap.h"
 #include "Events/GameMessenger.h"
@@ -12,18 +15,44 @@
 #include <queue>
 #include <array>
 #include <functional>
+#include <limits>
+#include <memory>
 
 struct ThetaStarGraphNode
 {
 	ThetaStarGraphNode();
-	ThetaStarGraphNode(glm::ivec2 position, glm::ivec2 cameFrom, float g, float h);
-
-	float getF() const;                                                                                                                                                                                                                                                                                             
+	ThetaStarGraphNode(glm::ivec2 position, glm::ivec2 cameFrom, float g, float h, unsigned int searchID);
 
 	glm::ivec2 position;
 	glm::ivec2 cameFrom;
 	float g;
 	float h;
+	unsigned int searchID;
+};
+
+//Scratch state for one path search at a time - each thread solving paths has its own
+struct PathSearch
+{
+	std::vector<ThetaStarGraphNode> thetaGraph;
+	unsigned int thetaSearchID{ 0 };
+	MinHeap thetaFrontier;
+	ClusterGraphSearch clusterGraphSearch;
+	std::vector<glm::ivec2> hierarchicalPath;
+	size_t expandedNodeCount{ 0 };
+	size_t pathCount{ 0 };
+
+	void resize(glm::ivec2 mapSize);
+};
+
+//Path to be found off the main thread - the entity and map can't change until PathFinding::getPaths returns
+struct PathQuery
+{
+	const Entity* entity						= nullptr;
+	glm::vec3 destination						= {};
+	AdjacentPositions adjacentPositions			= {};
+	std::vector<glm::vec3> path					= {};
+	size_t expandedNodeCount					= 0;
+	bool solved									= false;
 };
 
 namespace GameMessages
@@ -36,8 +65,8 @@ class Worker;
 class Unit;
 class Map;
 class FactionAI;
-class BaseHandler;
 class EntitySpawnerBuilding;
+class WorkerOccupancy;
 class PathFinding 
 {
 public:
@@ -52,19 +81,24 @@ public:
 		return instance;
 	}
 
-	bool getClosestAvailablePosition(const Worker& worker, const std::vector<Worker>& workers, 
+	bool getClosestAvailablePosition(const Worker& worker, const WorkerOccupancy& workerOccupancy,
 		const Map& map, glm::vec3& position);
 
 	bool isBuildingSpawnAvailable(const glm::vec3& startingPosition, eEntityType buildingEntityType, const Map& map,
-		glm::vec3& buildPosition, const FactionAI& owningFaction, const BaseHandler& baseHandler);
+		glm::vec3& buildPosition, const FactionAI& owningFaction);
 
 	bool isPositionInLineOfSight(glm::ivec2 startingPositionOnGrid, glm::ivec2 targetPositionOnGrid, const Map& map, const Entity& entity) const;
 	bool isTargetInLineOfSight(const glm::vec3& startingPosition, const Entity& targetEntity, const Map& map) const;
 	bool isTargetInLineOfSight(const glm::vec3& startingPosition, const Entity& targetEntity, const Map& map, const AABB& senderAABB) const;
 	bool isTargetInLineOfSight(const Unit& unit, const Entity& targetEntity, const Map& map) const;
+	bool isLocalAvoidance() const;
 
 	bool getClosestAvailableEntitySpawnPosition(const EntitySpawnerBuilding& building, const Map& map, glm::vec3& position);
 
+	size_t getExpandedNodeCount() const;
+	size_t getPathCount() const;
+	int getThreadCount() const;
+
 	bool getRandomPositionOutsideAABB(const Entity& building, const Map& map, glm::vec3& positionOutsideAABB);
 
 	glm::vec3 getClosestPositionToAABB(const glm::vec3& entityPosition, const AABB& AABB, const Map& map);
@@ -75,16 +109,48 @@ public:
 	void getPathToPosition(const Entity& entity, const glm::vec3& destination, std::vector<glm::vec3>& pathToPosition,
 		const Map& map, AdjacentPositions adjacentPositions);
 
+	//Solves queries in parallel - queries are independent of each other and don't use the group flow field.
+	//Returns how many queries, in order, were solved before the nodes they expanded reached the budget -
+	//the same whatever the thread count. Queries after those may have been left unsolved
+	size_t getPaths(std::vector<PathQuery>& queries, const Map& map, size_t expandedNodeBudget = std::numeric_limits<size_t>::max());
+	void runJobs(size_t jobCount, const PathJob& job);
+
+	void setThreadCount(int threadCount);
+	void setHierarchicalPathing(bool enabled);
+	void setLocalAvoidance(bool enabled);
+	void buildClusterGraph(const Map& map);
+	void setFlowFieldGoal(const glm::vec3& destination, const glm::vec3& groupPosition, const Map& map);
+
 private:
 	PathFinding();
 	std::vector<glm::vec3> m_sharedContainer;
 	Graph m_bfsGraph;
-	//ThetaStar
-	std::vector<ThetaStarGraphNode> m_thetaGraph;
-	MinHeap m_thetaFrontier;
+	//Hierarchical
+	ClusterGraph m_clusterGraph;
+	bool m_hierarchicalPathing;
+	//Units steer round each other as they move rather than path round where each other stands
+	bool m_localAvoidance;
+	//Flow field - shared by group orders towards the same area
+	FlowField m_flowField;
+	std::vector<glm::ivec2> m_flowFieldPath;
+	//Search scratch for each thread - the first is the main thread's
+	std::vector<std::unique_ptr<PathSearch>> m_searches;
+	PathThreadPool m_threadPool;
+	glm::ivec2 m_mapSize;
 	BroadcasterSub<GameMessages::MapSize> m_onNewMapSizeID;
 
-	void expandFrontier(const MinHeapNode& currentNode, const Map& map, glm::ivec2 destinationOnGrid, AdjacentPositions adjacentPositions,
-		const Entity& entity);
+	void getPathToPosition(const Entity& entity, const glm::vec3& destination, std::vector<glm::vec3>& pathToPosition,
+		const Map& map, const AdjacentPositions& adjacentPositions, PathSearch& search, bool flowField);
+	void beginThetaSearch(PathSearch& search) const;
+	bool isThetaNodeVisited(glm::ivec2 position, const Map& map, const PathSearch& search) const;
+	ThetaStarGraphNode getThetaNode(glm::ivec2 position, const Map& map, const PathSearch& search) const;
+	bool getThetaStarPath(const Entity& entity, glm::ivec2 startingPositionOnGrid, glm::ivec2 destinationOnGrid,
+		std::vector<glm::vec3>& pathToPosition, const Map& map, const AdjacentPositions& adjacentPositions, PathSearch& search) const;
+	bool getFlowFieldPath(const Entity& entity, glm::ivec2 startingPositionOnGrid, glm::ivec2 destinationOnGrid,
+		std::vector<glm::vec3>& pathToPosition, const Map& map, const AdjacentPositions& adjacentPositions);
+	bool getHierarchicalPath(const Entity& entity, glm::ivec2 startingPositionOnGrid, glm::ivec2 destinationOnGrid,
+		std::vector<glm::vec3>& pathToPosition, const Map& map, const AdjacentPositions& adjacentPositions, PathSearch& search) const;
+	void expandFrontier(const MinHeapNode& currentNode, const Map& map, glm::ivec2 destinationOnGrid, const AdjacentPositions& adjacentPositions,
+		const Entity& entity, PathSearch& search) const;
 	void onNewMapSize(GameMessages::MapSize&& gameMessage);
 };
\ No newline at end of file
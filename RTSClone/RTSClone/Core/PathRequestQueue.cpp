@@ -0,0 +1,105 @@
+#include "Core/PathRequestQueue.h"
+#include "Core/PathFinding.h"
+#include "Factions/FactionHandler.h"
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+	constexpr int DEFAULT_EXPANDED_NODE_BUDGET = 8000;
+	constexpr size_t BATCH_SIZE = 32;
+}
+
+PathRequestQueue::PathRequestQueue()
+	: m_expandedNodeBudget(DEFAULT_EXPANDED_NODE_BUDGET)
+{}
+
+const PathRequestStats& PathRequestQueue::getStats() const
+{
+	return m_stats;
+}
+
+bool PathRequestQueue::isPending(int entityID) const
+{
+	return m_pendingEntityIDs.find(entityID) != m_pendingEntityIDs.cend();
+}
+
+void PathRequestQueue::setBudget(int expandedNodes, int microseconds)
+{
+	assert(expandedNodes > 0 && microseconds >= 0);
+	m_expandedNodeBudget = expandedNodes;
+	m_microsecondBudget = microseconds;
+}
+
+void PathRequestQueue::add(eFactionController factionController, int entityID)
+{
+	if (m_pendingEntityIDs.insert(entityID).second)
+	{
+		m_requests.push_back({ factionController, entityID, m_tick });
+	}
+}
+
+void PathRequestQueue::update(FactionHandler& factionHandler, const Map& map)
+{
+	m_stats = {};
+	const auto start = std::chrono::steady_clock::now();
+	auto isWithinBudget = [&]()
+	{
+		return m_stats.expandedNodes < m_expandedNodeBudget &&
+			(m_microsecondBudget == 0 ||
+			std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() < m_microsecondBudget);
+	};
+	auto finish = [this](const PathRequest& request)
+	{
+		m_pendingEntityIDs.erase(request.entityID);
+		++m_stats.processed;
+		m_stats.maxLatency = std::max(m_stats.maxLatency, m_tick - request.tick);
+		m_stats.totalLatency += m_tick - request.tick;
+	};
+
+	while (!m_requests.empty() && isWithinBudget())
+	{
+		m_batch.clear();
+		m_queries.clear();
+		while (!m_requests.empty() && m_batch.size() < BATCH_SIZE)
+		{
+			const PathRequest request = m_requests.front();
+			m_requests.pop_front();
+
+			const Faction* faction = factionHandler.getFaction(request.factionController);
+			PathQuery query;
+			if (faction && faction->get_movement_path_query(request.entityID, map, query))
+			{
+				m_batch.push_back(request);
+				m_queries.push_back(std::move(query));
+			}
+			else
+			{
+				finish(request);
+			}
+		}
+
+		const size_t solvedQueryCount = PathFinding::getInstance().getPaths(m_queries, map,
+			static_cast<size_t>(m_expandedNodeBudget - m_stats.expandedNodes));
+		//Counts what was solved in applying them too but not what was solved past the budget
+		for (size_t i = 0; i < solvedQueryCount; ++i)
+		{
+			finish(m_batch[i]);
+			const size_t startingExpandedNodeCount = PathFinding::getInstance().getExpandedNodeCount();
+			if (Faction* faction = factionHandler.getFaction(m_batch[i].factionController))
+			{
+				faction->revalidate_movement_path(m_batch[i].entityID, map, m_queries[i].path);
+			}
+			m_stats.expandedNodes += static_cast<int>(m_queries[i].expandedNodeCount +
+				PathFinding::getInstance().getExpandedNodeCount() - startingExpandedNodeCount);
+		}
+
+		for (size_t i = m_batch.size(); i > solvedQueryCount; --i)
+		{
+			m_requests.push_front(m_batch[i - 1]);
+		}
+	}
+
+	m_stats.queueSize = m_requests.size();
+	++m_tick;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Core/FactionController.h"
+#include "Core/PathFinding.h"
+#include <deque>
+#include <unordered_set>
+#include <vector>
+
+//Movement path revalidations are queued rather than run inside the event that caused them,
+//entities keep following their current path until their request is reached. Orders given to entities and AI building
+//placement still find their paths as they're made - they act on them that tick.
+//The budget is counted in expanded path finding nodes so the simulation stays deterministic -
+//a time budget can be added on top but then the order paths are found in depends on the machine.
+//Requests are solved in fixed size batches across the path finding threads and applied back in the order they were added,
+//so the result doesn't depend on the thread count. Requests of a batch solved past the budget go back to the front of the queue.
+struct PathRequest
+{
+	eFactionController factionController	= eFactionController::None;
+	int entityID							= 0;
+	int tick								= 0;
+};
+
+//Latency is in ticks between a request being added and its path being found
+struct PathRequestStats
+{
+	size_t queueSize	= 0;
+	int processed		= 0;
+	int expandedNodes	= 0;
+	int maxLatency		= 0;
+	int totalLatency	= 0;
+};
+
+class Map;
+class FactionHandler;
+class PathRequestQueue
+{
+public:
+	PathRequestQueue();
+
+	const PathRequestStats& getStats() const;
+	bool isPending(int entityID) const;
+
+	void setBudget(int expandedNodes, int microseconds);
+	void add(eFactionController factionController, int entityID);
+	void update(FactionHandler& factionHandler, const Map& map);
+
+private:
+	std::deque<PathRequest> m_requests				= {};
+	std::unordered_set<int> m_pendingEntityIDs		= {};
+	std::vector<PathRequest> m_batch				= {};
+	std::vector<PathQuery> m_queries				= {};
+	PathRequestStats m_stats						= {};
+	int m_expandedNodeBudget						= 0;
+	int m_microsecondBudget							= 0;
+	int m_tick										= 0;
+};
@@ -0,0 +1,145 @@
+#include "Core/PathSegmentIndex.h"
+#include "Core/AABB.h"
+#include "Core/Globals.h"
+#include "Core/PathRequestQueue.h"
+#include "Events/GameMessages.h"
+#include "Factions/FactionHandler.h"
+#include <algorithm>
+#include <assert.h>
+
+namespace
+{
+	constexpr int CELL_SIZE = 8;
+
+	bool isIntersecting(const glm::vec3& position, const std::vector<glm::vec3>& path, const AABB& aabb)
+	{
+		glm::vec3 start = position;
+		for (auto waypoint = path.crbegin(); waypoint != path.crend(); ++waypoint)
+		{
+			if (aabb.intersects(start, *waypoint))
+			{
+				return true;
+			}
+
+			start = *waypoint;
+		}
+
+		return false;
+	}
+}
+
+PathSegmentIndex::PathSegmentIndex(glm::ivec2 mapSize)
+	: m_size((mapSize + CELL_SIZE - 1) / CELL_SIZE),
+	m_cells(static_cast<size_t>(m_size.x) * static_cast<size_t>(m_size.y)),
+	m_entries(),
+	m_candidates(),
+	m_onSetMovementPathID(*this)
+{}
+
+size_t PathSegmentIndex::getEntityCount() const
+{
+	return m_entries.size();
+}
+
+void PathSegmentIndex::addPathRequests(const AABB& aabb, const FactionHandler& factionHandler, PathRequestQueue& pathRequests)
+{
+	//Nodes partly covered by the AABB become occupied
+	const AABB expandedAABB(aabb.getLeft() - Globals::NODE_SIZE, aabb.getRight() + Globals::NODE_SIZE,
+		aabb.getForward() + Globals::NODE_SIZE, aabb.getBack() - Globals::NODE_SIZE);
+	const glm::ivec2 minimum = getCellPosition({ expandedAABB.getLeft(), 0.f, expandedAABB.getBack() });
+	const glm::ivec2 maximum = getCellPosition({ expandedAABB.getRight(), 0.f, expandedAABB.getForward() });
+
+	m_candidates.clear();
+	for (int x = minimum.x; x <= maximum.x; ++x)
+	{
+		for (int y = minimum.y; y <= maximum.y; ++y)
+		{
+			const auto& cell = m_cells[static_cast<size_t>(x) * m_size.y + y];
+			m_candidates.insert(m_candidates.end(), cell.cbegin(), cell.cend());
+		}
+	}
+
+	std::sort(m_candidates.begin(), m_candidates.end());
+	m_candidates.erase(std::unique(m_candidates.begin(), m_candidates.end()), m_candidates.end());
+	for (int entityID : m_candidates)
+	{
+		const auto entry = m_entries.find(entityID);
+		assert(entry != m_entries.cend());
+		const eFactionController factionController = entry->second.factionController;
+		const Faction* faction = factionHandler.getFaction(factionController);
+		assert(faction);
+		const std::vector<glm::vec3>* path = faction->get_movement_path(entityID);
+		//Arrived this tick - removed once its state changes
+		if (path && !path->empty() && isIntersecting(faction->get_entity(entityID)->getPosition(), *path, expandedAABB))
+		{
+			pathRequests.add(factionController, entityID);
+		}
+	}
+}
+
+glm::ivec2 PathSegmentIndex::getCellPosition(const glm::vec3& position) const
+{
+	return glm::clamp(glm::ivec2(glm::floor(glm::vec2(position.x, position.z) / static_cast<float>(Globals::NODE_SIZE * CELL_SIZE))),
+		glm::ivec2(0), m_size - 1);
+}
+
+void PathSegmentIndex::addSegment(const glm::vec3& start, const glm::vec3& end, PathSegmentEntry& entry, int entityID)
+{
+	const glm::ivec2 minimum = getCellPosition(glm::min(start, end));
+	const glm::ivec2 maximum = getCellPosition(glm::max(start, end));
+	for (int x = minimum.x; x <= maximum.x; ++x)
+	{
+		for (int y = minimum.y; y <= maximum.y; ++y)
+		{
+			const int cellIndex = x * m_size.y + y;
+			if (std::find(entry.cells.cbegin(), entry.cells.cend(), cellIndex) == entry.cells.cend())
+			{
+				entry.cells.push_back(cellIndex);
+				m_cells[cellIndex].push_back(entityID);
+			}
+		}
+	}
+}
+
+void PathSegmentIndex::remove(int entityID)
+{
+	const auto entry = m_entries.find(entityID);
+	if (entry == m_entries.end())
+	{
+		return;
+	}
+
+	for (int cellIndex : entry->second.cells)
+	{
+		auto& cell = m_cells[cellIndex];
+		const auto ID = std::find(cell.begin(), cell.end(), entityID);
+		assert(ID != cell.end());
+		*ID = cell.back();
+		cell.pop_back();
+	}
+
+	m_entries.erase(entry);
+}
+
+void StaticListener<GameMessages::SetMovementPath>::receive(PathSegmentIndex& pathSegmentIndex, GameMessages::SetMovementPath&& message)
+{
+	pathSegmentIndex.setMovementPath(message);
+}
+
+void PathSegmentIndex::setMovementPath(const GameMessages::SetMovementPath& gameMessage)
+{
+	remove(gameMessage.ID);
+	if (gameMessage.path.empty())
+	{
+		return;
+	}
+
+	PathSegmentEntry& entry = m_entries[gameMessage.ID];
+	entry.factionController = gameMessage.factionController;
+	glm::vec3 start = gameMessage.position;
+	for (auto waypoint = gameMessage.path.crbegin(); waypoint != gameMessage.path.crend(); ++waypoint)
+	{
+		addSegment(start, *waypoint, entry, gameMessage.ID);
+		start = *waypoint;
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Core/FactionController.h"
+#include "Events/GameMessenger.h"
+#include "Events/GameMessages.h"
+#include "glm/glm.hpp"
+#include <unordered_map>
+#include <vector>
+
+//Coarse grid of the cells each moving entity's path passes over, so a map edit only revalidates
+//the paths running through it rather than every path on the map.
+//Cells are filled from the bounds of each path segment when a path is set, the remaining path only ever shrinks
+//so entries stay a superset - an entity's entry is removed as soon as its path is cleared or it's destroyed.
+struct PathSegmentEntry
+{
+	eFactionController factionController	= eFactionController::None;
+	std::vector<int> cells					= {};
+};
+
+class AABB;
+class FactionHandler;
+class PathRequestQueue;
+class PathSegmentIndex
+{
+	friend struct StaticListener<GameMessages::SetMovementPath>;
+
+public:
+	PathSegmentIndex(glm::ivec2 mapSize);
+
+	size_t getEntityCount() const;
+
+	void addPathRequests(const AABB& aabb, const FactionHandler& factionHandler, PathRequestQueue& pathRequests);
+
+private:
+	glm::ivec2 m_size;
+	std::vector<std::vector<int>> m_cells;
+	std::unordered_map<int, PathSegmentEntry> m_entries;
+	std::vector<int> m_candidates;
+	StaticBroadcasterSub<GameMessages::SetMovementPath> m_onSetMovementPathID;
+
+	glm::ivec2 getCellPosition(const glm::vec3& position) const;
+	void addSegment(const glm::vec3& start, const glm::vec3& end, PathSegmentEntry& entry, int entityID);
+	void remove(int entityID);
+	void setMovementPath(const GameMessages::SetMovementPath& gameMessage);
+};
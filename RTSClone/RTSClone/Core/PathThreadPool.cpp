@@ -0,0 +1,113 @@
+#include "Core/PathThreadPool.h"
+#include <assert.h>
+
+PathThreadPool::PathThreadPool()
+{}
+
+PathThreadPool::~PathThreadPool()
+{
+	stop();
+}
+
+int PathThreadPool::getThreadCount() const
+{
+	return static_cast<int>(m_threads.size()) + 1;
+}
+
+void PathThreadPool::setThreadCount(int threadCount)
+{
+	assert(threadCount > 0 && !m_job);
+	if (threadCount == getThreadCount())
+	{
+		return;
+	}
+
+	stop();
+	for (int threadIndex = 1; threadIndex < threadCount; ++threadIndex)
+	{
+		m_threads.emplace_back(&PathThreadPool::work, this, threadIndex);
+	}
+}
+
+void PathThreadPool::run(size_t jobCount, const PathJob& job)
+{
+	if (m_threads.empty() || jobCount <= 1)
+	{
+		for (size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex)
+		{
+			job(jobIndex, 0);
+		}
+
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_job = &job;
+	m_jobCount = jobCount;
+	m_nextJob = 0;
+	m_completedJobs = 0;
+	++m_generation;
+	m_jobsAdded.notify_all();
+
+	while (runNextJob(0, lock))
+	{}
+	m_jobsDone.wait(lock, [this]() { return m_completedJobs == m_jobCount; });
+
+	m_job = nullptr;
+	m_jobCount = 0;
+	m_nextJob = 0;
+}
+
+bool PathThreadPool::runNextJob(int threadIndex, std::unique_lock<std::mutex>& lock)
+{
+	if (m_nextJob == m_jobCount)
+	{
+		return false;
+	}
+
+	const size_t jobIndex = m_nextJob++;
+	lock.unlock();
+	(*m_job)(jobIndex, threadIndex);
+	lock.lock();
+
+	if (++m_completedJobs == m_jobCount)
+	{
+		m_jobsDone.notify_one();
+	}
+
+	return true;
+}
+
+void PathThreadPool::work(int threadIndex)
+{
+	unsigned int generation = 0;
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_jobsAdded.wait(lock, [this, generation]() { return m_stopping || m_generation != generation; });
+		if (m_stopping)
+		{
+			return;
+		}
+
+		generation = m_generation;
+		while (runNextJob(threadIndex, lock))
+		{}
+	}
+}
+
+void PathThreadPool::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_jobsAdded.notify_all();
+
+	for (auto& thread : m_threads)
+	{
+		thread.join();
+	}
+	m_threads.clear();
+	m_stopping = false;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Runs a job for each index in [0, jobCount) across the calling thread and the pool's threads, returning once every job is done.
+//Jobs can finish in any order - the thread index given to a job is in [0, getThreadCount()) so it can own scratch state,
+//with 0 being the calling thread
+using PathJob = std::function<void(size_t jobIndex, int threadIndex)>;
+class PathThreadPool
+{
+public:
+	PathThreadPool();
+	PathThreadPool(const PathThreadPool&) = delete;
+	PathThreadPool& operator=(const PathThreadPool&) = delete;
+	PathThreadPool(PathThreadPool&&) = delete;
+	PathThreadPool& operator=(PathThreadPool&&) = delete;
+	~PathThreadPool();
+
+	int getThreadCount() const;
+
+	void setThreadCount(int threadCount);
+	void run(size_t jobCount, const PathJob& job);
+
+private:
+	std::vector<std::thread> m_threads		= {};
+	std::mutex m_mutex						= {};
+	std::condition_variable m_jobsAdded		= {};
+	std::condition_variable m_jobsDone		= {};
+	const PathJob* m_job					= nullptr;
+	size_t m_jobCount						= 0;
+	size_t m_nextJob						= 0;
+	size_t m_completedJobs					= 0;
+	unsigned int m_generation				= 0;
+	bool m_stopping							= false;
+
+	bool runNextJob(int threadIndex, std::unique_lock<std::mutex>& lock);
+	void work(int threadIndex);
+	void stop();
+};
@@ -0,0 +1,45 @@
+#include "Core/ProximityField.h"
+#include "Core/Globals.h"
+#include <assert.h>
+
+ProximityField::ProximityField(glm::ivec2 size, float distance)
+	: m_size(size),
+	m_distance(distance),
+	m_sourceCounts(static_cast<size_t>(size.x) * static_cast<size_t>(size.y), 0)
+{}
+
+bool ProximityField::isWithinRange(glm::ivec2 position) const
+{
+	assert(position.x >= 0 && position.x < m_size.x && position.y >= 0 && position.y < m_size.y);
+	return m_sourceCounts[static_cast<size_t>(position.y) * m_size.x + position.x] > 0;
+}
+
+void ProximityField::add(const glm::vec3& position)
+{
+	edit(position, true);
+}
+
+void ProximityField::remove(const glm::vec3& position)
+{
+	edit(position, false);
+}
+
+void ProximityField::edit(const glm::vec3& position, bool add)
+{
+	const glm::ivec2 minimum = glm::max(glm::ivec2(glm::floor((glm::vec2(position.x, position.z) - m_distance) / static_cast<float>(Globals::NODE_SIZE))),
+		glm::ivec2(0));
+	const glm::ivec2 maximum = glm::min(glm::ivec2(glm::floor((glm::vec2(position.x, position.z) + m_distance) / static_cast<float>(Globals::NODE_SIZE))),
+		m_size - 1);
+	for (int y = minimum.y; y <= maximum.y; ++y)
+	{
+		for (int x = minimum.x; x <= maximum.x; ++x)
+		{
+			if (Globals::getSqrDistance(position, Globals::convertToWorldPosition(glm::ivec2(x, y))) <= m_distance * m_distance)
+			{
+				uint16_t& sourceCount = m_sourceCounts[static_cast<size_t>(y) * m_size.x + x];
+				assert(add || sourceCount > 0);
+				sourceCount = add ? sourceCount + 1 : sourceCount - 1;
+			}
+		}
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include <stdint.h>
+#include <vector>
+
+//Number of sources within distance of each node, measured to the node's middle world position.
+//Sources are stamped in and out as they are added and removed so a range test is a single lookup
+class ProximityField
+{
+public:
+	ProximityField(glm::ivec2 size, float distance);
+
+	bool isWithinRange(glm::ivec2 position) const;
+
+	void add(const glm::vec3& position);
+	void remove(const glm::vec3& position);
+
+private:
+	glm::ivec2 m_size;
+	float m_distance;
+	std::vector<uint16_t> m_sourceCounts;
+
+	void edit(const glm::vec3& position, bool add);
+};
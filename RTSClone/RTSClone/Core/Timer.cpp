@@ -1,9 +1,27 @@
 #include "Core/Timer.h"
 #include <assert.h>
 
+namespace
+{
+	double simulationTime = 0.0;
+}
+
+//SimulationClock
+double SimulationClock::getTime()
+{
+	return simulationTime;
+}
+
+void SimulationClock::advance(float deltaTime)
+{
+	simulationTime += deltaTime;
+}
+
+//Timer
 Timer::Timer(float expirationTime, bool active)
 	: m_expirationTime(expirationTime),
 	m_elaspedTime(0.0f),
+	m_startTime(SimulationClock::getTime()),
 	m_active(active)
 {}
 
@@ -14,12 +32,12 @@ float Timer::getExpiredTime() const
 
 float Timer::getElaspedTime() const
 {
-	return m_elaspedTime;
+	return m_active ? static_cast<float>(SimulationClock::getTime() - m_startTime) : m_elaspedTime;
 }
 
 bool Timer::isExpired() const
 {
-	return m_elaspedTime >= m_expirationTime;
+	return getElaspedTime() >= m_expirationTime;
 }
 
 bool Timer::isActive() const
@@ -29,26 +47,24 @@ bool Timer::isActive() const
 
 void Timer::setExpirationTime(float expirationTime)
 {
-	assert(m_elaspedTime == 0.0f || isExpired());
+	assert(getElaspedTime() == 0.0f || isExpired());
 	m_expirationTime = expirationTime;
 }
 
 void Timer::setActive(bool active)
 {
-	m_active = active;
-}
-
-void Timer::update(float deltaTime)
-{
-	if (m_active)
+	if (active != m_active)
 	{
-		m_elaspedTime += deltaTime;
+		m_elaspedTime = getElaspedTime();
+		m_startTime = SimulationClock::getTime() - m_elaspedTime;
+		m_active = active;
 	}
 }
 
 void Timer::resetElaspedTime()
 {
 	m_elaspedTime = 0.0f;
+	m_startTime = SimulationClock::getTime();
 }
 
 void Timer::resetExpirationTime(float newExpirationTime)
@@ -1,5 +1,14 @@
 #pragma once
 
+//Seconds of simulation every Timer is measured against, stepped once at the start of each tick before anything
+//reads it. Timers only note when they last started, so nothing has to touch them as time passes - a cooldown
+//costs nothing until something checks whether it's over
+namespace SimulationClock
+{
+	double getTime();
+	void advance(float deltaTime);
+}
+
 class Timer
 {
 public:
@@ -13,12 +22,13 @@ public:
 
 	void setExpirationTime(float expirationTime); 
 	void setActive(bool active);
-	void update(float deltaTime);
 	void resetElaspedTime();
 	void resetExpirationTime(float newExpirationTime);
 
 private:
 	float m_expirationTime	= 0.f;
+	//Held while inactive - while active it's measured from the time it would have started at
 	float m_elaspedTime		= 0.f;
+	double m_startTime		= SimulationClock::getTime();
 	bool m_active			= false;
 };
\ No newline at end of file
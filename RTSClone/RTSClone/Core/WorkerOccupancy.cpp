@@ -0,0 +1,105 @@
+#include "Core/WorkerOccupancy.h"
+#include "Core/Globals.h"
+#include "Entities/Worker.h"
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+	uint64_t getNodeKey(glm::ivec2 node)
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(node.x)) << 32) | static_cast<uint32_t>(node.y);
+	}
+
+	glm::ivec2 getNode(const glm::vec3& position)
+	{
+		return glm::max(Globals::convertToGridPosition(position), glm::ivec2(0, 0));
+	}
+}
+
+WorkerOccupancy::WorkerOccupancy()
+	: m_occupants(),
+	m_maxExtent(0.f)
+{}
+
+void WorkerOccupancy::getWorkers(const AABB& aabb, std::vector<const Worker*>& workers) const
+{
+	workers.clear();
+	forEachOccupant(aabb, [&aabb, &workers](const Occupant& occupant)
+	{
+		if (occupant.worker && occupant.aabb.contains(aabb))
+		{
+			workers.push_back(occupant.worker);
+		}
+	});
+}
+
+bool WorkerOccupancy::isPositionOccupied(glm::ivec2 position, int ignoreWorkerID) const
+{
+	const glm::vec3 worldPosition = Globals::convertToWorldPosition(position);
+	bool occupied = false;
+	forEachOccupant(AABB(worldPosition.x, worldPosition.x, worldPosition.z, worldPosition.z),
+		[&worldPosition, ignoreWorkerID, &occupied](const Occupant& occupant)
+	{
+		occupied = occupied || (occupant.workerID != ignoreWorkerID && occupant.aabb.contains(worldPosition));
+	});
+
+	return occupied;
+}
+
+void WorkerOccupancy::clear()
+{
+	m_occupants.clear();
+	m_maxExtent = 0.f;
+}
+
+void WorkerOccupancy::add(const Worker& worker)
+{
+	add(worker, worker.getAABB(), false);
+}
+
+//Kept sorted as workers are sent off one at a time
+void WorkerOccupancy::addDestination(const Worker& worker, const glm::vec3& destination)
+{
+	const AABB& aabb = worker.getAABB();
+	add(worker, AABB(aabb.getMin() + destination - worker.getPosition(), aabb.getSize()), true);
+	std::inplace_merge(m_occupants.begin(), std::prev(m_occupants.end()), m_occupants.end(), [](const Occupant& a, const Occupant& b)
+	{
+		return a.node < b.node;
+	});
+}
+
+//Stable so occupants are always met in the same order
+void WorkerOccupancy::sortByNode()
+{
+	std::stable_sort(m_occupants.begin(), m_occupants.end(), [](const Occupant& a, const Occupant& b)
+	{
+		return a.node < b.node;
+	});
+}
+
+void WorkerOccupancy::add(const Worker& worker, const AABB& aabb, bool destination)
+{
+	const glm::vec3 center = aabb.getCenterPosition();
+	m_occupants.push_back({ getNodeKey(getNode(center)), aabb, destination ? nullptr : &worker, worker.getID() });
+	m_maxExtent = glm::max(m_maxExtent, glm::max(aabb.getSize().x, aabb.getSize().z) / 2.f);
+}
+
+//Occupants on any node the AABB covers once grown by the widest occupant - an occupant overlapping it can't stand
+//any further away
+template <typename Function>
+void WorkerOccupancy::forEachOccupant(const AABB& aabb, Function function) const
+{
+	const glm::ivec2 minimum = getNode({ aabb.getLeft() - m_maxExtent, 0.f, aabb.getBack() - m_maxExtent });
+	const glm::ivec2 maximum = getNode({ aabb.getRight() + m_maxExtent, 0.f, aabb.getForward() + m_maxExtent });
+	for (int x = minimum.x; x <= maximum.x; ++x)
+	{
+		const uint64_t last = getNodeKey({ x, maximum.y });
+		auto occupant = std::lower_bound(m_occupants.cbegin(), m_occupants.cend(), getNodeKey({ x, minimum.y }),
+			[](const Occupant& occupant, uint64_t key) { return occupant.node < key; });
+		for (; occupant != m_occupants.cend() && occupant->node <= last; ++occupant)
+		{
+			function(*occupant);
+		}
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Core/AABB.h"
+#include "glm/glm.hpp"
+#include <stdint.h>
+#include <vector>
+
+//Where a faction's workers stand, sorted by the node they're on and rebuilt each time its worker collisions are
+//handled - overlapping workers are only looked for on the nodes an AABB covers and the search for a free node asks it
+//in place of walking every worker. Destinations workers are sent to hold their node until it's next rebuilt,
+//so workers pushed apart together don't all head for the same one.
+class Worker;
+class WorkerOccupancy
+{
+public:
+	WorkerOccupancy();
+
+	//Workers whose AABB overlaps the AABB
+	void getWorkers(const AABB& aabb, std::vector<const Worker*>& workers) const;
+	bool isPositionOccupied(glm::ivec2 position, int ignoreWorkerID) const;
+
+	void clear();
+	void add(const Worker& worker);
+	void addDestination(const Worker& worker, const glm::vec3& destination);
+	void sortByNode();
+
+private:
+	struct Occupant
+	{
+		uint64_t node				= 0;
+		AABB aabb					= {};
+		const Worker* worker		= nullptr;
+		int workerID				= 0;
+	};
+
+	std::vector<Occupant> m_occupants;
+	float m_maxExtent;
+
+	void add(const Worker& worker, const AABB& aabb, bool destination);
+	template <typename Function>
+	void forEachOccupant(const AABB& aabb, Function function) const;
+};
@@ -7,7 +7,10 @@
 #include "Factions/Faction.h"
 #include "Events/GameEvents.h"
 #include "glm/gtc/matrix_transform.hpp"
+#ifndef HEADLESS
 #include "Core/Camera.h"
+#endif // HEADLESS
+#include <cmath>
 
 namespace
 {
@@ -52,6 +55,13 @@ namespace
 	};
 
 	const float SHIELD_REPLENISH_TIMER_EXPIRATION = 15.0f;
+
+	//Turns the short way round between two angles in degrees
+	float interpolateAngle(float previousAngle, float angle, float interpolation)
+	{
+		const float difference = std::fmod(std::fmod(angle - previousAngle, 360.0f) + 540.0f, 360.0f) - 180.0f;
+		return previousAngle + difference * interpolation;
+	}
 }
 
 //Entity
@@ -65,7 +75,9 @@ Entity::Entity(const Model& model, const Position& position, eEntityType entityT
 	m_health(m_maximumHealth),
 	m_type(entityType),
 	m_shieldReplenishTimer(SHIELD_REPLENISH_TIMER_EXPIRATION, false),
-	m_model(model)
+	m_model(model),
+	m_previousPosition(m_position.Get()),
+	m_previousRotation(m_rotation)
 {
 	m_AABB.reset(m_position.Get(), m_model);
 	if (m_maximumShield == 1)
@@ -74,9 +86,12 @@ Entity::Entity(const Model& model, const Position& position, eEntityType entityT
 	}
 }
 
-void Entity::update(float deltaTime)
+void Entity::update(float)
 {
-	m_shieldReplenishTimer.update(deltaTime);
+	//Where this tick starts from - rendered between here and wherever it ends up
+	m_previousPosition = m_position.Get();
+	m_previousRotation = m_rotation;
+
 	if (m_shieldReplenishTimer.isExpired())
 	{
 		m_shieldReplenishTimer.resetElaspedTime();
@@ -169,66 +184,82 @@ bool Entity::repairEntity(const Entity& entity, const Map& map)
 	return entity.getHealth() < entity.getMaximumHealth();
 }
 
-void Entity::render(ShaderHandler& shaderHandler, eFactionController owningFactionController) const
+void Entity::render(ShaderHandler& shaderHandler, eFactionController owningFactionController, float interpolation) const
 {
 	switch (owningFactionController)
 	{
 	case eFactionController::Player:
-		m_model.get().render(shaderHandler, owningFactionController, m_position.Get(), m_rotation, m_selected);
+		m_model.get().render(shaderHandler, owningFactionController, getRenderPosition(interpolation),
+			getRenderRotation(interpolation), m_selected);
 		break;
 	case eFactionController::AI_1:
 	case eFactionController::AI_2:
 	case eFactionController::AI_3:
-		m_model.get().render(shaderHandler, owningFactionController, m_position.Get(), m_rotation, false);
+		m_model.get().render(shaderHandler, owningFactionController, getRenderPosition(interpolation),
+			getRenderRotation(interpolation), false);
 		break;
 	default:
 		assert(false);
 	}
 }
 
-void Entity::renderHealthBar(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const
+#ifndef HEADLESS
+void Entity::renderHealthBar(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const
 {
 	if (m_selected)
 	{
 		float width = Globals::ENTITIES_STAT_BAR_WIDTH[static_cast<int>(getEntityType())];
 		float yOffset = ENTITIES_YOFFSET_HEALTH[static_cast<int>(getEntityType())];
-		
-		m_statbarSprite.render(m_position.Get(), windowSize, width, width, DEFAULT_STAT_BAR_HEIGHT, yOffset,
+		const glm::vec3 position = getRenderPosition(interpolation);
+		m_statbarSprite.render(position, windowSize, width, width, DEFAULT_STAT_BAR_HEIGHT, yOffset,
 			shaderHandler, camera, Globals::BACKGROUND_BAR_COLOR);
 		
 		float currentHealth = static_cast<float>(m_health) / static_cast<float>(m_maximumHealth);
-		m_statbarSprite.render(m_position.Get(), windowSize, width, width * currentHealth, DEFAULT_STAT_BAR_HEIGHT, yOffset,
+		m_statbarSprite.render(position, windowSize, width, width * currentHealth, DEFAULT_STAT_BAR_HEIGHT, yOffset,
 			shaderHandler, camera, Globals::HEALTH_BAR_COLOR);
 	}
 }
 
-void Entity::renderShieldBar(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const
+void Entity::renderShieldBar(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const
 {
 	if (m_selected && m_maximumShield > 0)
 	{
 		float width = Globals::ENTITIES_STAT_BAR_WIDTH[static_cast<int>(getEntityType())];
 		float yOffset = ENTITIES_YOFFSET_SHIELD[static_cast<int>(getEntityType())];
-
-		m_statbarSprite.render(m_position.Get(), windowSize, width, width, DEFAULT_STAT_BAR_HEIGHT, yOffset,
+		const glm::vec3 position = getRenderPosition(interpolation);
+		m_statbarSprite.render(position, windowSize, width, width, DEFAULT_STAT_BAR_HEIGHT, yOffset,
 			shaderHandler, camera, Globals::BACKGROUND_BAR_COLOR);
 
 		float currentShield = static_cast<float>(m_shield) / static_cast<float>(m_maximumShield);
-		m_statbarSprite.render(m_position.Get(), windowSize, width, width * currentShield, DEFAULT_STAT_BAR_HEIGHT, yOffset,
+		m_statbarSprite.render(position, windowSize, width, width * currentShield, DEFAULT_STAT_BAR_HEIGHT, yOffset,
 			shaderHandler, camera, Globals::SHIELD_BAR_COLOR);
 	}
 }
 
-void Entity::render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const
+void Entity::render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const
 {
-	renderHealthBar(shaderHandler, camera, windowSize);
-	renderShieldBar(shaderHandler, camera, windowSize);
+	renderHealthBar(shaderHandler, camera, windowSize, interpolation);
+	renderShieldBar(shaderHandler, camera, windowSize, interpolation);
 }
+#endif // HEADLESS
 
 void Entity::setPosition(const glm::vec3& position)
 {
 	m_AABB.update(m_position.Set(position));
 }
 
+glm::vec3 Entity::getRenderPosition(float interpolation) const
+{
+	return glm::mix(m_previousPosition, m_position.Get(), interpolation);
+}
+
+glm::vec3 Entity::getRenderRotation(float interpolation) const
+{
+	return { interpolateAngle(m_previousRotation.x, m_rotation.x, interpolation),
+		interpolateAngle(m_previousRotation.y, m_rotation.y, interpolation),
+		interpolateAngle(m_previousRotation.z, m_rotation.z, interpolation) };
+}
+
 const glm::vec3& Entity::getPosition() const
 {
 	return m_position.Get();
@@ -4,7 +4,9 @@
 #include "Core/AABB.h"
 #include <functional>
 #include "EntityType.h"
+#ifndef HEADLESS
 #include "UI/Sprite.h"
+#endif // HEADLESS
 #include "Core/Timer.h"
 #include "Position.h"
 #include "Core/UniqueID.h"
@@ -45,8 +47,10 @@ public:
 	virtual bool MoveTo(const glm::vec3& position, const Map& map, const bool add_to_destinations) { return false; };
 	virtual void ReturnMineralsToHeadquarters(const Headquarters& headquarters, const Map& map) {};
 	virtual bool AddEntityToSpawnQueue(const Faction& owningFaction) { return false; };
-	virtual void render(ShaderHandler& shaderHandler, eFactionController owningFactionController) const;
-	virtual void render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const;
+	virtual void render(ShaderHandler& shaderHandler, eFactionController owningFactionController, float interpolation) const;
+#ifndef HEADLESS
+	virtual void render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const;
+#endif // HEADLESS
 
 	int getID() const;
 	const glm::vec3& getRotation() const;
@@ -66,14 +70,19 @@ protected:
 	
 	void update(float deltaTime);
 	void setPosition(const glm::vec3& position);
+	glm::vec3 getRenderPosition(float interpolation) const;
 	
+#ifndef HEADLESS
 	Sprite m_statbarSprite;
+#endif // HEADLESS
 	Position m_position;
 	glm::vec3 m_rotation;
 	AABB m_AABB;
 
 private:
 	std::reference_wrapper<const Model> m_model;
+	glm::vec3 m_previousPosition	= {};
+	glm::vec3 m_previousRotation	= {};
 	UniqueID m_id					= {};
 	int m_maximumHealth				= 0;
 	int m_health					= 0;
@@ -84,6 +93,9 @@ private:
 	bool m_selected					= false;
 
 	void increaseShield();
-	void renderHealthBar(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const;
-	void renderShieldBar(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const;
+	glm::vec3 getRenderRotation(float interpolation) const;
+#ifndef HEADLESS
+	void renderHealthBar(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const;
+	void renderShieldBar(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const;
+#endif // HEADLESS
 };
\ No newline at end of file
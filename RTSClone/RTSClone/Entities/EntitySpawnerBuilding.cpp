@@ -1,5 +1,7 @@
 #include "EntitySpawnerBuilding.h"
+#ifndef HEADLESS
 #include "Core/Camera.h"
+#endif // HEADLESS
 #include "Events/GameMessenger.h"
 #include "Events/GameMessages.h"
 #include "Graphics/Model.h"
@@ -17,7 +19,8 @@ EntitySpawnerBuilding::EntitySpawnerBuilding(const Position& position, const eEn
 	m_timer(spawnDetails.timeBetweenSpawn, false)
 {
 	broadcast<GameMessages::AddAABBToMap>({ m_AABB });
-	Level::add_event(GameEvent::create<RevalidateMovementPathsEvent>({}));
+	Level::add_event(GameEvent::create<RevalidateMovementPathsEvent>(
+		{ m_AABB.getLeft(), m_AABB.getRight(), m_AABB.getForward(), m_AABB.getBack() }));
 }
 
 EntitySpawnerBuilding::~EntitySpawnerBuilding()
@@ -46,7 +49,6 @@ bool EntitySpawnerBuilding::is_group_selectable() const
 void EntitySpawnerBuilding::update(const float deltaTime, Faction& owningFaction, const Map& map)
 {
 	Entity::update(deltaTime);
-	m_timer.update(deltaTime);
 	if (m_timer.isExpired() && m_spawnCount > 0)
 	{
 		m_timer.resetElaspedTime();
@@ -74,9 +76,10 @@ void EntitySpawnerBuilding::update(const float deltaTime, Faction& owningFaction
 	}
 }
 
-void EntitySpawnerBuilding::render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const
+#ifndef HEADLESS
+void EntitySpawnerBuilding::render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const
 {
-	Entity::render_status_bars(shaderHandler, camera, windowSize);
+	Entity::render_status_bars(shaderHandler, camera, windowSize, interpolation);
 	if (m_timer.isActive())
 	{
 		const float currentTime = m_timer.getElaspedTime() / m_timer.getExpiredTime();
@@ -87,6 +90,7 @@ void EntitySpawnerBuilding::render_status_bars(ShaderHandler& shaderHandler, con
 			shaderHandler, camera, Globals::PROGRESS_BAR_COLOR);
 	}
 }
+#endif // HEADLESS
 
 bool EntitySpawnerBuilding::set_waypoint_position(const glm::vec3& position, const Map& map)
 {
@@ -120,9 +124,9 @@ bool EntitySpawnerBuilding::AddEntityToSpawnQueue(const Faction& owningFaction)
 	return false;
 }
 
-void EntitySpawnerBuilding::render(ShaderHandler& shaderHandler, eFactionController owningFactionController) const
+void EntitySpawnerBuilding::render(ShaderHandler& shaderHandler, eFactionController owningFactionController, float interpolation) const
 {
-	Entity::render(shaderHandler, owningFactionController);
+	Entity::render(shaderHandler, owningFactionController, interpolation);
 	if (isSelected() && m_waypoint)
 	{
 		ModelManager::getInstance().getModel(WAYPOINT_MODEL_NAME).render(shaderHandler, *m_waypoint);
@@ -42,10 +42,12 @@ public:
 	bool is_group_selectable() const override;
 
 	void update(const float deltaTime, Faction& owningFaction, const Map& map);
-	void render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const override;
+#ifndef HEADLESS
+	void render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const override;
+#endif // HEADLESS
 	bool set_waypoint_position(const glm::vec3& position, const Map& map) override;
 	bool AddEntityToSpawnQueue(const Faction& owningFaction) override;
-	void render(ShaderHandler& shaderHandler, eFactionController owningFactionController) const override;
+	void render(ShaderHandler& shaderHandler, eFactionController owningFactionController, float interpolation) const override;
 
 protected:
 	Timer m_timer								= {};
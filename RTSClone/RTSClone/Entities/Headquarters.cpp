@@ -28,7 +28,8 @@ Headquarters::Headquarters(const Position& position, Faction& owningFaction)
 	m_owningFaction(&owningFaction)
 {
 	Level::add_event(GameEvent::create<AttachFactionToBaseEvent>({ owningFaction.getController(), m_position.Get() }));
-	Level::add_event(GameEvent::create<RevalidateMovementPathsEvent>({}));
+	Level::add_event(GameEvent::create<RevalidateMovementPathsEvent>(
+		{ m_AABB.getLeft(), m_AABB.getRight(), m_AABB.getForward(), m_AABB.getBack() }));
 }
 
 Headquarters::~Headquarters()
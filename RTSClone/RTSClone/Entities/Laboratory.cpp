@@ -5,7 +5,9 @@
 #include "Events/GameMessages.h"
 #include "Factions/Faction.h"
 #include "Graphics/ShaderHandler.h"
+#ifndef HEADLESS
 #include "Core/Camera.h"
+#endif // HEADLESS
 #include "Events/GameEvents.h"
 #include "Core/Level.h"
 
@@ -23,7 +25,8 @@ Laboratory::Laboratory(const Position& position, Faction& owningFaction)
 	m_increaseShieldTimer(INCREASE_SHIELD_TIMER_EXPIRATION, false)
 {
 	broadcast<GameMessages::AddAABBToMap>({ m_AABB });
-	Level::add_event(GameEvent::create<RevalidateMovementPathsEvent>({}));
+	Level::add_event(GameEvent::create<RevalidateMovementPathsEvent>(
+		{ m_AABB.getLeft(), m_AABB.getRight(), m_AABB.getForward(), m_AABB.getBack() }));
 }
 
 Laboratory::~Laboratory()
@@ -66,7 +69,6 @@ void Laboratory::update(float deltaTime)
 	{
 		assert(m_shieldUpgradeCounter > 0);
 
-		m_increaseShieldTimer.update(deltaTime);
 		if (m_increaseShieldTimer.isExpired())
 		{
 			if (m_owningFaction.get().increaseShield(*this))
@@ -84,9 +86,10 @@ void Laboratory::update(float deltaTime)
 	}
 }
 
-void Laboratory::render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const
+#ifndef HEADLESS
+void Laboratory::render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const
 {
-	Entity::render_status_bars(shaderHandler, camera, windowSize);
+	Entity::render_status_bars(shaderHandler, camera, windowSize, interpolation);
 	if (m_increaseShieldTimer.isActive())
 	{
 		assert(m_shieldUpgradeCounter > 0);
@@ -96,4 +99,5 @@ void Laboratory::render_status_bars(ShaderHandler& shaderHandler, const Camera&
 			Globals::LABORATORY_STAT_BAR_WIDTH * currentTime, Globals::DEFAULT_PROGRESS_BAR_HEIGHT,
 			PROGRESS_BAR_YOFFSET, shaderHandler, camera, Globals::PROGRESS_BAR_COLOR);
 	}
-}
\ No newline at end of file
+}
+#endif // HEADLESS
\ No newline at end of file
@@ -19,7 +19,9 @@ public:
 
 	void handleEvent(IncreaseFactionShieldEvent gameEvent);
 	void update(float deltaTime);
-	void render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const override;
+#ifndef HEADLESS
+	void render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const override;
+#endif // HEADLESS
 
 private:
 	std::reference_wrapper<Faction> m_owningFaction;
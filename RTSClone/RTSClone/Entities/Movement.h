@@ -1,6 +1,7 @@
 #pragma once
 
 #include "glm/glm.hpp"
+#include "Core/MovementCore.h"
 #include <queue>
 #include <vector>
 #ifdef RENDER_PATHING
@@ -13,6 +14,7 @@ struct Movement
 
 	std::vector<glm::vec3> path;
 	std::queue<glm::vec3> destinations;
+	MovementSlot slot;
 #ifdef RENDER_PATHING
 	Mesh pathMesh = {};
 #endif // RENDER_PATHING
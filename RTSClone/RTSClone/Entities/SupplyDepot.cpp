@@ -11,7 +11,8 @@ SupplyDepot::SupplyDepot(const Position& position, const Faction& owningFaction)
 		eEntityType::SupplyDepot, Globals::SUPPLY_DEPOT_STARTING_HEALTH, owningFaction.getCurrentShieldAmount())
 {
 	broadcast<GameMessages::AddAABBToMap>({ m_AABB });
-	Level::add_event(GameEvent::create<RevalidateMovementPathsEvent>({}));
+	Level::add_event(GameEvent::create<RevalidateMovementPathsEvent>(
+		{ m_AABB.getLeft(), m_AABB.getRight(), m_AABB.getForward(), m_AABB.getBack() }));
 }
 
 SupplyDepot::~SupplyDepot()
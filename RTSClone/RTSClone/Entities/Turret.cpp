@@ -25,7 +25,8 @@ Turret::Turret(const Position& position, const Faction& owningFaction)
 	m_attackTimer(TIME_BETWEEN_ATTACK, true)
 {
 	broadcast<GameMessages::AddAABBToMap>({ m_AABB });
-	Level::add_event(GameEvent::create<RevalidateMovementPathsEvent>({}));
+	Level::add_event(GameEvent::create<RevalidateMovementPathsEvent>(
+		{ m_AABB.getLeft(), m_AABB.getRight(), m_AABB.getForward(), m_AABB.getBack() }));
 }
 
 Turret::~Turret()
@@ -44,8 +45,6 @@ bool Turret::is_group_selectable() const
 void Turret::update(float deltaTime, FactionHandler& factionHandler, const Map& map)
 {
 	Entity::update(deltaTime);
-	m_stateHandlerTimer.update(deltaTime);
-	m_attackTimer.update(deltaTime);
 
 	if (m_target)
 	{
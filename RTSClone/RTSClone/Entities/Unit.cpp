@@ -30,6 +30,7 @@ Unit::Unit(Faction & owningFaction, const EntityToSpawnFromBuilding& entity_to_s
 	m_owningFaction(owningFaction.getController()),
 	m_attackTimer(TIME_BETWEEN_ATTACK, true)
 {
+	m_movement.slot = MovementSlot(owningFaction.get_movement_core(), m_position.Get(), MOVEMENT_SPEED, true);
 	if (!entity_to_spawn.destination)
 	{
 		broadcast<GameMessages::AddUnitPositionToMap>({ m_position.Get(), getID() });
@@ -53,6 +54,9 @@ Unit::~Unit()
 			assert(Globals::isOnMiddlePosition(m_position.Get()));
 			broadcast<GameMessages::RemoveUnitPositionFromMap>({ m_position.Get(), getID() });
 		}
+
+		m_movement.path.clear();
+		broadcast<GameMessages::SetMovementPath>({ m_movement.path, m_position.Get(), getID(), m_owningFaction });
 	}
 }
 
@@ -81,6 +85,19 @@ bool Unit::is_group_selectable() const
 	return true;
 }
 
+bool Unit::get_movement_path_query(const Map& map, PathQuery& query) const
+{
+	if (m_movement.path.empty())
+	{
+		return false;
+	}
+
+	query.entity = this;
+	query.destination = m_movement.path.front();
+	query.adjacentPositions = createAdjacentPositions(map, *this);
+	return true;
+}
+
 void Unit::clear_destinations()
 {
 	m_movement.destinations = {};
@@ -146,47 +163,32 @@ bool Unit::MoveTo(const glm::vec3& destination, const Map& map, const bool add_t
 	}
 
 	PathFinding::getInstance().getPathToPosition(*this, destination, m_movement.path, map, createAdjacentPositions(map, *this));
-	if (!m_movement.path.empty())
-	{
-		switchToState(eUnitState::Moving);
-		return true;
-	}
-	else
-	{
-		if (previousDestination != m_position.Get())
-		{
-			PathFinding::getInstance().getPathToPosition(*this, previousDestination, m_movement.path, map,
-				createAdjacentPositions(map, *this));
-
-			switchToState(eUnitState::Moving);
-			return true;
-		}
-		else
-		{
-			switchToState(eUnitState::Idle);
-		}
-	}
-
-	return false;
+	return set_movement_path(previousDestination, map);
 }
 
-void Unit::update(float deltaTime, FactionHandler& factionHandler, const Map& map)
+//Only touches the unit itself - run for every faction at once
+void Unit::update_movement(float deltaTime)
 {
 	Entity::update(deltaTime);
 
+	//Moved by the faction's MovementCore before its entities update
+	assert(m_movement.slot.isMatchingPath(m_movement.path));
 	if (!m_movement.path.empty())
 	{
-		glm::vec3 newPosition = Globals::moveTowards(m_position.Get(), m_movement.path.back(), MOVEMENT_SPEED * deltaTime);
-		m_rotation.y = Globals::getAngle(newPosition, m_position.Get());
-		setPosition(newPosition);
+		m_rotation.y = m_movement.slot.getRotation();
+		setPosition(m_movement.slot.getPosition());
 
 		if (m_position.Get() == m_movement.path.back())
 		{
 			assert(Globals::isOnMiddlePosition(m_position.Get()));
 			m_movement.path.pop_back();
+			m_movement.slot.setPath(m_position.Get(), m_rotation.y, m_movement.path);
 		}
 	}
+}
 
+void Unit::update(float, FactionHandler& factionHandler, const Map& map)
+{
 	switch (m_currentState)
 	{
 	case eUnitState::Idle:
@@ -206,6 +208,11 @@ void Unit::update(float deltaTime, FactionHandler& factionHandler, const Map& ma
 				switchToState(eUnitState::Idle);
 			}
 		}
+		//Steered off to where its waypoint can't be headed straight for
+		else if (m_movement.slot.isBlocked())
+		{
+			MoveTo(m_movement.path.front(), map, false);
+		}
 		break;
 	case eUnitState::AttackMoving:
 		assert(!m_target);
@@ -242,8 +249,29 @@ void Unit::update(float deltaTime, FactionHandler& factionHandler, const Map& ma
 	
 		break;
 	}
+}
 
-	m_attackTimer.update(deltaTime);
+//What delayed_update would look for in range of it in the opposing faction, found ahead of it. Only reads the unit
+//and the opposing faction, and writes the one slot that faction has - so every opposing faction can be searched at once
+void Unit::find_target_in_range(const Faction& opposingFaction)
+{
+	const Entity*& targetEntity = m_targetsInRange[static_cast<size_t>(opposingFaction.getController())];
+	targetEntity = nullptr;
+	switch (m_currentState)
+	{
+	case eUnitState::Idle:
+	case eUnitState::AttackMoving:
+		targetEntity = opposingFaction.getEntity(m_position.Get(), Globals::UNIT_ATTACK_RANGE, true);
+		break;
+	case eUnitState::AttackingTarget:
+		if (m_target->controller == opposingFaction.getController() && !opposingFaction.get_entity(m_target->ID))
+		{
+			targetEntity = opposingFaction.getEntity(m_position.Get(), Globals::UNIT_ATTACK_RANGE);
+		}
+		break;
+	default:
+		break;
+	}
 }
 
 void Unit::delayed_update(FactionHandler& factionHandler, const Map& map)
@@ -254,7 +282,7 @@ void Unit::delayed_update(FactionHandler& factionHandler, const Map& map)
 		assert(m_movement.path.empty() && !m_target);
 		for (const Faction* opposingFaction : factionHandler.GetOpposingFactions(m_owningFaction))
 		{
-			const Entity* targetEntity = opposingFaction->getEntity(m_position.Get(), Globals::UNIT_ATTACK_RANGE, true);
+			const Entity* targetEntity = m_targetsInRange[static_cast<size_t>(opposingFaction->getController())];
 			if (targetEntity)
 			{
 				attack_entity(*targetEntity, opposingFaction->getController(), map);
@@ -298,7 +326,7 @@ void Unit::delayed_update(FactionHandler& factionHandler, const Map& map)
 		assert(!m_target);
 		for (const Faction* opposingFaction : factionHandler.GetOpposingFactions(m_owningFaction))
 		{
-			const Entity* targetEntity = opposingFaction->getEntity(m_position.Get(), Globals::UNIT_ATTACK_RANGE);
+			const Entity* targetEntity = m_targetsInRange[static_cast<size_t>(opposingFaction->getController())];
 			if (targetEntity && PathFinding::getInstance().isTargetInLineOfSight(m_position.Get(), *targetEntity, map))
 			{
 				attack_entity(*targetEntity, opposingFaction->getController(), map);
@@ -317,7 +345,7 @@ void Unit::delayed_update(FactionHandler& factionHandler, const Map& map)
 				const Entity* targetEntity = targetFaction->get_entity(m_target->ID);
 				if (!targetEntity)
 				{
-					targetEntity = targetFaction->getEntity(m_position.Get(), Globals::UNIT_ATTACK_RANGE);
+					targetEntity = m_targetsInRange[static_cast<size_t>(targetFaction->getController())];
 					if (!targetEntity)
 					{
 						switchToState(eUnitState::Idle);
@@ -352,12 +380,14 @@ void Unit::delayed_update(FactionHandler& factionHandler, const Map& map)
 	}
 }
 
-void Unit::revalidate_movement_path(const Map& map)
+void Unit::revalidate_movement_path(const Map& map, std::vector<glm::vec3>& path)
 {
-	if (!m_movement.path.empty())
-	{
-		MoveTo(m_movement.path.front(), map, false);
-	}
+	assert(!m_movement.path.empty());
+	glm::vec3 previousDestination = Globals::getNextPathDestination(m_movement.path, m_position.Get());
+	broadcast<GameMessages::RemoveUnitPositionFromMap>({ m_movement.path.front(), getID() });
+
+	m_movement.path.swap(path);
+	set_movement_path(previousDestination, map);
 }
 
 #ifdef RENDER_PATHING
@@ -379,7 +409,7 @@ void Unit::switchToState(eUnitState newState)
 		{
 			broadcast<GameMessages::RemoveUnitPositionFromMap>({ m_position.Get(), getID() });
 		}
-		else if (newState != eUnitState::AttackMoving)
+		else if (newState != eUnitState::AttackingTarget)
 		{
 			m_target = std::nullopt;
 		}
@@ -413,6 +443,7 @@ void Unit::switchToState(eUnitState newState)
 	case eUnitState::AttackMoving:
 		assert(!m_movement.path.empty());
 		broadcast<GameMessages::AddUnitPositionToMap>({ m_movement.path.front(), getID()  });
+		broadcast<GameMessages::SetMovementPath>({ m_movement.path, m_position.Get(), getID(), m_owningFaction });
 		m_target.reset();
 		break;
 	case eUnitState::AttackingTarget:
@@ -425,8 +456,46 @@ void Unit::switchToState(eUnitState newState)
 	case eUnitState::Moving:
 		assert(!m_movement.path.empty());
 		broadcast<GameMessages::AddUnitPositionToMap>({ m_movement.path.front(), getID() });
+		broadcast<GameMessages::SetMovementPath>({ m_movement.path, m_position.Get(), getID(), m_owningFaction });
 		break;
 	default:
 		assert(false);
 	}
+
+	if (m_movement.path.empty())
+	{
+		broadcast<GameMessages::SetMovementPath>({ m_movement.path, m_position.Get(), getID(), m_owningFaction });
+	}
+	m_movement.slot.setPath(m_position.Get(), m_rotation.y, m_movement.path);
+}
+
+bool Unit::set_movement_path(const glm::vec3& previousDestination, const Map& map)
+{
+	if (!m_movement.path.empty())
+	{
+		switchToState(eUnitState::Moving);
+		return true;
+	}
+	else
+	{
+		if (previousDestination != m_position.Get())
+		{
+			PathFinding::getInstance().getPathToPosition(*this, previousDestination, m_movement.path, map,
+				createAdjacentPositions(map, *this));
+			//No longer reachable - stop on the node being crossed
+			if (m_movement.path.empty())
+			{
+				m_movement.path.push_back(Globals::convertToMiddleGridPosition(m_position.Get()));
+			}
+
+			switchToState(eUnitState::Moving);
+			return true;
+		}
+		else
+		{
+			switchToState(eUnitState::Idle);
+		}
+	}
+
+	return false;
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "Core/Globals.h"
 #include "Graphics/ModelManager.h"
 #include "Core/TypeComparison.h"
+#include <array>
 #include <functional>
 #include <vector>
 #include <queue>
@@ -23,6 +24,7 @@ enum class eUnitState
 };
 
 struct EntityToSpawnFromBuilding;
+struct PathQuery;
 class Faction;
 class Map;
 class ShaderHandler;
@@ -42,13 +44,16 @@ public:
 	float getAttackRange() const;
 	eUnitState getCurrentState() const;
 	bool is_group_selectable() const override;
+	bool get_movement_path_query(const Map& map, PathQuery& query) const;
 
 	void clear_destinations();
 	void attack_entity(const Entity& targetEntity, const eFactionController targetController, const Map& map) override;
 	bool MoveTo(const glm::vec3& destination, const Map& map, const bool add_to_destinations) override;
+	void update_movement(float deltaTime);
 	void update(float deltaTime, FactionHandler& factionHandler, const Map& map);
+	void find_target_in_range(const Faction& opposingFaction);
 	void delayed_update(FactionHandler& factionHandler, const Map& map);
-	void revalidate_movement_path(const Map& map);
+	void revalidate_movement_path(const Map& map, std::vector<glm::vec3>& path);
 #ifdef RENDER_PATHING
 	void render_path(ShaderHandler& shaderHandler);
 #endif // RENDER_PATHING
@@ -59,6 +64,8 @@ private:
 	eUnitState m_currentState				= eUnitState::Idle;
 	Timer m_attackTimer						= {};
 	std::optional<TargetEntity> m_target	= {};
+	std::array<const Entity*, static_cast<size_t>(eFactionController::Max) + 1> m_targetsInRange = {};
 
 	void switchToState(eUnitState newState);
+	bool set_movement_path(const glm::vec3& previousDestination, const Map& map);
 };
\ No newline at end of file
@@ -8,7 +8,9 @@
 #include "Events/GameEvents.h"
 #include "Factions/FactionHandler.h"
 #include "Graphics/ShaderHandler.h"
+#ifndef HEADLESS
 #include "Core/Camera.h"
+#endif // HEADLESS
 #include "Events/GameMessenger.h"
 #include "Events/GameMessages.h"
 #include "Core/Base.h"
@@ -44,8 +46,10 @@ WorkerScheduledBuilding::WorkerScheduledBuilding(const glm::vec3& position, eEnt
 Worker::Worker(Faction& owningFaction, const EntityToSpawnFromBuilding& entity_to_spawn, const Map& map)
 	: Entity(ModelManager::getInstance().getModel(WORKER_MODEL_NAME), { entity_to_spawn.position, GridLockActive::False }, 
 		eEntityType::Worker, Globals::WORKER_STARTING_HEALTH, owningFaction.getCurrentShieldAmount(), entity_to_spawn.rotation),
-	m_owningFaction(&owningFaction)
+	m_owningFaction(&owningFaction),
+	m_mineralToHarvest(owningFaction.get_mineral_reservations())
 {
+	m_movement.slot = MovementSlot(owningFaction.get_movement_core(), m_position.Get(), MOVEMENT_SPEED);
 	if (!entity_to_spawn.destination)
 	{
 		switchTo(eWorkerState::Idle);
@@ -56,9 +60,18 @@ Worker::Worker(Faction& owningFaction, const EntityToSpawnFromBuilding& entity_t
 	}
 }
 
+Worker::~Worker()
+{
+	if (getID() != UniqueID::INVALID_ID)
+	{
+		m_movement.path.clear();
+		broadcast<GameMessages::SetMovementPath>({ m_movement.path, m_position.Get(), getID(), m_owningFaction->getController() });
+	}
+}
+
 const Mineral* Worker::getMineralToHarvest() const
 {
-	return m_mineralToHarvest;
+	return m_mineralToHarvest.get();
 }
 
 const std::deque<WorkerScheduledBuilding>& Worker::get_scheduled_buildings() const
@@ -107,6 +120,41 @@ bool Worker::is_group_selectable() const
 	return true;
 }
 
+bool Worker::get_movement_path_query(const Map& map, PathQuery& query) const
+{
+	if (m_movement.path.empty())
+	{
+		return false;
+	}
+
+	switch (m_currentState)
+	{
+	case eWorkerState::Moving:
+	case eWorkerState::ReturningMineralsToHeadquarters:
+	case eWorkerState::MovingToBuildingPosition:
+	case eWorkerState::MovingToRepairPosition:
+		query.destination = m_movement.path.front();
+		break;
+	case eWorkerState::MovingToMinerals:
+		//Heads back to the mineral it's harvesting the same way Harvest sets off to it
+		assert(m_mineralToHarvest.get());
+		query.destination = get_harvest_position(*m_mineralToHarvest.get(), map);
+		break;
+	case eWorkerState::Idle:
+	case eWorkerState::Harvesting:
+	case eWorkerState::Building:
+	case eWorkerState::Repairing:
+		return false;
+	default:
+		assert(false);
+		return false;
+	}
+
+	query.entity = this;
+	query.adjacentPositions = createAdjacentPositions(map);
+	return true;
+}
+
 int Worker::extractResources()
 {
 	assert(isHoldingResources());
@@ -132,7 +180,7 @@ bool Worker::repairEntity(const Entity& entity, const Map& map)
 	}
 
 	m_repairTargetEntity = { entity.getID() };
-	glm::vec3 destination = PathFinding::getInstance().getClosestPositionToAABB(entity.getPosition(), entity.getAABB(), map);
+	glm::vec3 destination = PathFinding::getInstance().getClosestPositionToAABB(m_position.Get(), entity.getAABB(), map);
 	move_to(destination, map, eWorkerState::MovingToRepairPosition);	
 	
 	return true;
@@ -170,22 +218,28 @@ bool Worker::build(const Faction& owningFaction, const glm::vec3& buildPosition,
 	return false;
 }
 
-void Worker::update(float deltaTime, const Map& map, FactionHandler& factionHandler)
+//Only touches the worker itself - run for every faction at once
+void Worker::update_movement(float deltaTime)
 {
 	Entity::update(deltaTime);
 
+	//Moved by the faction's MovementCore before its entities update
+	assert(m_movement.slot.isMatchingPath(m_movement.path));
 	if (!m_movement.path.empty())
 	{
-		glm::vec3 newPosition = Globals::moveTowards(m_position.Get(), m_movement.path.back(), MOVEMENT_SPEED * deltaTime);
-		m_rotation.y = Globals::getAngle(newPosition, m_position.Get());
-		setPosition(newPosition);
+		m_rotation.y = m_movement.slot.getRotation();
+		setPosition(m_movement.slot.getPosition());
 
 		if (m_position.Get() == m_movement.path.back())
 		{
 			m_movement.path.pop_back();
+			m_movement.slot.setPath(m_position.Get(), m_rotation.y, m_movement.path);
 		}
 	}
+}
 
+void Worker::update(float, const Map& map, FactionHandler& factionHandler)
+{
 	switch (m_currentState)
 	{
 	case eWorkerState::Idle:
@@ -218,9 +272,9 @@ void Worker::update(float deltaTime, const Map& map, FactionHandler& factionHand
 		{
 			Level::add_event(GameEvent::create<AddFactionResourcesEvent>({ *m_resources, m_owningFaction->getController() }));
 			m_resources = std::nullopt;
-			if (m_mineralToHarvest)
+			if (m_mineralToHarvest.get())
 			{
-				Harvest(*m_mineralToHarvest, map);
+				Harvest(*m_mineralToHarvest.get(), map);
 			}
 			else
 			{
@@ -232,13 +286,13 @@ void Worker::update(float deltaTime, const Map& map, FactionHandler& factionHand
 	{
 		assert(m_resources <= RESOURCE_CAPACITY &&
 			m_taskTimer.isActive() &&
-			m_mineralToHarvest);
+			m_mineralToHarvest.get());
 		if (m_resources < RESOURCE_CAPACITY)
 		{
 			if (m_taskTimer.isExpired())
 			{
 				m_taskTimer.resetElaspedTime();
-				int harvestedResource = m_mineralToHarvest->extractQuantity(RESOURCE_INCREMENT);
+				int harvestedResource = m_mineralToHarvest.get()->extractQuantity(RESOURCE_INCREMENT);
 				if (harvestedResource)
 				{
 					if (!m_resources)
@@ -342,11 +396,6 @@ void Worker::update(float deltaTime, const Map& map, FactionHandler& factionHand
 	}
 	break;
 	}
-
-	if (m_taskTimer.isActive())
-	{
-		m_taskTimer.update(deltaTime);
-	}
 }
 
 void Worker::delayed_update(const Map& map, FactionHandler& factionHandler)
@@ -391,8 +440,8 @@ void Worker::delayed_update(const Map& map, FactionHandler& factionHandler)
 
 bool Worker::Harvest(const Mineral& mineral, const Map& map)
 {
-	glm::vec3 destination = PathFinding::getInstance().getClosestPositionToAABB(m_position.Get(), mineral.getAABB(), map);
-	m_mineralToHarvest = &mineral;
+	glm::vec3 destination = get_harvest_position(mineral, map);
+	m_mineralToHarvest.set(&mineral);
 	move_to(destination, map, eWorkerState::MovingToMinerals);
 	return true;
 }
@@ -416,34 +465,15 @@ bool Worker::MoveTo(const glm::vec3& position, const Map& map, const bool add_to
 	return false;
 }
 
-void Worker::revalidate_movement_path(const Map& map)
+void Worker::revalidate_movement_path(std::vector<glm::vec3>& path)
 {
-	if (!m_movement.path.empty())
-	{
-		switch (m_currentState)
-		{
-		case eWorkerState::Moving:
-		case eWorkerState::ReturningMineralsToHeadquarters:
-		case eWorkerState::MovingToBuildingPosition:
-		case eWorkerState::MovingToRepairPosition:
-			move_to(m_movement.path.front(), map, m_currentState);
-			break;
-		case eWorkerState::MovingToMinerals:
-			assert(m_mineralToHarvest);
-			Harvest(*m_mineralToHarvest, map);
-			break;
-		case eWorkerState::Idle:
-		case eWorkerState::Harvesting:
-		case eWorkerState::Building:
-		case eWorkerState::Repairing:
-			break;
-		default:
-			assert(false);
-		}
-	}
+	assert(!m_movement.path.empty());
+	glm::vec3 previousDestination = Globals::getNextPathDestination(m_movement.path, m_position.Get());
+	m_movement.path.swap(path);
+	set_movement_path(previousDestination, m_currentState);
 }
 
-void Worker::render(ShaderHandler& shaderHandler, eFactionController owningFactionController) const
+void Worker::render(ShaderHandler& shaderHandler, eFactionController owningFactionController, float interpolation) const
 {
 	if (m_resources && m_currentState != eWorkerState::Harvesting)
 	{
@@ -451,21 +481,23 @@ void Worker::render(ShaderHandler& shaderHandler, eFactionController owningFacti
 			//shaderHandler, { m_position.Get().x - 0.5f, m_position.Get().y, m_position.Get().z - 0.5f });
 	}
 
-	Entity::render(shaderHandler, owningFactionController);
+	Entity::render(shaderHandler, owningFactionController, interpolation);
 }
 
-void Worker::render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const
+#ifndef HEADLESS
+void Worker::render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const
 {
-	Entity::render_status_bars(shaderHandler, camera, windowSize);
+	Entity::render_status_bars(shaderHandler, camera, windowSize, interpolation);
 
 	if (m_taskTimer.isActive())
 	{
 		float currentTime = m_taskTimer.getElaspedTime() / m_taskTimer.getExpiredTime();
-		m_statbarSprite.render(m_position.Get(), windowSize, WORKER_PROGRESS_BAR_WIDTH,
+		m_statbarSprite.render(getRenderPosition(interpolation), windowSize, WORKER_PROGRESS_BAR_WIDTH,
 			WORKER_PROGRESS_BAR_WIDTH * currentTime, Globals::DEFAULT_PROGRESS_BAR_HEIGHT,
 			WORKER_PROGRESS_BAR_YOFFSET, shaderHandler, camera, Globals::PROGRESS_BAR_COLOR);
 	}
 }
+#endif // HEADLESS
 
 void Worker::renderBuildingCommands(ShaderHandler& shaderHandler) const
 {
@@ -502,7 +534,7 @@ void Worker::switchTo(eWorkerState newState)
 			newState != eWorkerState::ReturningMineralsToHeadquarters &&
 			newState != eWorkerState::Harvesting)
 		{
-			m_mineralToHarvest = nullptr;
+			m_mineralToHarvest.set(nullptr);
 		}
 		break;
 	case eWorkerState::Harvesting:
@@ -510,7 +542,7 @@ void Worker::switchTo(eWorkerState newState)
 			newState != eWorkerState::ReturningMineralsToHeadquarters &&
 			newState != eWorkerState::Harvesting)
 		{
-			m_mineralToHarvest = nullptr;
+			m_mineralToHarvest.set(nullptr);
 			m_taskTimer.setActive(false);
 			m_taskTimer.resetElaspedTime();
 		}
@@ -570,10 +602,10 @@ void Worker::switchTo(eWorkerState newState)
 		break;
 	case eWorkerState::MovingToMinerals:
 		m_taskTimer.setActive(false);
-		assert(m_mineralToHarvest);
+		assert(m_mineralToHarvest.get());
 		break;
 	case eWorkerState::Harvesting:
-		assert(m_mineralToHarvest);
+		assert(m_mineralToHarvest.get());
 		m_taskTimer.resetExpirationTime(HARVEST_EXPIRATION_TIME);
 		m_taskTimer.setActive(true);
 		m_movement.path.clear();
@@ -594,33 +626,41 @@ void Worker::switchTo(eWorkerState newState)
 	}
 
 	m_taskTimer.resetElaspedTime();
-	
+	if (m_movement.path.empty())
+	{
+		broadcast<GameMessages::SetMovementPath>({ m_movement.path, m_position.Get(), getID(), m_owningFaction->getController() });
+	}
+	m_movement.slot.setPath(m_position.Get(), m_rotation.y, m_movement.path);
 }
 
 bool Worker::move_to(const glm::vec3& destination, const Map& map, eWorkerState state)
 {
 	glm::vec3 previousDestination = Globals::getNextPathDestination(m_movement.path, m_position.Get());
 	PathFinding::getInstance().getPathToPosition(*this, destination, m_movement.path, map, createAdjacentPositions(map));
-	if (!m_movement.path.empty())
-	{
-		switchTo(state);
-		return true;
-	}
-	else
+	return set_movement_path(previousDestination, state);
+}
+
+bool Worker::set_movement_path(const glm::vec3& previousDestination, eWorkerState state)
+{
+	if (m_movement.path.empty())
 	{
-		if (previousDestination != m_position.Get())
-		{
-			m_movement.path.push_back(previousDestination);
-			switchTo(state);
-			return true;
-		}
-		else
+		if (previousDestination == m_position.Get())
 		{
 			switchTo(eWorkerState::Idle);
+			return false;
 		}
+
+		m_movement.path.push_back(previousDestination);
 	}
 
-	return false;
+	switchTo(state);
+	broadcast<GameMessages::SetMovementPath>({ m_movement.path, m_position.Get(), getID(), m_owningFaction->getController() });
+	return true;
+}
+
+glm::vec3 Worker::get_harvest_position(const Mineral& mineral, const Map& map) const
+{
+	return PathFinding::getInstance().getClosestPositionToAABB(m_position.Get(), mineral.getAABB(), map);
 }
 
 Entity* Worker::CreateBuilding(const WorkerScheduledBuilding& scheduled_building)
@@ -649,24 +689,5 @@ bool Worker::move_to(const glm::vec3& destination, const Map& map, const AABB& i
 {
 	glm::vec3 previousDestination = Globals::getNextPathDestination(m_movement.path, m_position.Get());
 	PathFinding::getInstance().getPathToPosition(*this, destination, m_movement.path, map, createAdjacentPositions(map, ignoreAABB));
-	if (!m_movement.path.empty())
-	{
-		switchTo(state);
-		return true;
-	}
-	else
-	{
-		if (previousDestination != m_position.Get())
-		{
-			m_movement.path.push_back(previousDestination);
-			switchTo(state);
-			return true;
-		}
-		else
-		{
-			switchTo(eWorkerState::Idle);
-		}
-	}
-
-	return false;
+	return set_movement_path(previousDestination, state);
 }
\ No newline at end of file
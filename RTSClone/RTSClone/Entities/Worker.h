@@ -3,6 +3,7 @@
 #include "Entity.h"
 #include "Movement.h"
 #include "Core/Timer.h"
+#include "Core/MineralReservations.h"
 #include "Model/AdjacentPositions.h"
 #include "TargetEntity.h"
 #include <queue>
@@ -39,6 +40,7 @@ struct WorkerScheduledBuilding
 };
 
 struct EntityToSpawnFromBuilding;
+struct PathQuery;
 struct Base;
 class Headquarters;
 class Faction;
@@ -49,6 +51,7 @@ public:
 	Worker(Faction& owningFaction, const EntityToSpawnFromBuilding& entity_to_spawn, const Map& map);
 	Worker(Worker&&) noexcept = default;
 	Worker& operator=(Worker&&) noexcept = default;
+	~Worker();
 	
 	const Mineral* getMineralToHarvest() const;
 	const std::deque<WorkerScheduledBuilding>& get_scheduled_buildings() const;
@@ -59,6 +62,7 @@ public:
 	bool isRepairing() const;
 	bool isInBuildQueue(eEntityType entityType) const;
 	bool is_group_selectable() const override;
+	bool get_movement_path_query(const Map& map, PathQuery& query) const;
 	int extractResources();	
 
 	void clear_destinations();
@@ -69,11 +73,14 @@ public:
 	void ReturnMineralsToHeadquarters(const Headquarters& headquarters, const Map& map) override;
 	bool MoveTo(const glm::vec3& position, const Map& map, const bool add_to_destinations) override;
 	void delayed_update(const Map& map, FactionHandler& factionHandler);
+	void update_movement(float deltaTime);
 	void update(float deltaTime, const Map& map, FactionHandler& factionHandler);
-	void revalidate_movement_path(const Map& map);
+	void revalidate_movement_path(std::vector<glm::vec3>& path);
 
-	void render(ShaderHandler& shaderHandler, eFactionController owningFactionController) const;
-	void render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const override;
+	void render(ShaderHandler& shaderHandler, eFactionController owningFactionController, float interpolation) const;
+#ifndef HEADLESS
+	void render_status_bars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const override;
+#endif // HEADLESS
 	void renderBuildingCommands(ShaderHandler& shaderHandler) const;
 #ifdef RENDER_PATHING
 	void render_path(ShaderHandler& shaderHandler);
@@ -87,10 +94,12 @@ private:
 	std::optional<int> m_repairTargetEntity				= {};
 	std::optional<int> m_resources						= {};
 	Timer m_taskTimer									= {};
-	const Mineral* m_mineralToHarvest					= nullptr;
+	MineralReservation m_mineralToHarvest				= {};
 
 	void switchTo(eWorkerState newState);
 	bool move_to(const glm::vec3& destination, const Map& map, const AABB& ignoreAABB, eWorkerState state);
 	bool move_to(const glm::vec3& destination, const Map& map, eWorkerState state);
+	bool set_movement_path(const glm::vec3& previousDestination, eWorkerState state);
+	glm::vec3 get_harvest_position(const Mineral& mineral, const Map& map) const;
 	Entity* CreateBuilding(const WorkerScheduledBuilding& scheduled_building);
 };
\ No newline at end of file
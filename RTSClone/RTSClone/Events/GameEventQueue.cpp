@@ -0,0 +1,100 @@
+#include "Events/GameEventQueue.h"
+#include <assert.h>
+#include <numeric>
+
+namespace
+{
+	size_t getFactionIndex(eFactionController factionController)
+	{
+		assert(factionController != eFactionController::None);
+		return static_cast<size_t>(factionController);
+	}
+
+	template <typename T, size_t Size>
+	size_t getTotalSize(const std::array<std::vector<T>, Size>& buckets)
+	{
+		return std::accumulate(buckets.cbegin(), buckets.cend(), size_t(0), [](size_t size, const auto& bucket)
+		{
+			return size + bucket.size();
+		});
+	}
+}
+
+GameEventQueue::GameEventQueue()
+	: m_orderedEvents(),
+	m_takeDamageEvents(),
+	m_entityIdleEvents(),
+	m_spawnProjectileEvents()
+{}
+
+bool GameEventQueue::isEmpty() const
+{
+	return getSize() == 0;
+}
+
+size_t GameEventQueue::getSize() const
+{
+	return m_orderedEvents.size() + getTotalSize(m_takeDamageEvents) + getTotalSize(m_entityIdleEvents) +
+		m_spawnProjectileEvents.size();
+}
+
+const std::vector<GameEvent>& GameEventQueue::getOrderedEvents() const
+{
+	return m_orderedEvents;
+}
+
+std::vector<TakeDamageEvent>& GameEventQueue::getTakeDamageEvents(eFactionController factionController)
+{
+	return m_takeDamageEvents[getFactionIndex(factionController)];
+}
+
+const std::vector<EntityIdleEvent>& GameEventQueue::getEntityIdleEvents(eFactionController factionController) const
+{
+	return m_entityIdleEvents[getFactionIndex(factionController)];
+}
+
+const std::vector<SpawnProjectileEvent>& GameEventQueue::getSpawnProjectileEvents() const
+{
+	return m_spawnProjectileEvents;
+}
+
+void GameEventQueue::add(const GameEvent& gameEvent)
+{
+	switch (gameEvent.type)
+	{
+	case eGameEventType::TakeDamage:
+		m_takeDamageEvents[getFactionIndex(gameEvent.data.takeDamage.targetFaction)].push_back(gameEvent.data.takeDamage);
+		break;
+	case eGameEventType::EntityIdle:
+		m_entityIdleEvents[getFactionIndex(gameEvent.data.entityIdle.faction)].push_back(gameEvent.data.entityIdle);
+		break;
+	case eGameEventType::SpawnProjectile:
+		m_spawnProjectileEvents.push_back(gameEvent.data.spawnProjectile);
+		break;
+	default:
+		m_orderedEvents.push_back(gameEvent);
+		break;
+	}
+}
+
+void GameEventQueue::swap(GameEventQueue& other)
+{
+	m_orderedEvents.swap(other.m_orderedEvents);
+	m_takeDamageEvents.swap(other.m_takeDamageEvents);
+	m_entityIdleEvents.swap(other.m_entityIdleEvents);
+	m_spawnProjectileEvents.swap(other.m_spawnProjectileEvents);
+}
+
+void GameEventQueue::clear()
+{
+	m_orderedEvents.clear();
+	for (auto& takeDamageEvents : m_takeDamageEvents)
+	{
+		takeDamageEvents.clear();
+	}
+	for (auto& entityIdleEvents : m_entityIdleEvents)
+	{
+		entityIdleEvents.clear();
+	}
+	m_spawnProjectileEvents.clear();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Core/FactionController.h"
+#include "Events/GameEvents.h"
+#include <array>
+#include <vector>
+
+//Game events raised during a frame, handled together at the end of it.
+//Damage and idle events are held per faction they're aimed at so each faction handles all of its own in one batch,
+//projectiles are spawned in one batch. Every other event is rare and kept in the order it was raised.
+//Handling swaps a queue out whole, events raised meanwhile go into the emptied one for the next frame.
+//Cleared buckets keep their storage so once a game has settled raising an event doesn't allocate.
+class GameEventQueue
+{
+public:
+	GameEventQueue();
+
+	bool isEmpty() const;
+	size_t getSize() const;
+	const std::vector<GameEvent>& getOrderedEvents() const;
+	std::vector<TakeDamageEvent>& getTakeDamageEvents(eFactionController factionController);
+	const std::vector<EntityIdleEvent>& getEntityIdleEvents(eFactionController factionController) const;
+	const std::vector<SpawnProjectileEvent>& getSpawnProjectileEvents() const;
+
+	void add(const GameEvent& gameEvent);
+	void swap(GameEventQueue& other);
+	void clear();
+
+private:
+	static constexpr size_t FACTION_COUNT = static_cast<size_t>(eFactionController::Max) + 1;
+
+	std::vector<GameEvent> m_orderedEvents									= {};
+	std::array<std::vector<TakeDamageEvent>, FACTION_COUNT> m_takeDamageEvents	= {};
+	std::array<std::vector<EntityIdleEvent>, FACTION_COUNT> m_entityIdleEvents	= {};
+	std::vector<SpawnProjectileEvent> m_spawnProjectileEvents				= {};
+};
+
+//Events handled in the last frame
+struct GameEventStats
+{
+	int handled			= 0;
+	int takeDamage		= 0;
+	double microseconds	= 0.0;
+};
@@ -23,9 +23,14 @@ enum class eGameEventType
 	AddFactionResources
 };
 
+//Bounds of the map area that changed
 struct RevalidateMovementPathsEvent
 {
 	static const eGameEventType type = { eGameEventType::RevalidateMovementPaths };
+	float left;
+	float right;
+	float forward;
+	float back;
 };
 
 struct ResetTargetEntityGUIEvent
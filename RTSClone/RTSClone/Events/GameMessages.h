@@ -3,12 +3,15 @@
 #include "Entities/EntityType.h"
 #include "Core/FactionController.h"
 #include "Core/Globals.h"
+#include "Events/GameMessenger.h"
+#include <vector>
 
 class Entity;
 class Mineral;
 class AABB;
 class Worker;
 class Map;
+class PathSegmentIndex;
 //Caller is not meant to go out of scope. 
 namespace GameMessages
 {
@@ -38,6 +41,15 @@ namespace GameMessages
 		const int ID = Globals::INVALID_ENTITY_ID;
 	};
 
+	//Path is stored reversed from position, an empty path removes the entity
+	struct SetMovementPath
+	{
+		const std::vector<glm::vec3>& path;
+		const glm::vec3& position;
+		const int ID = Globals::INVALID_ENTITY_ID;
+		const eFactionController factionController = eFactionController::None;
+	};
+
 	struct MapSize 
 	{
 		const glm::ivec2 mapSize;
@@ -69,4 +81,25 @@ namespace GameMessages
 	{
 		const Mineral& mineral;
 	};
-}
\ No newline at end of file
+}
+
+template <>
+struct StaticListener<GameMessages::AddUnitPositionToMap>
+{
+	using Receiver = Map;
+	static void receive(Map& map, GameMessages::AddUnitPositionToMap&& message);
+};
+
+template <>
+struct StaticListener<GameMessages::RemoveUnitPositionFromMap>
+{
+	using Receiver = Map;
+	static void receive(Map& map, GameMessages::RemoveUnitPositionFromMap&& message);
+};
+
+template <>
+struct StaticListener<GameMessages::SetMovementPath>
+{
+	using Receiver = PathSegmentIndex;
+	static void receive(PathSegmentIndex& pathSegmentIndex, GameMessages::SetMovementPath&& message);
+};
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <assert.h>
 #include <algorithm>
 #include <optional>
+#include <type_traits>
 #include <utility>
 
 template <typename Message>
@@ -61,10 +62,60 @@ private:
 	std::vector<Listener> m_listeners = {};
 };
 
+//Messages sent on every unit path step have a single receiver known at compile time - specialising StaticListener
+//names its Receiver and declares a receive function, defined alongside the receiver, which broadcasting calls directly
+//rather than going through a std::function per listener. Every other message keeps its Broadcaster.
+template <typename Message>
+struct StaticListener;
+
+template <typename Message, typename = void>
+constexpr bool IS_STATIC_MESSAGE = false;
+
+template <typename Message>
+constexpr bool IS_STATIC_MESSAGE<Message, std::void_t<typename StaticListener<Message>::Receiver>> = true;
+
+template <typename Message>
+class StaticBroadcaster
+{
+public:
+	using Receiver = typename StaticListener<Message>::Receiver;
+
+	static void subscribe(Receiver& receiver)
+	{
+		assert(!m_receiver);
+		m_receiver = &receiver;
+	}
+
+	static void unsubscribe(Receiver& receiver)
+	{
+		assert(m_receiver == &receiver);
+		if (m_receiver == &receiver)
+		{
+			m_receiver = nullptr;
+		}
+	}
+
+	static void broadcast(Message&& message)
+	{
+		assert(m_receiver);
+		StaticListener<Message>::receive(*m_receiver, std::move(message));
+	}
+
+private:
+	inline static Receiver* m_receiver = nullptr;
+};
+
 template <typename Message>
 void broadcast(Message&& message)
 {
-	Broadcaster<Message>::getInstance().broadcast(std::forward<Message>(message));
+	if constexpr (IS_STATIC_MESSAGE<std::decay_t<Message>>)
+	{
+		StaticBroadcaster<std::decay_t<Message>>::broadcast(std::forward<Message>(message));
+	}
+	else
+	{
+		Broadcaster<Message>::getInstance().broadcast(std::forward<Message>(message));
+	}
 }
 
 template <typename Message>
@@ -88,4 +139,37 @@ public:
 
 private:
 	UniqueID id{};
+};
+
+template <typename Message>
+class StaticBroadcasterSub
+{
+public:
+	using Receiver = typename StaticListener<Message>::Receiver;
+
+	StaticBroadcasterSub(Receiver& receiver)
+		: m_receiver(&receiver)
+	{
+		StaticBroadcaster<Message>::subscribe(receiver);
+	}
+	StaticBroadcasterSub(const StaticBroadcasterSub&) = delete;
+	StaticBroadcasterSub& operator=(const StaticBroadcasterSub&) = delete;
+	StaticBroadcasterSub(StaticBroadcasterSub&& rhs) noexcept
+		: m_receiver(std::exchange(rhs.m_receiver, nullptr))
+	{}
+	StaticBroadcasterSub& operator=(StaticBroadcasterSub&& rhs) noexcept
+	{
+		std::swap(m_receiver, rhs.m_receiver);
+		return *this;
+	}
+	~StaticBroadcasterSub()
+	{
+		if (m_receiver)
+		{
+			StaticBroadcaster<Message>::unsubscribe(*m_receiver);
+		}
+	}
+
+private:
+	Receiver* m_receiver = nullptr;
 };
\ No newline at end of file
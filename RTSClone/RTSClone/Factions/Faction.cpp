@@ -6,7 +6,9 @@
 #include "Core/Level.h"
 #include "Events/GameMessages.h"
 #include "Events/GameMessenger.h"
+#include <algorithm>
 #include <numeric>
+#include <tuple>
 
 namespace
 {
@@ -24,20 +26,23 @@ namespace
 
 Faction::Faction(eFactionController factionController, const glm::vec3& hqStartingPosition,
     int startingResources, int startingPopulationCap)
-    : m_controller(factionController),
+    : m_units(Globals::MAX_UNITS),
+    m_workers(Globals::MAX_WORKERS),
+    m_supplyDepots(Globals::MAX_SUPPLY_DEPOTS),
+    m_barracks(Globals::MAX_BARRACKS),
+    m_turrets(Globals::MAX_TURRETS),
+    m_headquarters(Globals::MAX_HEADQUARTERS),
+    m_laboratories(Globals::MAX_LABORATORIES),
+    m_controller(factionController),
     m_currentResourceAmount(startingResources),
     m_currentPopulationLimit(startingPopulationCap)
 {
     m_allEntities.reserve(std::accumulate(MAX_ENTITY_QUANTITIES.cbegin(), MAX_ENTITY_QUANTITIES.cend(), 0));
-    m_units.reserve(Globals::MAX_UNITS);
-    m_workers.reserve(Globals::MAX_WORKERS);
-    m_headquarters.reserve(Globals::MAX_HEADQUARTERS);
-    m_supplyDepots.reserve(Globals::MAX_SUPPLY_DEPOTS);
-    m_barracks.reserve(Globals::MAX_BARRACKS);
-    m_turrets.reserve(Globals::MAX_TURRETS);
 
     Entity& entity = m_headquarters.emplace_back(Position{ hqStartingPosition, GridLockActive::True }, *this);
-    m_allEntities.push_back(&entity);
+    m_allEntities.push_back(entity);
+    m_entityIndex.add(entity);
+    m_entityLookup.set(entity);
 }
 
 void Faction::on_entity_removal(const Entity& entity)
@@ -48,13 +53,10 @@ void Faction::on_entity_removal(const Entity& entity)
 
 Worker* Faction::GetWorker(const int id)
 {
-    const auto worker = std::find_if(m_workers.begin(), m_workers.end(), [id](const auto& worker)
+    Entity* entity = m_entityLookup.get(id);
+    if (entity && entity->getEntityType() == eEntityType::Worker)
     {
-        return worker.getID() == id;
-    });
-    if (worker != m_workers.end())
-    {
-        return &(*worker);
+        return static_cast<Worker*>(entity);
     }
 
     return nullptr;
@@ -112,161 +114,35 @@ eFactionController Faction::getController() const
     return m_controller;
 }
 
-const std::vector<Headquarters>& Faction::GetHeadquarters() const
+const EntityPool<Headquarters>& Faction::GetHeadquarters() const
 {
     return m_headquarters;
 }
 
-const std::vector<Entity*>& Faction::getEntities() const
+const EntityList& Faction::getEntities() const
 {
     return m_allEntities;
 }
 
 const Entity* Faction::getEntity(const glm::vec3& position, float maxDistance, bool prioritizeUnits) const
 {
-    const Entity* closestEntity = nullptr;
-    if (prioritizeUnits)
-    {
-        float closestEntityDistance = maxDistance * maxDistance;
-        for (const auto& entity : m_allEntities)
-        {
-            float distance = Globals::getSqrDistance(entity->getPosition(), position);
-            if (!closestEntity && distance < closestEntityDistance)
-            {
-                closestEntity = &*entity;
-                closestEntityDistance = distance;
-            }
-            else if (closestEntity && Globals::BUILDING_TYPES.isMatch(closestEntity->getEntityType()) &&
-                Globals::UNIT_TYPES.isMatch(entity->getEntityType()) &&
-                Globals::getSqrDistance(entity->getPosition(), position) < maxDistance * maxDistance)
-            {
-                closestEntity = &*entity;
-                closestEntityDistance = distance;
-            }
-            else if (closestEntity && distance < closestEntityDistance)
-            {
-                closestEntity = &*entity;
-                closestEntityDistance = distance;
-            }
-        }
-    }
-    else
-    {
-        float closestEntityDistance = maxDistance * maxDistance;
-        for (const auto& entity : m_allEntities)
-        {
-            float distance = Globals::getSqrDistance(entity->getPosition(), position);
-            if (distance < closestEntityDistance)
-            {
-                closestEntity = &*entity;
-                closestEntityDistance = distance;
-            }
-        }
-    }
-
-    return closestEntity;
-}
-
-const Entity* Faction::getEntity(const AABB& aabb, int entityID) const
-{
-    const auto entity = std::find_if(m_allEntities.cbegin(), m_allEntities.cend(), [&aabb, entityID](auto entity)
-    {
-        return entity->getID() == entityID && entity->getAABB().contains(aabb);
-    });
-
-    if (entity != m_allEntities.cend())
-    {
-        return (*entity);
-    }
-    return nullptr;
+    return m_entityIndex.getClosestEntity(position, maxDistance, prioritizeUnits);
 }
 
 const Entity* Faction::getEntity(const glm::vec3& position) const
 {
-    const auto entity = std::find_if(m_allEntities.cbegin(), m_allEntities.cend(), [&position](const auto& entity)
-    {
-        return entity->getAABB().contains(position);
-    });
-    if (entity != m_allEntities.cend())
-    {
-        return (*entity);
-    }
-    return nullptr;
+    return m_entityIndex.getEntity(position);
 }
 
-void Faction::handleEvent(const GameEvent& gameEvent, const Map& map, FactionHandler& factionHandler, const BaseHandler& baseHandler)
+void Faction::handleEvent(const GameEvent& gameEvent)
 {
     switch (gameEvent.type)
     {
-    case eGameEventType::TakeDamage:
-    {
-        assert(gameEvent.data.takeDamage.senderFaction != m_controller);
-        const auto entity = std::find_if(m_allEntities.begin(), m_allEntities.end(), [id = gameEvent.data.takeDamage.targetID](const auto& entity)
-        {
-            return entity->getID() == id;
-        });
-        if (entity == m_allEntities.end())
-        {
-            break;
-        }
-
-        (*entity)->takeDamage(gameEvent.data.takeDamage, map);
-        if (!(*entity)->isDead())
-        {
-            on_entity_taken_damage(gameEvent.data.takeDamage, *(*entity), map, factionHandler);
-            break;
-        }
-        switch ((*entity)->getEntityType())
-        {
-        case eEntityType::Worker:
-            removeEntity<Worker>(m_workers, entity);
-            break;
-        case eEntityType::Unit:
-            removeEntity<Unit>(m_units, entity);
-            break;
-        case eEntityType::SupplyDepot:
-            removeEntity<SupplyDepot>(m_supplyDepots, entity);
-            break;
-        case eEntityType::Barracks:
-            removeEntity<Barracks>(m_barracks, entity);
-            break;
-        case eEntityType::Headquarters:
-            removeEntity<Headquarters>(m_headquarters, entity);
-            break;
-        case eEntityType::Turret:
-            removeEntity<Turret>(m_turrets, entity);
-            break;
-        case eEntityType::Laboratory:
-            removeEntity<Laboratory>(m_laboratories, entity);
-            break;
-        default:
-            assert(false);
-        }
-    }
-        break;
-    case eGameEventType::RevalidateMovementPaths:
-        for (auto& unit : m_units)
-        {
-            unit.revalidate_movement_path(map);
-        }
-
-        for (auto& worker : m_workers)
-        {
-            worker.revalidate_movement_path(map);
-        }
-        break;
     case eGameEventType::RepairEntity:
-    {
-        int entityID = gameEvent.data.repairEntity.entityID;
-        auto entity = std::find_if(m_allEntities.begin(), m_allEntities.end(), [entityID](const auto& entity)
-        {
-            return entity->getID() == entityID;
-        });
-        if (entity != m_allEntities.end())
+        if (Entity* entity = m_entityLookup.get(gameEvent.data.repairEntity.entityID))
         {
-            (*entity)->repair();
+            entity->repair();
         }
-    }
         break;
     case eGameEventType::IncreaseFactionShield:
         if (m_currentShieldAmount < Globals::MAX_FACTION_SHIELD_AMOUNT &&
@@ -280,112 +156,85 @@ void Faction::handleEvent(const GameEvent& gameEvent, const Map& map, FactionHan
         }
         break;
     case eGameEventType::ForceSelfDestructEntity:
-    {
-        const auto entity = std::find_if(m_allEntities.begin(), m_allEntities.end(), [id = gameEvent.data.forceSelfDestructEntity.entityID](auto& entity)
-        {
-            return entity->getID() == id;
-        });
-        if (entity == m_allEntities.end())
-        {
-            break;
-        }
-
-        switch (gameEvent.data.forceSelfDestructEntity.entityType)
+        if (Entity* entity = m_entityLookup.get(gameEvent.data.forceSelfDestructEntity.entityID))
         {
-        case eEntityType::Worker:
-            removeEntity<Worker>(m_workers, entity);
-            break;
-        case eEntityType::Unit:
-            removeEntity<Unit>(m_units, entity);
-            break;
-        case eEntityType::SupplyDepot:
-            removeEntity<SupplyDepot>(m_supplyDepots, entity);
-            break;
-        case eEntityType::Barracks:
-            removeEntity<Barracks>(m_barracks, entity);
-            break;
-        case eEntityType::Headquarters:
-            removeEntity<Headquarters>(m_headquarters, entity);
-            break;
-        case eEntityType::Turret:
-            removeEntity<Turret>(m_turrets, entity);
-            break;
-        case eEntityType::Laboratory:
-            removeEntity<Laboratory>(m_laboratories, entity);
-            break;
-        default:
-            assert(false);
+            assert(entity->getEntityType() == gameEvent.data.forceSelfDestructEntity.entityType);
+            removeEntity(*entity);
         }
         break;
-    }
-    case eGameEventType::EntityIdle:
-    {
-        const int entityID = gameEvent.data.entityIdle.entityID;
-        auto entity = std::find_if(m_allEntities.begin(), m_allEntities.end(), [entityID](const auto& entity)
-        {
-            return entity->getID() == entityID;
-        });
-        if (entity != m_allEntities.cend())
-        {
-            on_entity_idle(*(*entity), map, factionHandler, baseHandler);
-        }
-    }
-        break;
     case eGameEventType::AddFactionResources:
         m_currentResourceAmount += gameEvent.data.addFactionResources.quantity;
         break;
+    default:
+        break;
     }
 }
 
+//Workers are handled in the order they were created, so the ones handled before one are those with lower IDs
 void Faction::handleWorkerCollisions(const Map& map)
 {
-    static std::vector<std::reference_wrapper<const Worker>> handledWorkers;
-
-    auto foundWorker = [](int ID) -> bool
+    m_workerOccupancy.clear();
+    for (const auto& worker : m_workers)
     {
-        auto worker = std::find_if(handledWorkers.cbegin(), handledWorkers.cend(), [ID](const auto& worker)
-        {
-            return worker.get().getID() == ID;
-        });
-        return worker != handledWorkers.cend();
-    };
+        m_workerOccupancy.add(worker);
+    }
+    m_workerOccupancy.sortByNode();
 
     for (auto& worker : m_workers)
     {
-        if (worker.getCurrentState() == eWorkerState::Idle)
+        if (worker.getCurrentState() != eWorkerState::Idle)
         {
-            if (map.isCollidable(worker.getPosition()))
-            {
-                glm::vec3 destination(0.f);
-                if (PathFinding::getInstance().getClosestAvailablePosition(worker, m_workers, map, destination))
-                {
-                    worker.MoveTo(destination, map, false);
-                }
-            }
-            else
+            continue;
+        }
+
+        bool overlapping = map.isCollidable(worker.getPosition());
+        if (!overlapping)
+        {
+            m_workerOccupancy.getWorkers(worker.getAABB(), m_overlappingWorkers);
+            overlapping = std::any_of(m_overlappingWorkers.cbegin(), m_overlappingWorkers.cend(), [&worker](const Worker* otherWorker)
             {
-                for (const auto& otherWorker : m_workers)
-                {
-                    if (worker.getID() != otherWorker.getID() &&
-                        foundWorker(otherWorker.getID()) &&
-                        otherWorker.getCurrentState() == eWorkerState::Idle &&
-                        worker.getAABB().contains(otherWorker.getAABB()))
-                    {
-                        glm::vec3 destination(0.f);
-                        if (PathFinding::getInstance().getClosestAvailablePosition(worker, m_workers, map, destination))
-                        {
-                            worker.MoveTo(destination, map, false);
-                            break;
-                        }
-                    }
-                }
-            }
+                return otherWorker->getID() < worker.getID() &&
+                    otherWorker->getCurrentState() == eWorkerState::Idle;
+            });
         }
 
-        handledWorkers.push_back(worker);
+        glm::vec3 destination(0.f);
+        if (overlapping && PathFinding::getInstance().getClosestAvailablePosition(worker, m_workerOccupancy, map, destination) &&
+            worker.MoveTo(destination, map, false))
+        {
+            m_workerOccupancy.addDestination(worker, destination);
+        }
     }
+}
 
-    handledWorkers.clear();
+void Faction::removeEntity(Entity& entity)
+{
+    switch (entity.getEntityType())
+    {
+    case eEntityType::Worker:
+        removeEntity<Worker>(m_workers, entity);
+        break;
+    case eEntityType::Unit:
+        removeEntity<Unit>(m_units, entity);
+        break;
+    case eEntityType::SupplyDepot:
+        removeEntity<SupplyDepot>(m_supplyDepots, entity);
+        break;
+    case eEntityType::Barracks:
+        removeEntity<Barracks>(m_barracks, entity);
+        break;
+    case eEntityType::Headquarters:
+        removeEntity<Headquarters>(m_headquarters, entity);
+        break;
+    case eEntityType::Turret:
+        removeEntity<Turret>(m_turrets, entity);
+        break;
+    case eEntityType::Laboratory:
+        removeEntity<Laboratory>(m_laboratories, entity);
+        break;
+    default:
+        assert(false);
+    }
 }
 
 void Faction::on_entity_creation(Entity& entity)
@@ -397,7 +246,9 @@ void Faction::on_entity_creation(Entity& entity)
         m_currentPopulationLimit += Globals::POPULATION_INCREMENT;
     }
 
-    m_allEntities.push_back(&entity);
+    m_allEntities.push_back(entity);
+    m_entityIndex.add(entity);
+    m_entityLookup.set(entity);
 }
 
 const Headquarters* Faction::get_closest_headquarters(const glm::vec3& position) const
@@ -419,15 +270,12 @@ const Headquarters* Faction::get_closest_headquarters(const glm::vec3& position)
 
 const Entity* Faction::get_entity(const int id) const
 {
-    auto entity = std::find_if(m_allEntities.cbegin(), m_allEntities.cend(), [id](const auto& entity)
-    {
-        return entity->getID() == id;
-    });
-    if (entity != m_allEntities.cend())
-    {
-        return &*(*entity);
-    }
-    return nullptr;
+    return m_entityLookup.get(id);
+}
+
+Entity* Faction::get_entity(const int id)
+{
+    return m_entityLookup.get(id);
 }
 
 Barracks* Faction::CreateBarracks(const WorkerScheduledBuilding& scheduled_building)
@@ -455,6 +303,74 @@ SupplyDepot* Faction::CreateSupplyDepot(const WorkerScheduledBuilding& scheduled
     return CreateEntity(m_supplyDepots, scheduled_building.entityType, scheduled_building.position, *this);
 }
 
+//Sorted by target so every entity hit is looked up once however many hits it took
+void Faction::handleEvents(std::vector<TakeDamageEvent>& takeDamageEvents, const Map& map, FactionHandler& factionHandler)
+{
+    std::sort(takeDamageEvents.begin(), takeDamageEvents.end(), [](const auto& a, const auto& b)
+    {
+        return std::tie(a.targetID, a.senderID, a.damage) < std::tie(b.targetID, b.senderID, b.damage);
+    });
+
+    for (auto gameEvent = takeDamageEvents.cbegin(); gameEvent != takeDamageEvents.cend();)
+    {
+        const int targetID = gameEvent->targetID;
+        Entity* entity = m_entityLookup.get(targetID);
+        for (; gameEvent != takeDamageEvents.cend() && gameEvent->targetID == targetID; ++gameEvent)
+        {
+            assert(gameEvent->senderFaction != m_controller);
+            if (!entity)
+            {
+                continue;
+            }
+
+            entity->takeDamage(*gameEvent, map);
+            if (entity->isDead())
+            {
+                removeEntity(*entity);
+                entity = nullptr;
+            }
+            else
+            {
+                on_entity_taken_damage(*gameEvent, *entity, map, factionHandler);
+            }
+        }
+    }
+}
+
+void Faction::handleEvents(const std::vector<EntityIdleEvent>& entityIdleEvents, const Map& map, FactionHandler& factionHandler,
+    const BaseHandler& baseHandler)
+{
+    for (const auto& gameEvent : entityIdleEvents)
+    {
+        if (Entity* entity = m_entityLookup.get(gameEvent.entityID))
+        {
+            on_entity_idle(*entity, map, factionHandler, baseHandler);
+        }
+    }
+}
+
+//Reads and writes nothing outside the faction, so every faction can move at once before any of them update
+void Faction::update_movement(float deltaTime, const Map& map, const LocalAvoidance* localAvoidance)
+{
+    if (localAvoidance)
+    {
+        m_movementCore.avoid(*localAvoidance, map, deltaTime);
+    }
+
+    m_movementCore.integrate(deltaTime);
+    for (auto& unit : m_units)
+    {
+        unit.update_movement(deltaTime);
+        m_entityIndex.update(unit);
+    }
+
+    for (auto& worker : m_workers)
+    {
+        worker.update_movement(deltaTime);
+        m_entityIndex.update(worker);
+    }
+}
+
 void Faction::update(float deltaTime, const Map& map, FactionHandler& factionHandler, const BaseHandler& baseHandler)
 {
     for (auto& unit : m_units)
@@ -493,56 +409,148 @@ void Faction::update(float deltaTime, const Map& map, FactionHandler& factionHan
     }
 }
 
-void Faction::delayed_update(const Map& map, FactionHandler& factionHandler)
+//Only the units and workers whose ID falls into the bucket - the rest get theirs on the other ticks
+void Faction::find_targets_in_range(const Faction& opposingFaction, int bucket, int bucketCount)
 {
+    assert(bucket >= 0 && bucket < bucketCount && &opposingFaction != this);
     for (auto& unit : m_units)
     {
-        unit.delayed_update(factionHandler, map);
+        if (unit.getID() % bucketCount == bucket)
+        {
+            unit.find_target_in_range(opposingFaction);
+        }
+    }
+}
+
+void Faction::delayed_update(const Map& map, FactionHandler& factionHandler, int bucket, int bucketCount)
+{
+    assert(bucket >= 0 && bucket < bucketCount);
+    for (auto& unit : m_units)
+    {
+        if (unit.getID() % bucketCount == bucket)
+        {
+            unit.delayed_update(factionHandler, map);
+        }
     }
 
     for (auto& worker : m_workers)
     {
-        worker.delayed_update(map, factionHandler);
+        if (worker.getID() % bucketCount == bucket)
+        {
+            worker.delayed_update(map, factionHandler);
+        }
+    }
+
+    if (static_cast<int>(m_controller) % bucketCount == bucket)
+    {
+        handleWorkerCollisions(map);
+    }
+}
+
+const std::vector<glm::vec3>* Faction::get_movement_path(const int entityID) const
+{
+    const Entity* entity = m_entityLookup.get(entityID);
+    if (!entity)
+    {
+        return nullptr;
+    }
+
+    switch (entity->getEntityType())
+    {
+    case eEntityType::Unit:
+        return &static_cast<const Unit*>(entity)->getMovementPath();
+    case eEntityType::Worker:
+        return &static_cast<const Worker*>(entity)->getMovementPath();
+    default:
+        return nullptr;
+    }
+}
+
+MovementCore& Faction::get_movement_core()
+{
+    return m_movementCore;
+}
+
+MineralReservations& Faction::get_mineral_reservations()
+{
+    return m_mineralReservations;
+}
+
+bool Faction::get_movement_path_query(const int entityID, const Map& map, PathQuery& query) const
+{
+    const Entity* entity = m_entityLookup.get(entityID);
+    if (!entity)
+    {
+        return false;
     }
 
-    handleWorkerCollisions(map);
+    switch (entity->getEntityType())
+    {
+    case eEntityType::Unit:
+        return static_cast<const Unit*>(entity)->get_movement_path_query(map, query);
+    case eEntityType::Worker:
+        return static_cast<const Worker*>(entity)->get_movement_path_query(map, query);
+    default:
+        return false;
+    }
 }
 
-void Faction::render(ShaderHandler& shaderHandler) const
+void Faction::revalidate_movement_path(const int entityID, const Map& map, std::vector<glm::vec3>& path)
+{
+    Entity* entity = m_entityLookup.get(entityID);
+    if (!entity)
+    {
+        return;
+    }
+
+    switch (entity->getEntityType())
+    {
+    case eEntityType::Unit:
+        static_cast<Unit*>(entity)->revalidate_movement_path(map, path);
+        break;
+    case eEntityType::Worker:
+        static_cast<Worker*>(entity)->revalidate_movement_path(path);
+        break;
+    default:
+        break;
+    }
+}
+
+void Faction::render(ShaderHandler& shaderHandler, float interpolation) const
 {
     for (const auto& unit : m_units)
     {
-        unit.render(shaderHandler, m_controller);
+        unit.render(shaderHandler, m_controller, interpolation);
     }
 
     for (const auto& worker : m_workers)
     {
-        worker.render(shaderHandler, m_controller);
+        worker.render(shaderHandler, m_controller, interpolation);
     }
 
     for (const auto& supplyDepot : m_supplyDepots)
     {
-        supplyDepot.render(shaderHandler, m_controller);
+        supplyDepot.render(shaderHandler, m_controller, interpolation);
     }
 
     for (const auto& barracks : m_barracks)
     {
-        barracks.render(shaderHandler, m_controller);
+        barracks.render(shaderHandler, m_controller, interpolation);
     }
 
     for (const auto& turret : m_turrets)
     {
-        turret.render(shaderHandler, m_controller);
+        turret.render(shaderHandler, m_controller, interpolation);
     }
 
     for (const auto& headquarters : m_headquarters)
     {
-        headquarters.render(shaderHandler, m_controller);
+        headquarters.render(shaderHandler, m_controller, interpolation);
     }
  
     for (const auto& laboratory : m_laboratories)
     {
-        laboratory.render(shaderHandler, m_controller);
+        laboratory.render(shaderHandler, m_controller, interpolation);
     }
 }
 
@@ -554,13 +562,15 @@ void Faction::renderPlannedBuildings(ShaderHandler& shaderHandler) const
     }
 }
 
-void Faction::renderEntityStatusBars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const
+#ifndef HEADLESS
+void Faction::renderEntityStatusBars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const
 {
     for (const auto& entity : m_allEntities)
     {
-        entity->render_status_bars(shaderHandler, camera, windowSize);
+        entity->render_status_bars(shaderHandler, camera, windowSize, interpolation);
     }
 }
+#endif // HEADLESS
 
 #ifdef RENDER_PATHING
 void Faction::renderPathing(ShaderHandler& shaderHandler)
@@ -684,10 +694,7 @@ bool Faction::is_laboratory_built() const
 
 bool Faction::isMineralInUse(const Mineral& mineral) const
 {
-    return std::any_of(m_workers.cbegin(), m_workers.cend(), [&mineral](auto& worker)
-    {
-        return worker.getMineralToHarvest() && worker.getMineralToHarvest()->getPosition() == mineral.getPosition();
-    });
+    return m_mineralReservations.isReserved(mineral);
 }
 
 Entity* Faction::createUnit(const EntityToSpawnFromBuilding& entity_to_spawn, const Map& map)
@@ -12,13 +12,24 @@
 #include "Core/FactionController.h"
 #include "Events/GameMessages.h"
 #include "Core/Map.h"
+#include "Core/EntityList.h"
+#include "Core/EntityLookup.h"
+#include "Core/EntityPool.h"
+#include "Core/EntitySpatialIndex.h"
+#include "Core/WorkerOccupancy.h"
+#include "Core/MovementCore.h"
+#include "Core/MineralReservations.h"
 #include <vector>
 #include <functional>
 #include <optional>
 
 struct Camera;
 struct GameEvent;
+struct TakeDamageEvent;
+struct EntityIdleEvent;
+struct PathQuery;
 class FactionHandler;
+class LocalAvoidance;
 class ShaderHandler;
 class Map;
 class Faction
@@ -47,13 +58,16 @@ public:
 	const Headquarters* getMainHeadquarters() const;
 	const Headquarters* getClosestHeadquarters(const glm::vec3& position) const;
 	eFactionController getController() const;
-	const std::vector<Headquarters>& GetHeadquarters() const;
-	const std::vector<Entity*>& getEntities() const;
+	const EntityPool<Headquarters>& GetHeadquarters() const;
+	const EntityList& getEntities() const;
 	const Entity* getEntity(const glm::vec3& position, float maxDistance, bool prioritizeUnits = true) const;
-	const Entity* getEntity(const AABB& aabb, int entityID) const;
 	const Entity* getEntity(const glm::vec3& position) const;
 	const Headquarters* get_closest_headquarters(const glm::vec3& position) const;
 	const Entity* get_entity(const int id) const;
+	Entity* get_entity(const int id);
+	const std::vector<glm::vec3>* get_movement_path(const int entityID) const;
+	MovementCore& get_movement_core();
+	MineralReservations& get_mineral_reservations();
 
 	virtual Barracks* CreateBarracks(const WorkerScheduledBuilding& scheduled_building);
 	virtual Turret* CreateTurret(const WorkerScheduledBuilding& scheduled_building);
@@ -63,13 +77,21 @@ public:
 	virtual Entity* createUnit(const EntityToSpawnFromBuilding& entity_to_spawn, const Map& map);
 	virtual Entity* createWorker(const EntityToSpawnFromBuilding& entity_to_spawn, const Map& map);
 	virtual bool increaseShield(const Laboratory& laboratory);
-	virtual void handleEvent(const GameEvent& gameEvent, const Map& map, FactionHandler& factionHandler, 
+	virtual void handleEvent(const GameEvent& gameEvent);
+	void handleEvents(std::vector<TakeDamageEvent>& takeDamageEvents, const Map& map, FactionHandler& factionHandler);
+	void handleEvents(const std::vector<EntityIdleEvent>& entityIdleEvents, const Map& map, FactionHandler& factionHandler,
 		const BaseHandler& baseHandler);
 	virtual void update(float deltaTime, const Map& map, FactionHandler& factionHandler, const BaseHandler& baseHandler);
-	void delayed_update(const Map& map, FactionHandler& factionHandler);
-	void render(ShaderHandler& shaderHandler) const;
+	void update_movement(float deltaTime, const Map& map, const LocalAvoidance* localAvoidance);
+	void find_targets_in_range(const Faction& opposingFaction, int bucket, int bucketCount);
+	void delayed_update(const Map& map, FactionHandler& factionHandler, int bucket, int bucketCount);
+	bool get_movement_path_query(const int entityID, const Map& map, PathQuery& query) const;
+	void revalidate_movement_path(const int entityID, const Map& map, std::vector<glm::vec3>& path);
+	void render(ShaderHandler& shaderHandler, float interpolation) const;
 	void renderPlannedBuildings(ShaderHandler& shaderHandler) const;
-	void renderEntityStatusBars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize) const;
+#ifndef HEADLESS
+	void renderEntityStatusBars(ShaderHandler& shaderHandler, const Camera& camera, glm::uvec2 windowSize, float interpolation) const;
+#endif // HEADLESS
 
 #ifdef RENDER_PATHING
 	void renderPathing(ShaderHandler& shaderHandler);
@@ -88,14 +110,17 @@ protected:
 	virtual void on_entity_removal(const Entity& entity);
 	Worker* GetWorker(const int id);
 
-	std::vector<Entity*> m_allEntities;
-	std::vector<Unit> m_units;
-	std::vector<Worker> m_workers;
-	std::vector<SupplyDepot> m_supplyDepots;
-	std::vector<Barracks> m_barracks;
-	std::vector<Turret> m_turrets;
-	std::vector<Headquarters> m_headquarters;
-	std::vector<Laboratory> m_laboratories;
+	//Declared before the Units and Workers holding slots and minerals in them
+	MovementCore m_movementCore;
+	MineralReservations m_mineralReservations;
+	EntityList m_allEntities;
+	EntityPool<Unit> m_units;
+	EntityPool<Worker> m_workers;
+	EntityPool<SupplyDepot> m_supplyDepots;
+	EntityPool<Barracks> m_barracks;
+	EntityPool<Turret> m_turrets;
+	EntityPool<Headquarters> m_headquarters;
+	EntityPool<Laboratory> m_laboratories;
 
 private:
 	const eFactionController m_controller	= eFactionController::None;
@@ -103,41 +128,40 @@ private:
 	int m_currentPopulationAmount			= 0;
 	int m_currentPopulationLimit			= 0;
 	int m_currentShieldAmount				= 0;
+	EntitySpatialIndex m_entityIndex		= {};
+	EntityLookup m_entityLookup				= {};
+	WorkerOccupancy m_workerOccupancy		= {};
+	std::vector<const Worker*> m_overlappingWorkers = {};
 
 	void handleWorkerCollisions(const Map& map);
 	void on_entity_creation(Entity& entity);
 
-	//Presumes entity already found in all entities container
+	void removeEntity(Entity& entity);
+
+	//Presumes entity is held in entityPool
 	template <typename T>
-	void removeEntity(std::vector<T>& entityContainer, std::vector<Entity*>::iterator entity);
+	void removeEntity(EntityPool<T>& entityPool, Entity& entity);
 
 	template <typename T, typename ...EntityConstructParams>
-	T* CreateEntity(std::vector<T>& container, const eEntityType type, EntityConstructParams&&... construct_params);
+	T* CreateEntity(EntityPool<T>& entityPool, const eEntityType type, EntityConstructParams&&... construct_params);
 };
 
 template <typename T>
-void Faction::removeEntity(std::vector<T>& entityContainer, std::vector<Entity*>::iterator entity)
+void Faction::removeEntity(EntityPool<T>& entityPool, Entity& entity)
 {
-	assert((*entity) && entity != m_allEntities.cend());
-
-	const auto iter = std::find_if(entityContainer.begin(), entityContainer.end(), [entity](auto& _entity)
-	{
-		return _entity.getID() == (*entity)->getID();
-	});
-
-	assert(iter != entityContainer.end());
-
-	on_entity_removal(*(*entity));
-	m_allEntities.erase(entity);
-	entityContainer.erase(iter);
+	on_entity_removal(entity);
+	m_entityIndex.remove(entity.getID());
+	m_entityLookup.remove(entity.getID());
+	m_allEntities.remove(entity);
+	entityPool.erase(static_cast<T&>(entity));
 }
 
 template <typename T, typename ...EntityConstructParams>
-T* Faction::CreateEntity(std::vector<T>& container, const eEntityType type, EntityConstructParams&&... construct_params)
+T* Faction::CreateEntity(EntityPool<T>& entityPool, const eEntityType type, EntityConstructParams&&... construct_params)
 {
 	if (IsEntityCreatable(type))
 	{
-		T* created_entity{ &container.emplace_back(std::forward<EntityConstructParams>(construct_params)...) };
+		T* created_entity{ &entityPool.emplace_back(std::forward<EntityConstructParams>(construct_params)...) };
 		on_entity_creation(*created_entity);
 		return created_entity;
 	}
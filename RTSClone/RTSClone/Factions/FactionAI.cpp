@@ -110,16 +110,33 @@ namespace
 
 //FactionAI
 FactionAI::FactionAI(eFactionController factionController, const glm::vec3& hqStartingPosition,
-	int startingResources, int startingPopulationCap, AIConstants::eBehaviour behaviour, const BaseHandler& baseHandler)
+	int startingResources, int startingPopulationCap, AIConstants::eBehaviour behaviour, const BaseHandler& baseHandler, glm::ivec2 mapSize)
 	: Faction(factionController, hqStartingPosition, startingResources, startingPopulationCap),
 	m_behaviour(behaviour),
 	m_occupiedBases(baseHandler, getController()),
 	m_baseExpansionTimer(Globals::getRandomNumber(AIConstants::MIN_BASE_EXPANSION_TIME, AIConstants::MAX_BASE_EXPANSION_TIME), true),
 	m_delayTimer(AIConstants::DELAY_TIMER_EXPIRATION, true),
 	m_spawnTimer(Globals::getRandomNumber(AIConstants::MIN_SPAWN_TIMER_EXPIRATION, AIConstants::MAX_SPAWN_TIMER_EXPIRATION), true),
-	m_targetFaction(eFactionController::None)
+	m_targetFaction(eFactionController::None),
+	m_buildingProximity(mapSize, AIConstants::MIN_BUILDING_DISTANCE_FROM_BUILDINGS),
+	m_mineralProximity(mapSize, AIConstants::MIN_BUILDING_DISTANCE_FROM_MINERALS)
 {
 	m_unitsOnHold.reserve(m_units.capacity());
+	for (const auto& entity : m_allEntities)
+	{
+		if (Globals::BUILDING_TYPES.isMatch(entity->getEntityType()))
+		{
+			m_buildingProximity.add(entity->getPosition());
+		}
+	}
+
+	for (const auto& base : baseHandler.getBases())
+	{
+		for (const auto& mineral : base.getMinerals())
+		{
+			m_mineralProximity.add(mineral.getPosition());
+		}
+	}
 }
 
 void FactionAI::setTargetFaction(FactionHandler& factionHandler)
@@ -151,28 +168,10 @@ void FactionAI::onFactionElimination(FactionHandler& factionHandler, eFactionCon
 	}
 }
 
-void FactionAI::handleEvent(const GameEvent& gameEvent, const Map& map, FactionHandler& factionHandler, const BaseHandler& baseHandler)
+void FactionAI::handleBaseEvent(const GameEvent& gameEvent, const Map& map, const BaseHandler& baseHandler)
 {
-	Faction::handleEvent(gameEvent, map, factionHandler, baseHandler);
-
 	switch (gameEvent.type)
 	{
-	case eGameEventType::TakeDamage:
-	{
-		assert(gameEvent.data.takeDamage.senderFaction != getController());
-		int targetID = gameEvent.data.takeDamage.targetID;
-		auto entity = std::find_if(m_allEntities.begin(), m_allEntities.end(), [targetID](const auto& entity)
-		{
-			return entity->getID() == targetID;
-		});
-
-		if (entity != m_allEntities.end() &&
-			(*entity)->getEntityType() == eEntityType::Headquarters)
-		{
-			instructWorkersToRepair(*(*entity), map);
-		}
-	}
-	break;
 	case eGameEventType::AttachFactionToBase:
 	{	
 		if (const Base* base = baseHandler.getBase(gameEvent.data.attachFactionToBase.position))
@@ -213,6 +212,8 @@ void FactionAI::handleEvent(const GameEvent& gameEvent, const Map& map, FactionH
 		}
 	}
 	break;
+	default:
+		break;
 	}
 }
 
@@ -228,24 +229,23 @@ void FactionAI::update(float deltaTime, const Map & map, FactionHandler& faction
 {
 	Faction::update(deltaTime, map, factionHandler, baseHandler);
 
-	m_delayTimer.update(deltaTime);
 	if (m_delayTimer.isExpired())
 	{
 		m_delayTimer.resetElaspedTime();
 
-		std::for_each(m_occupiedBases.bases.begin(), m_occupiedBases.bases.end(), [&map, &baseHandler, this](auto& occupiedBase)
+		std::for_each(m_occupiedBases.bases.begin(), m_occupiedBases.bases.end(), [&map, this](auto& occupiedBase)
 		{
 			//Update action queues
 			if (!occupiedBase.actionQueue.empty())
 			{
-				if (handleAction(occupiedBase.actionQueue.front(), map, occupiedBase, baseHandler))
+				if (handleAction(occupiedBase.actionQueue.front(), map, occupiedBase))
 				{
 					occupiedBase.actionQueue.pop_front();
 				}
 			}
 			if (!occupiedBase.actionPriorityQueue.empty())
 			{
-				if (handleAction(occupiedBase.actionPriorityQueue.top(), map, occupiedBase, baseHandler))
+				if (handleAction(occupiedBase.actionPriorityQueue.top(), map, occupiedBase))
 				{
 					occupiedBase.actionPriorityQueue.pop();
 				}
@@ -284,7 +284,6 @@ void FactionAI::update(float deltaTime, const Map & map, FactionHandler& faction
 	case AIConstants::eBehaviour::Defensive:
 		break;
 	case AIConstants::eBehaviour::Aggressive:
-		m_spawnTimer.update(deltaTime);
 		if (m_spawnTimer.isExpired())
 		{
 			m_spawnTimer.resetElaspedTime();
@@ -292,7 +291,7 @@ void FactionAI::update(float deltaTime, const Map & map, FactionHandler& faction
 			if (AIOccupiedBase* base;
 				mainHeadquarters && (base = m_occupiedBases.getBase(*mainHeadquarters)))
 			{
-				build(map, eEntityType::Unit, *base, baseHandler);
+				build(map, eEntityType::Unit, *base);
 			}
 		}
 		break;
@@ -300,7 +299,6 @@ void FactionAI::update(float deltaTime, const Map & map, FactionHandler& faction
 		assert(false);
 	}
 
-	m_baseExpansionTimer.update(deltaTime);
 	if (const Headquarters* mainHeadquarters;
 		m_baseExpansionTimer.isExpired() 
 		&& isAffordable(eEntityType::Headquarters)
@@ -338,6 +336,7 @@ void FactionAI::on_entity_removal(const Entity& entity)
 	if (entity.getEntityType() == eEntityType::Worker)
 	{
 		m_occupiedBases.removeWorker(static_cast<const Worker&>(entity));
+		m_unattachedToBaseWorkers.remove(static_cast<const Worker&>(entity));
 	}
 	else if (entity.getEntityType() == eEntityType::Unit)
 	{
@@ -346,6 +345,7 @@ void FactionAI::on_entity_removal(const Entity& entity)
 	else if(Globals::BUILDING_TYPES.isMatch(entity.getEntityType()))
 	{
 		m_occupiedBases.removeBuilding(entity);
+		m_buildingProximity.remove(entity.getPosition());
 	}
 }
 
@@ -358,6 +358,9 @@ void FactionAI::on_entity_taken_damage(const TakeDamageEvent& gameEvent, Entity&
 	case eEntityType::Unit:
 		on_unit_taken_damage(gameEvent, static_cast<Unit&>(entity), map, factionHandler);
 		break;
+	case eEntityType::Headquarters:
+		instructWorkersToRepair(entity, map);
+		break;
 	}
 }
 
@@ -379,6 +382,7 @@ Barracks* FactionAI::CreateBarracks(const WorkerScheduledBuilding& scheduled_bui
 	if (Barracks* barracks = Faction::CreateBarracks(scheduled_building))
 	{
 		m_occupiedBases.addBuilding(scheduled_building.owner_id, *barracks);
+		m_buildingProximity.add(barracks->getPosition());
 		return barracks;
 	}
 
@@ -390,6 +394,7 @@ Turret* FactionAI::CreateTurret(const WorkerScheduledBuilding& scheduled_buildin
 	if (Turret* turret = Faction::CreateTurret(scheduled_building))
 	{
 		m_occupiedBases.addBuilding(scheduled_building.owner_id, *turret);
+		m_buildingProximity.add(turret->getPosition());
 		return turret;
 	}
 
@@ -398,7 +403,13 @@ Turret* FactionAI::CreateTurret(const WorkerScheduledBuilding& scheduled_buildin
 
 Headquarters* FactionAI::CreateHeadquarters(const WorkerScheduledBuilding& scheduled_building)
 {
-	return Faction::CreateHeadquarters(scheduled_building);
+	Headquarters* headquarters = Faction::CreateHeadquarters(scheduled_building);
+	if (headquarters)
+	{
+		m_buildingProximity.add(headquarters->getPosition());
+	}
+
+	return headquarters;
 }
 
 Laboratory* FactionAI::CreateLaboratory(const WorkerScheduledBuilding& scheduled_building)
@@ -406,6 +417,7 @@ Laboratory* FactionAI::CreateLaboratory(const WorkerScheduledBuilding& scheduled
 	if (Laboratory* laboratory = Faction::CreateLaboratory(scheduled_building))
 	{
 		m_occupiedBases.addBuilding(scheduled_building.owner_id, *laboratory);
+		m_buildingProximity.add(laboratory->getPosition());
 		return laboratory;
 	}
 
@@ -417,6 +429,7 @@ SupplyDepot* FactionAI::CreateSupplyDepot(const WorkerScheduledBuilding& schedul
 	if (SupplyDepot* supply_depot = Faction::CreateSupplyDepot(scheduled_building))
 	{
 		m_occupiedBases.addBuilding(scheduled_building.owner_id, *supply_depot);
+		m_buildingProximity.add(supply_depot->getPosition());
 		return supply_depot;
 	}
 
@@ -521,39 +534,32 @@ Worker* FactionAI::getAvailableWorker(const glm::vec3& position, AIOccupiedBase&
 	return selectedWorker;
 }
 
-bool FactionAI::isWithinRangeOfBuildings(const glm::vec3& position, float distance) const
+bool FactionAI::isWithinRangeOfBuildings(glm::ivec2 positionOnGrid) const
 {
-	for (const auto& entity : m_allEntities)
+	if (m_buildingProximity.isWithinRange(positionOnGrid))
 	{
-		switch (entity->getEntityType())
+		return true;
+	}
+
+	const glm::vec3 position = Globals::convertToWorldPosition(positionOnGrid);
+	constexpr float distance = AIConstants::MIN_BUILDING_DISTANCE_FROM_BUILDINGS;
+	for (const auto& worker : m_workers)
+	{
+		for (const auto& buildingCommand : worker.get_scheduled_buildings())
 		{
-		case eEntityType::Headquarters:
-		case eEntityType::SupplyDepot:
-		case eEntityType::Barracks:
-		case eEntityType::Turret:
-		case eEntityType::Laboratory:
-			if (Globals::getSqrDistance(entity->getPosition(), position) <= distance * distance)
+			if (Globals::getSqrDistance(buildingCommand.position.Get(), position) <= distance * distance)
 			{
 				return true;
 			}
-			break;
-		case eEntityType::Unit:
-			break;
-		case eEntityType::Worker:
-			for (const auto& buildingCommand : static_cast<Worker&>(*entity).get_scheduled_buildings())
-			{
-				if (Globals::getSqrDistance(buildingCommand.position.Get(), position) <= distance * distance)
-				{
-					return true;
-				}
-			}
-			break;
-		default:
-			assert(false);
 		}
-
-		return false;
 	}
+
+	return false;
+}
+
+bool FactionAI::isWithinRangeOfMinerals(glm::ivec2 positionOnGrid) const
+{
+	return m_mineralProximity.isWithinRange(positionOnGrid);
 }
 
 bool FactionAI::increaseShield(const Laboratory& laboratory)
@@ -627,7 +633,7 @@ Entity* FactionAI::createWorker(const EntityToSpawnFromBuilding& entity, const M
 	return spawnedWorker;
 }
 
-bool FactionAI::build(const Map& map, eEntityType entityType, AIOccupiedBase& occupiedBase, const BaseHandler& baseHandler, Worker* worker)
+bool FactionAI::build(const Map& map, eEntityType entityType, AIOccupiedBase& occupiedBase, Worker* worker)
 {
 	if (!isAffordable(entityType))
 	{
@@ -643,7 +649,7 @@ bool FactionAI::build(const Map& map, eEntityType entityType, AIOccupiedBase& oc
 	{
 		glm::vec3 buildPosition(0.0f);
 		if (PathFinding::getInstance().isBuildingSpawnAvailable(occupiedBase.base.get().getCenteredPosition(),
-			entityType, map, buildPosition, *this, baseHandler))
+			entityType, map, buildPosition, *this))
 		{
 			if (worker)
 			{
@@ -688,7 +694,7 @@ bool FactionAI::build(const Map& map, eEntityType entityType, AIOccupiedBase& oc
 	return false;
 }
 
-bool FactionAI::handleAction(const AIAction& action, const Map& map, AIOccupiedBase& occupiedBase, const BaseHandler& baseHandler)
+bool FactionAI::handleAction(const AIAction& action, const Map& map, AIOccupiedBase& occupiedBase)
 {
 	switch (action.actionType)
 	{
@@ -700,7 +706,7 @@ bool FactionAI::handleAction(const AIAction& action, const Map& map, AIOccupiedB
 		eEntityType entityType;
 		if (convertActionTypeToEntityType(action.actionType, entityType))
 		{
-			if (build(map, entityType, occupiedBase, baseHandler))
+			if (build(map, entityType, occupiedBase))
 			{
 				return true;
 			}
@@ -719,7 +725,7 @@ bool FactionAI::handleAction(const AIAction& action, const Map& map, AIOccupiedB
 	{
 		eEntityType entityType;
 		if (convertActionTypeToEntityType(action.actionType, entityType) &&
-			build(map, entityType, occupiedBase, baseHandler))
+			build(map, entityType, occupiedBase))
 		{
 			return true;
 		}
@@ -783,7 +789,12 @@ void FactionAI::on_unit_taken_damage(const TakeDamageEvent& gameEvent, Unit& uni
 
 void FactionAI::on_unit_idle(Unit& unit, const Map& map, FactionHandler& factionHandler)
 {
-	assert(unit.getCurrentState() == eUnitState::Idle);
+	//May have found a target since becoming idle
+	if (unit.getCurrentState() != eUnitState::Idle)
+	{
+		return;
+	}
+
 	int unitID = unit.getID();
 	auto unitOnHold = std::find_if(m_unitsOnHold.cbegin(), m_unitsOnHold.cend(), [unitID](const auto& unit)
 	{
@@ -849,7 +860,7 @@ void FactionAI::on_worker_idle(Worker& worker, const Map& map, const BaseHandler
 				eEntityType entityType;
 				if (convertActionTypeToEntityType(occupiedBase.actionQueue.front().actionType, entityType) &&
 					Globals::BUILDING_TYPES.isMatch(entityType) &&
-					build(map, entityType, occupiedBase, baseHandler, &worker))
+					build(map, entityType, occupiedBase, &worker))
 				{
 					occupiedBase.actionQueue.pop_front();
 					break;
@@ -3,6 +3,7 @@
 #include "Faction.h"
 #include "Core/Graph.h"
 #include "Core/Timer.h"
+#include "Core/ProximityField.h"
 #include "AI/AIOccupiedBases.h"
 #include "AI/AIAction.h"
 #include "AI/AIConstants.h"
@@ -19,14 +20,15 @@ class FactionAI : public Faction
 {
 public:
 	FactionAI(eFactionController factionController, const glm::vec3& hqStartingPosition, 
-		int startingResources, int startingPopulationCap, AIConstants::eBehaviour behaviour, const BaseHandler& baseHandler);
+		int startingResources, int startingPopulationCap, AIConstants::eBehaviour behaviour, const BaseHandler& baseHandler, glm::ivec2 mapSize);
 
-	bool isWithinRangeOfBuildings(const glm::vec3& position, float distance) const;
+	bool isWithinRangeOfBuildings(glm::ivec2 positionOnGrid) const;
+	bool isWithinRangeOfMinerals(glm::ivec2 positionOnGrid) const;
 	
 	bool increaseShield(const Laboratory& laboratory) override;
 	void setTargetFaction(FactionHandler& factionHandler);
 	void onFactionElimination(FactionHandler& factionHandler, eFactionController eliminatedFaction);
-	void handleEvent(const GameEvent& gameEvent, const Map& map, FactionHandler& factionHandler, const BaseHandler& baseHandler) override;
+	void handleBaseEvent(const GameEvent& gameEvent, const Map& map, const BaseHandler& baseHandler);
 	void selectEntity(const glm::vec3& position);
 	Entity* createUnit(const EntityToSpawnFromBuilding& entity, const Map& map) override;
 	Entity* createWorker(const EntityToSpawnFromBuilding& entity, const Map& map) override;
@@ -53,13 +55,15 @@ private:
 	eFactionController m_targetFaction;
 	std::vector<Unit*> m_unitsOnHold;
 	std::vector<AISquad> m_squads;
+	ProximityField m_buildingProximity;
+	ProximityField m_mineralProximity;
 
 	void instructWorkersToRepair(const Entity& entity, const Map& map);
 	Worker* getAvailableWorker(const glm::vec3& position);
 	Worker* getAvailableWorker(const glm::vec3& position, AIOccupiedBase& occupiedBase);
 
-	bool build(const Map& map, eEntityType entityType, AIOccupiedBase& occupiedBase, const BaseHandler& baseHandler, Worker* worker = nullptr);
-	bool handleAction(const AIAction& action, const Map& map, AIOccupiedBase& occupiedBase, const BaseHandler& baseHandler);
+	bool build(const Map& map, eEntityType entityType, AIOccupiedBase& occupiedBase, Worker* worker = nullptr);
+	bool handleAction(const AIAction& action, const Map& map, AIOccupiedBase& occupiedBase);
 	void on_unit_taken_damage(const TakeDamageEvent& gameEvent, Unit& unit, const Map& map, FactionHandler& factionHandler);
 	void on_unit_idle(Unit& unit, const Map& map, FactionHandler& factionHandler);
 	void on_worker_idle(Worker& worker, const Map& map, const BaseHandler& baseHandler);
@@ -27,7 +27,8 @@ namespace
 	}
 }
 
-FactionHandler::FactionHandler(const BaseHandler& baseHandler, const LevelDetailsFromFile& levelDetails)
+FactionHandler::FactionHandler(const BaseHandler& baseHandler, const LevelDetailsFromFile& levelDetails, bool AIControlledPlayer)
+	: m_AIControlledPlayer(AIControlledPlayer)
 {
 	static_assert(static_cast<int>(AIConstants::eBehaviour::Max) == 1, "Current assigning of AI behaviour relies on only two behaviours");
 	int AIBehaviourIndex = 0;
@@ -39,15 +40,19 @@ FactionHandler::FactionHandler(const BaseHandler& baseHandler, const LevelDetail
 		switch (eFactionController(i))
 		{
 		case eFactionController::Player:
-			m_factions.emplace_back(std::make_unique<FactionPlayer>(baseHandler.getBases()[i].position,
-				levelDetails.factionStartingResources, levelDetails.factionStartingPopulation));
-			break;
+			if (!m_AIControlledPlayer)
+			{
+				m_factions.emplace_back(std::make_unique<FactionPlayer>(baseHandler.getBases()[i].position,
+					levelDetails.factionStartingResources, levelDetails.factionStartingPopulation));
+				break;
+			}
+			[[fallthrough]];
 		case eFactionController::AI_1:
 		case eFactionController::AI_2:
 		case eFactionController::AI_3:
 			m_factions.emplace_back(std::make_unique<FactionAI>(eFactionController(i), baseHandler.getBases()[i].position,
 				levelDetails.factionStartingResources, levelDetails.factionStartingPopulation,
-				static_cast<AIConstants::eBehaviour>(AIBehaviourIndex), baseHandler));
+				static_cast<AIConstants::eBehaviour>(AIBehaviourIndex), baseHandler, levelDetails.gridSize));
 			AIBehaviourIndex ^= 1;
 			break;
 		default:
@@ -64,6 +69,11 @@ bool FactionHandler::isFactionActive(eFactionController factionController) const
 	return faction != m_factions.cend();
 }
 
+bool FactionHandler::isAIControlled(eFactionController factionController) const
+{
+	return factionController != eFactionController::Player || m_AIControlledPlayer;
+}
+
 const std::vector<std::unique_ptr<Faction>>& FactionHandler::getFactions() const
 {
 	return m_factions;
@@ -91,7 +101,7 @@ const std::vector<const Faction*>& FactionHandler::GetOpposingFactions(eFactionC
 const FactionPlayer* FactionHandler::getFactionPlayer() const
 {
 	const auto faction = GetFaction(m_factions, eFactionController::Player);
-	if (faction != m_factions.cend())
+	if (!m_AIControlledPlayer && faction != m_factions.cend())
 	{
 		return static_cast<const FactionPlayer*>((*faction).get());
 	}
@@ -102,7 +112,7 @@ const FactionPlayer* FactionHandler::getFactionPlayer() const
 FactionPlayer* FactionHandler::getFactionPlayer()
 {
 	const auto faction = GetFaction(m_factions, eFactionController::Player);
-	if (faction != m_factions.cend())
+	if (!m_AIControlledPlayer && faction != m_factions.cend())
 	{
 		return static_cast<FactionPlayer*>((*faction).get());
 	}
@@ -10,13 +10,14 @@ class FactionPlayer;
 class FactionHandler
 {
 public:
-	FactionHandler(const BaseHandler& baseHandler, const LevelDetailsFromFile& levelDetails);
+	FactionHandler(const BaseHandler& baseHandler, const LevelDetailsFromFile& levelDetails, bool AIControlledPlayer = false);
 	FactionHandler(FactionHandler&) = delete;
 	FactionHandler& operator=(FactionHandler&) = delete;
 	FactionHandler(FactionHandler&&) noexcept = default;
 	FactionHandler& operator=(FactionHandler&&) noexcept = default;
 
 	bool isFactionActive(eFactionController factionController) const;
+	bool isAIControlled(eFactionController factionController) const;
 
 	const std::vector<std::unique_ptr<Faction>>& getFactions() const;
 	std::vector<std::unique_ptr<Faction>>& getFactions();
@@ -32,4 +33,5 @@ public:
 private:
 	std::vector<std::unique_ptr<Faction>> m_factions{};
 	std::vector<const Faction*> m_opposing_factions{};
+	bool m_AIControlledPlayer = false;
 };
\ No newline at end of file
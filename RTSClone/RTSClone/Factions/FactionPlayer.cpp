@@ -1,7 +1,9 @@
 #include "FactionPlayer.h"
 #include "Core/Globals.h"
 #include "glad/glad.h"
+#ifndef HEADLESS
 #include "Core/Camera.h"
+#endif // HEADLESS
 #include "Core/Map.h"
 #include "Graphics/ModelManager.h"
 #include "Core/PathFinding.h"
@@ -25,6 +27,7 @@ const std::vector<Entity*>& FactionPlayer::getSelectedEntities() const
     return m_selected_entities.SelectedEntities();
 }
 
+#ifndef HEADLESS
 void FactionPlayer::handleInput(const sf::Event& currentSFMLEvent, const sf::Window& window, const Camera& camera, 
     const Map& map, FactionHandler& factionHandler, const BaseHandler& baseHandler, const MiniMap& miniMap, 
     const glm::vec3& levelSize)
@@ -52,38 +55,29 @@ void FactionPlayer::handleInput(const sf::Event& currentSFMLEvent, const sf::Win
         break;
     }
 }
+#endif // HEADLESS
 
-void FactionPlayer::handleEvent(const GameEvent& gameEvent, const Map& map, FactionHandler& factionHandler, const BaseHandler& baseHandler)
+void FactionPlayer::handleEvent(const GameEvent& gameEvent)
 {
-    Faction::handleEvent(gameEvent, map, factionHandler, baseHandler);
+    Faction::handleEvent(gameEvent);
 
     switch (gameEvent.type)
     {
     case eGameEventType::PlayerActivatePlannedBuilding:
     {
-        const auto entity = std::find_if(m_allEntities.cbegin(), m_allEntities.cend(),
-                [id = gameEvent.data.playerActivatePlannedBuilding.targetID] (const auto& entity)
-        {
-            return entity->getID() == id;
-        });
-        if (entity != m_allEntities.cend())
+        if (const Entity* entity = get_entity(gameEvent.data.playerActivatePlannedBuilding.targetID))
         {
             m_plannedBuilding =
                 std::optional<FactionPlayerPlannedBuilding>(std::in_place, 
-                    gameEvent.data.playerActivatePlannedBuilding, (*entity)->getPosition(), this);
+                    gameEvent.data.playerActivatePlannedBuilding, entity->getPosition(), this);
         }
     }
         break;
     case eGameEventType::PlayerSpawnEntity:
     {
-        int targetEntityID = gameEvent.data.playerSpawnEntity.targetID;
-        auto entity = std::find_if(m_allEntities.begin(), m_allEntities.end(), [targetEntityID](const auto& entity)
-        {
-            return entity->getID() == targetEntityID;
-        });
-        if (entity != m_allEntities.end())
+        if (Entity* entity = get_entity(gameEvent.data.playerSpawnEntity.targetID))
         {
-            (*entity)->AddEntityToSpawnQueue(*this);
+            entity->AddEntityToSpawnQueue(*this);
         }
         break;
     }
@@ -109,10 +103,12 @@ void FactionPlayer::renderPlannedBuilding(ShaderHandler& shaderHandler, const Ma
     }
 }
 
+#ifndef HEADLESS
 void FactionPlayer::renderEntitySelector(const sf::Window& window, ShaderHandler& shaderHandler) const
 {
     m_selected_entities.render(window, shaderHandler);
 }
+#endif // HEADLESS
 
 void FactionPlayer::on_entity_removal(const Entity& entity)
 {
@@ -138,7 +134,7 @@ void FactionPlayer::build_planned_building(const Map& map, const BaseHandler& ba
     {
         return worker.getID() == id;
     });
-    if (selectedWorker == m_workers.cend()
+    if (selectedWorker == m_workers.end()
         || !m_plannedBuilding->IsBuildingCreatable(map))
     {
         m_plannedBuilding.reset();
@@ -15,12 +15,16 @@ public:
 
 	const std::vector<Entity*>& getSelectedEntities() const;
 
+#ifndef HEADLESS
 	void handleInput(const sf::Event& currentSFMLEvent, const sf::Window& window, const Camera& camera, const Map& map, 
 		FactionHandler& factionHandler, const BaseHandler& baseHandler, const MiniMap& miniMap, const glm::vec3& levelSize);
-	void handleEvent(const GameEvent& gameEvent, const Map& map, FactionHandler& factionHandler, const BaseHandler& baseHandler) override;
+#endif // HEADLESS
+	void handleEvent(const GameEvent& gameEvent) override;
 	void update(float deltaTime, const Map& map, FactionHandler& factionHandler, const BaseHandler& baseHandler) override;
 	void renderPlannedBuilding(ShaderHandler& shaderHandler, const Map& map) const;
+#ifndef HEADLESS
 	void renderEntitySelector(const sf::Window& window, ShaderHandler& shaderHandler) const;
+#endif // HEADLESS
 
 private:
 	FactionPlayerSelectedEntities m_selected_entities;
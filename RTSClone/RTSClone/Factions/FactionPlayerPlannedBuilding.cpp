@@ -3,7 +3,9 @@
 #include "Events/GameEvents.h"
 #include "Core/Globals.h"
 #include "Core/Map.h"
+#ifndef HEADLESS
 #include "Core/Camera.h"
+#endif // HEADLESS
 #include "FactionPlayer.h"
 
 namespace
@@ -44,6 +46,7 @@ eEntityType FactionPlayerPlannedBuilding::getEntityType() const
     return m_entityType;
 }
 
+#ifndef HEADLESS
 void FactionPlayerPlannedBuilding::handleInput(const sf::Event& event, const Camera& camera, const sf::Window& window, const Map& map)
 {
     if (event.type == sf::Event::MouseMoved)
@@ -57,6 +60,7 @@ void FactionPlayerPlannedBuilding::handleInput(const sf::Event& event, const Cam
         }
     }
 }
+#endif // HEADLESS
 
 void FactionPlayerPlannedBuilding::render(ShaderHandler& shaderHandler, const Map& map) const
 {
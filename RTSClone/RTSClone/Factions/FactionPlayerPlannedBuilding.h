@@ -25,7 +25,9 @@ public:
 	int getBuilderID() const;
 	eEntityType getEntityType() const;
 
+#ifndef HEADLESS
 	void handleInput(const sf::Event& event, const Camera& camera, const sf::Window& window, const Map& map);
+#endif // HEADLESS
 	void render(ShaderHandler& shaderHandler, const Map& map) const;
 
 private:
@@ -3,9 +3,12 @@
 #include "FactionPlayer.h"
 #include "FactionHandler.h"
 #include "Core/Level.h"
+#include "Core/PathFinding.h"
 
 namespace
 {
+    constexpr size_t FLOW_FIELD_MIN_GROUP_SIZE = 2;
+
     glm::vec3 getAveragePosition(std::vector<Entity*>& selectedEntities)
     {
         std::sort(selectedEntities.begin(), selectedEntities.end(), [](const auto& unitA, const auto& unitB)
@@ -34,6 +37,7 @@ const std::vector<Entity*>& FactionPlayerSelectedEntities::SelectedEntities() co
 
 void FactionPlayerSelectedEntities::Update()
 {
+#ifndef HEADLESS
     if (m_selection_box.isActive())
     {
         m_entities.clear();
@@ -46,6 +50,7 @@ void FactionPlayerSelectedEntities::Update()
             }
         }
     }
+#endif // HEADLESS
 
     if (m_entities.size() == 1)
     {
@@ -59,6 +64,7 @@ void FactionPlayerSelectedEntities::Update()
     }
 }
 
+#ifndef HEADLESS
 void FactionPlayerSelectedEntities::HandleInput(const BaseHandler& base_handler, const Camera& camera,    
     const sf::Event& sfml_event, const sf::Window& window, const MiniMap& minimap,
     FactionHandler& faction_handler, const glm::vec3& level_size, const Map& map)
@@ -159,16 +165,24 @@ void FactionPlayerSelectedEntities::HandleInput(const BaseHandler& base_handler,
         break;
     }
 }
+#endif // HEADLESS
 
+#ifndef HEADLESS
 void FactionPlayerSelectedEntities::render(const sf::Window& window, ShaderHandler& shaderHandler) const
 {
     m_selection_box.render(window, shaderHandler);
 }
+#endif // HEADLESS
 
 bool FactionPlayerSelectedEntities::Move(const glm::vec3& position, const Map& map)
 {
     bool selected_entity_moved = false;
     const glm::vec3 averagePosition = getAveragePosition(m_entities);
+    if (m_entities.size() >= FLOW_FIELD_MIN_GROUP_SIZE)
+    {
+        PathFinding::getInstance().setFlowFieldGoal(position, averagePosition, map);
+    }
+
     for (auto& selectedEntity : m_entities)
     {
         //todo:
@@ -22,11 +22,13 @@ public:
 	void OnEntityRemoval(const int id);
 	void Update();
 
+#ifndef HEADLESS
 	void HandleInput(const BaseHandler& base_handler, const Camera& camera, 
 		const sf::Event& sfml_event, const sf::Window& window, const MiniMap& minimap,
 		FactionHandler& faction_handler, const glm::vec3& level_size,
 		const Map& map);
 	void render(const sf::Window& window, ShaderHandler& shaderHandler) const;
+#endif // HEADLESS
 
 private:
 	bool Move(const glm::vec3& position, const Map& map);
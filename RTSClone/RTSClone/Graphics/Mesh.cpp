@@ -111,6 +111,22 @@ void Mesh::render(ShaderHandler& shaderHandler, bool highlight) const
 	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
 }
 
+void Mesh::render(ShaderHandler& shaderHandler, const std::vector<glm::mat4>& modelMatrices) const
+{
+	assert(!indices.empty());
+
+	shaderHandler.setUniformVec3(eShaderType::Default, "uMaterialColour", material.diffuse);
+	shaderHandler.setUniformVec3(eShaderType::Default, "uAdditionalColour", glm::vec3(1.0f));
+	shaderHandler.setUniform1f(eShaderType::Default, "uSelectedAmplifier", 1.0f);
+
+	m_VAO.bind();
+	for (const auto& modelMatrix : modelMatrices)
+	{
+		shaderHandler.setUniformMat4f(eShaderType::Default, "uModel", modelMatrix);
+		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
+	}
+}
+
 void Mesh::render(ShaderHandler& shaderHandler, eFactionController owningFactionController, bool highlight) const
 {
 	assert(!indices.empty());
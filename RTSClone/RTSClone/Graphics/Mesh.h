@@ -40,6 +40,7 @@ struct Mesh
 
 	void render(ShaderHandler& shaderHandler, const glm::vec3& additionalColor, float opacity) const;
 	void render(ShaderHandler& shaderHandler, bool highlight = false) const;
+	void render(ShaderHandler& shaderHandler, const std::vector<glm::mat4>& modelMatrices) const;
 	void render(ShaderHandler& shaderHandler, eFactionController owningFactionController, bool highlight = false) const;
 
 	std::vector<Vertex> vertices;
@@ -30,7 +30,7 @@ void Model::attachMeshesToVAO() const
 	}
 }
 
-void Model::setModelMatrix(ShaderHandler& shaderHandler, glm::vec3 position, const glm::vec3& rotation) const
+glm::mat4 Model::getModelMatrix(glm::vec3 position, const glm::vec3& rotation) const
 {
 	glm::mat4 model = glm::mat4(1.0f);
 	if (renderFromCentrePosition)
@@ -51,7 +51,12 @@ void Model::setModelMatrix(ShaderHandler& shaderHandler, glm::vec3 position, con
 		model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
 	}
 
-	shaderHandler.setUniformMat4f(eShaderType::Default, "uModel", model);
+	return model;
+}
+
+void Model::setModelMatrix(ShaderHandler& shaderHandler, glm::vec3 position, const glm::vec3& rotation) const
+{
+	shaderHandler.setUniformMat4f(eShaderType::Default, "uModel", getModelMatrix(position, rotation));
 }
 
 
@@ -60,10 +65,12 @@ std::unique_ptr<Model> Model::create(const std::string & fileName, bool renderFr
 	const glm::vec3& AABBSizeFromCenter, const glm::vec3& scale)
 {
 	std::vector<Mesh> meshes;
+#ifndef HEADLESS
 	if (!ModelLoader::loadModel(fileName, meshes))
 	{
 		return std::unique_ptr<Model>();
 	}
+#endif // HEADLESS
 
 	return std::unique_ptr<Model>(new Model(renderFromCentrePosition, AABBSizeFromCenter, scale, fileName, std::move(meshes)));
 }
@@ -89,6 +96,27 @@ void Model::render(ShaderHandler& shaderHandler, const glm::vec3& position, glm:
 	}
 }
 
+//Materials are set and each mesh bound once for every position - modelMatrices is the caller's scratch,
+//kept between frames so it doesn't have to be allocated again
+void Model::render(ShaderHandler& shaderHandler, const std::vector<glm::vec3>& positions, std::vector<glm::mat4>& modelMatrices) const
+{
+	if (positions.empty())
+	{
+		return;
+	}
+
+	modelMatrices.clear();
+	for (const auto& position : positions)
+	{
+		modelMatrices.push_back(getModelMatrix(position, glm::vec3(0.0f)));
+	}
+
+	for (const auto& mesh : meshes)
+	{
+		mesh.render(shaderHandler, modelMatrices);
+	}
+}
+
 #ifdef GAME
 void Model::render(ShaderHandler& shaderHandler, eFactionController owningFactionController, const glm::vec3& position, 
 	glm::vec3 rotation, bool highlight) const
@@ -22,6 +22,7 @@ struct Model
 	void render(ShaderHandler& shaderHandler, const glm::vec3& position, const glm::vec3& additionalColor, float opacity,
 		glm::vec3 rotation = glm::vec3(0.0f)) const;
 	void render(ShaderHandler& shaderHandler, const glm::vec3& position, glm::vec3 rotation = glm::vec3(0.0f), bool highlight = false) const;
+	void render(ShaderHandler& shaderHandler, const std::vector<glm::vec3>& positions, std::vector<glm::mat4>& modelMatrices) const;
 #ifdef GAME
 	void render(ShaderHandler& shaderHandler, eFactionController owningFactionController, const glm::vec3& position,
 		glm::vec3 rotation, bool highlight = false) const;
@@ -46,6 +47,7 @@ private:
 		const std::string& fileName, std::vector<Mesh>&& meshes);
 
 	void attachMeshesToVAO() const;
+	glm::mat4 getModelMatrix(glm::vec3 position, const glm::vec3& rotation) const;
 	void setModelMatrix(ShaderHandler& shaderHandler, glm::vec3 position, const glm::vec3& rotation) const;
 #ifdef LEVEL_EDITOR
 	void setModelMatrix(ShaderHandler& shaderHandler, const GameObject& gameObject) const;
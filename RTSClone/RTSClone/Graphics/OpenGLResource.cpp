@@ -5,7 +5,9 @@
 OpenGLResourceBuffer::OpenGLResourceBuffer(GLenum target)
 	: target(target)
 {
+#ifndef HEADLESS
 	glGenBuffers(1, &id);
+#endif // HEADLESS
 }
 
 OpenGLResourceBuffer::OpenGLResourceBuffer(OpenGLResourceBuffer&& rhs) noexcept
@@ -23,15 +25,19 @@ OpenGLResourceBuffer& OpenGLResourceBuffer::operator=(OpenGLResourceBuffer&& rhs
 
 OpenGLResourceBuffer::~OpenGLResourceBuffer()
 {
+#ifndef HEADLESS
 	if (id != 0)
 	{
 		glDeleteBuffers(1, &id);
 	}
+#endif // HEADLESS
 }
 
 void OpenGLResourceBuffer::bind() const
 {
+#ifndef HEADLESS
 	glBindBuffer(target, id);
+#endif // HEADLESS
 }
 
 unsigned int OpenGLResourceBuffer::getID() const
@@ -41,7 +47,9 @@ unsigned int OpenGLResourceBuffer::getID() const
 
 OpenGLResourceVertexArray::OpenGLResourceVertexArray()
 {
+#ifndef HEADLESS
 	glGenVertexArrays(1, &id);
+#endif // HEADLESS
 }
 
 OpenGLResourceVertexArray::OpenGLResourceVertexArray(OpenGLResourceVertexArray&& rhs) noexcept
@@ -57,10 +65,12 @@ OpenGLResourceVertexArray& OpenGLResourceVertexArray::operator=(OpenGLResourceVe
 
 OpenGLResourceVertexArray::~OpenGLResourceVertexArray()
 {
+#ifndef HEADLESS
 	if (id != 0)
 	{
 		glDeleteVertexArrays(1, &id);
 	}
+#endif // HEADLESS
 }
 
 unsigned int OpenGLResourceVertexArray::getID() const
@@ -70,5 +80,7 @@ unsigned int OpenGLResourceVertexArray::getID() const
 
 void OpenGLResourceVertexArray::bind() const
 {
+#ifndef HEADLESS
 	glBindVertexArray(id);
+#endif // HEADLESS
 }
\ No newline at end of file
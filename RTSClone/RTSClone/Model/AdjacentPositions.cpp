@@ -2,6 +2,7 @@
 #include "Core/Map.h"
 #include "Core/Globals.h"
 #include "Factions/FactionHandler.h"
+#include "Core/PathFinding.h"
 
 const std::array<glm::ivec2, 8> ALL_DIRECTIONS_ON_GRID =
 {
@@ -36,8 +37,14 @@ AdjacentPositions createAdjacentPositions(const Map& map)
 	return [&](const glm::ivec2& position) { return getAdjacentPositions(position, map); };
 }
 
+//Units steering round each other don't have to path round where others stand
 AdjacentPositions createAdjacentPositions(const Map& map, const Unit& unit)
 {
+	if (PathFinding::getInstance().isLocalAvoidance())
+	{
+		return createAdjacentPositions(map);
+	}
+
 	return [&](const glm::ivec2& position) { return getAdjacentPositions(position, map, unit); };
 }
 
@@ -60,10 +67,8 @@ AdjacentPositionsContainer getAdjacentPositions(const glm::ivec2 & position,
 
 AdjacentPositionsContainer getRandomAdjacentPositions(const glm::ivec2& position, const Map& map, const AABB& ignoreAABB)
 {
-	static std::random_device rd;
-	static std::mt19937 g(rd());
 	std::array<glm::ivec2, 8> shuffledAllDirectionsOnGrid = ALL_DIRECTIONS_ON_GRID;
-	std::shuffle(shuffledAllDirectionsOnGrid.begin(), shuffledAllDirectionsOnGrid.end(), g);
+	std::shuffle(shuffledAllDirectionsOnGrid.begin(), shuffledAllDirectionsOnGrid.end(), Globals::getRandomEngine());
 
 	AdjacentPositionsContainer adjacentPositions;
 	for (int i = 0; i < adjacentPositions.size(); ++i)
@@ -84,10 +89,8 @@ AdjacentPositionsContainer getRandomAdjacentPositions(const glm::ivec2& position
 
 AdjacentPositionsContainer getRandomAdjacentPositions(const glm::ivec2& position, const Map& map, const Unit& unit)
 {
-	static std::random_device rd;
-	static std::mt19937 g(rd());
 	std::array<glm::ivec2, 8> shuffledAllDirectionsOnGrid = ALL_DIRECTIONS_ON_GRID;
-	std::shuffle(shuffledAllDirectionsOnGrid.begin(), shuffledAllDirectionsOnGrid.end(), g);
+	std::shuffle(shuffledAllDirectionsOnGrid.begin(), shuffledAllDirectionsOnGrid.end(), Globals::getRandomEngine());
 
 	AdjacentPositionsContainer adjacentPositions;
 	for (int i = 0; i < adjacentPositions.size(); ++i)
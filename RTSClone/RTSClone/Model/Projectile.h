@@ -1,26 +0,0 @@
-#pragma once
-
-#include "Events/GameEvents.h"
-#include "Core/AABB.h"
-#include <functional>
-
-struct Model;
-class ShaderHandler;
-class Projectile
-{
-public:
-	Projectile(const SpawnProjectileEvent& gameEvent);
-	
-	const AABB& getAABB() const;
-	const SpawnProjectileEvent& getSenderEvent() const;
-	bool isReachedDestination() const;
-
-	void update(float deltaTime);
-	void render(ShaderHandler& shaderHandler) const;
-
-private:
-	SpawnProjectileEvent m_senderEvent;
-	glm::vec3 m_position;
-	AABB m_AABB;
-	std::reference_wrapper<const Model> m_model;
-};
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include "Model/ProjectilePool.h"
+#include "Graphics/ShaderHandler.h"
+#include "Graphics/ModelManager.h"
+#include "Graphics/Model.h"
+#include "Factions/FactionHandler.h"
+#include <assert.h>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	constexpr float MOVEMENT_SPEED = 100.0f;
+
+	template <typename T>
+	void compact(std::vector<T>& components, const std::vector<uint8_t>& removed)
+	{
+		size_t kept = 0;
+		for (size_t i = 0; i < components.size(); ++i)
+		{
+			components[kept] = components[i];
+			kept += !removed[i];
+		}
+		components.resize(kept);
+	}
+}
+
+ProjectilePool::ProjectilePool()
+	: m_senderEvents(),
+	m_positions(),
+	m_previousPositions(),
+	m_destinations(),
+	m_targetHandles(),
+	m_targets(),
+	m_targetBounds(),
+	m_targetHandlesByID(),
+	m_freeTargetHandles(),
+	m_hits(),
+	m_removals(),
+	m_removed(),
+	m_removedCount(0),
+	m_renderPositions(),
+	m_renderModelMatrices(),
+	m_model(&ModelManager::getInstance().getModel(PROJECTILE_MODEL_NAME))
+{}
+
+size_t ProjectilePool::getSize() const
+{
+	return m_senderEvents.size() - m_removedCount;
+}
+
+void ProjectilePool::add(const SpawnProjectileEvent& gameEvent)
+{
+	m_senderEvents.push_back(gameEvent);
+	m_positions.x.push_back(gameEvent.spawnPosition.x);
+	m_positions.y.push_back(gameEvent.spawnPosition.y);
+	m_positions.z.push_back(gameEvent.spawnPosition.z);
+	m_previousPositions.x.push_back(gameEvent.spawnPosition.x);
+	m_previousPositions.y.push_back(gameEvent.spawnPosition.y);
+	m_previousPositions.z.push_back(gameEvent.spawnPosition.z);
+	m_destinations.x.push_back(gameEvent.destination.x);
+	m_destinations.y.push_back(gameEvent.destination.y);
+	m_destinations.z.push_back(gameEvent.destination.z);
+	m_targetHandles.push_back(addTarget(gameEvent));
+	m_removed.push_back(false);
+}
+
+void ProjectilePool::update(float deltaTime, const FactionHandler& factionHandler, std::vector<TakeDamageEvent>& hits)
+{
+	gatherTargets(factionHandler);
+	move(deltaTime);
+	remove(hits);
+}
+
+void ProjectilePool::render(ShaderHandler& shaderHandler, float interpolation) const
+{
+	m_renderPositions.clear();
+	for (size_t i = 0; i < m_senderEvents.size(); ++i)
+	{
+		if (m_removed[i])
+		{
+			continue;
+		}
+
+		m_renderPositions.emplace_back(
+			m_previousPositions.x[i] + (m_positions.x[i] - m_previousPositions.x[i]) * interpolation,
+			m_previousPositions.y[i] + (m_positions.y[i] - m_previousPositions.y[i]) * interpolation,
+			m_previousPositions.z[i] + (m_positions.z[i] - m_previousPositions.z[i]) * interpolation);
+	}
+
+	m_model->render(shaderHandler, m_renderPositions, m_renderModelMatrices);
+}
+
+//IDs are unique across factions
+int ProjectilePool::addTarget(const SpawnProjectileEvent& gameEvent)
+{
+	const auto targetHandle = m_targetHandlesByID.find(gameEvent.targetID);
+	if (targetHandle != m_targetHandlesByID.cend())
+	{
+		assert(m_targets[targetHandle->second].faction == gameEvent.targetFaction);
+		++m_targets[targetHandle->second].projectileCount;
+		return targetHandle->second;
+	}
+
+	int handle = static_cast<int>(m_targets.size());
+	if (!m_freeTargetHandles.empty())
+	{
+		handle = m_freeTargetHandles.back();
+		m_freeTargetHandles.pop_back();
+		m_targets[handle] = { gameEvent.targetFaction, gameEvent.targetID, 1 };
+	}
+	else
+	{
+		m_targets.push_back({ gameEvent.targetFaction, gameEvent.targetID, 1 });
+	}
+
+	m_targetHandlesByID.emplace(gameEvent.targetID, handle);
+	return handle;
+}
+
+void ProjectilePool::removeTarget(int targetHandle)
+{
+	assert(targetHandle >= 0 && targetHandle < static_cast<int>(m_targets.size()) && m_targets[targetHandle].projectileCount > 0);
+	if (--m_targets[targetHandle].projectileCount == 0)
+	{
+		m_targetHandlesByID.erase(m_targets[targetHandle].ID);
+		m_freeTargetHandles.push_back(targetHandle);
+	}
+}
+
+//A target that's gone gets bounds nothing can overlap
+void ProjectilePool::gatherTargets(const FactionHandler& factionHandler)
+{
+	const size_t size = m_targets.size();
+	m_targetBounds.left.resize(size);
+	m_targetBounds.right.resize(size);
+	m_targetBounds.bottom.resize(size);
+	m_targetBounds.top.resize(size);
+	m_targetBounds.back.resize(size);
+	m_targetBounds.forward.resize(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		const Entity* target = nullptr;
+		const Faction* targetFaction = m_targets[i].projectileCount > 0 ? factionHandler.getFaction(m_targets[i].faction) : nullptr;
+		if (targetFaction)
+		{
+			target = targetFaction->get_entity(m_targets[i].ID);
+		}
+
+		if (target)
+		{
+			const AABB& targetAABB = target->getAABB();
+			m_targetBounds.left[i] = targetAABB.getLeft();
+			m_targetBounds.right[i] = targetAABB.getRight();
+			m_targetBounds.bottom[i] = targetAABB.getBottom();
+			m_targetBounds.top[i] = targetAABB.getTop();
+			m_targetBounds.back[i] = targetAABB.getBack();
+			m_targetBounds.forward[i] = targetAABB.getForward();
+		}
+		else
+		{
+			m_targetBounds.left[i] = std::numeric_limits<float>::infinity();
+			m_targetBounds.right[i] = -std::numeric_limits<float>::infinity();
+			m_targetBounds.bottom[i] = std::numeric_limits<float>::infinity();
+			m_targetBounds.top[i] = -std::numeric_limits<float>::infinity();
+			m_targetBounds.back[i] = std::numeric_limits<float>::infinity();
+			m_targetBounds.forward[i] = -std::numeric_limits<float>::infinity();
+		}
+	}
+}
+
+//Globals::moveTowards without a branch, so it runs over several projectiles at once, then each projectile's AABB
+//against its target's
+void ProjectilePool::move(float deltaTime)
+{
+	const size_t size = m_senderEvents.size();
+	const float maxDistance = MOVEMENT_SPEED * deltaTime;
+	assert(maxDistance >= 0.0f);
+	float* x = m_positions.x.data();
+	float* y = m_positions.y.data();
+	float* z = m_positions.z.data();
+	float* previousX = m_previousPositions.x.data();
+	float* previousY = m_previousPositions.y.data();
+	float* previousZ = m_previousPositions.z.data();
+	const float* destinationX = m_destinations.x.data();
+	const float* destinationY = m_destinations.y.data();
+	const float* destinationZ = m_destinations.z.data();
+	for (size_t i = 0; i < size; ++i)
+	{
+		previousX[i] = x[i];
+		previousY[i] = y[i];
+		previousZ[i] = z[i];
+
+		const float distanceX = destinationX[i] - x[i];
+		const float distanceY = destinationY[i] - y[i];
+		const float distanceZ = destinationZ[i] - z[i];
+		const float magnitude = std::sqrt(distanceX * distanceX + distanceY * distanceY + distanceZ * distanceZ);
+		const float step = maxDistance / magnitude;
+		const float movedX = x[i] + distanceX * step;
+		const float movedY = y[i] + distanceY * step;
+		const float movedZ = z[i] + distanceZ * step;
+		const bool arrived = magnitude <= maxDistance;
+		x[i] = arrived ? destinationX[i] : movedX;
+		y[i] = arrived ? destinationY[i] : movedY;
+		z[i] = arrived ? destinationZ[i] : movedZ;
+	}
+
+	m_hits.resize(size);
+	m_removals.resize(size);
+	const glm::vec3 halfSize = m_model->AABBSizeFromCenter;
+	for (size_t i = 0; i < size; ++i)
+	{
+		const int target = m_targetHandles[i];
+		const bool hit = !m_removed[i] & (m_targetBounds.left[target] < x[i] + halfSize.x) &
+			(m_targetBounds.right[target] > x[i] - halfSize.x) &
+			(m_targetBounds.top[target] > y[i] - halfSize.y) &
+			(m_targetBounds.bottom[target] < y[i] + halfSize.y) &
+			(m_targetBounds.forward[target] > z[i] - halfSize.z) &
+			(m_targetBounds.back[target] < z[i] + halfSize.z);
+		m_hits[i] = hit;
+		m_removals[i] = hit | (!m_removed[i] & (x[i] == destinationX[i]) & (y[i] == destinationY[i]) & (z[i] == destinationZ[i]));
+	}
+}
+
+void ProjectilePool::remove(std::vector<TakeDamageEvent>& hits)
+{
+	for (size_t i = 0; i < m_senderEvents.size(); ++i)
+	{
+		if (!m_removals[i])
+		{
+			continue;
+		}
+
+		const SpawnProjectileEvent& senderEvent = m_senderEvents[i];
+		if (m_hits[i])
+		{
+			hits.push_back({ senderEvent.senderFaction, senderEvent.senderID, senderEvent.senderEntityType,
+				senderEvent.targetFaction, senderEvent.targetID, senderEvent.damage });
+		}
+
+		m_removed[i] = true;
+		++m_removedCount;
+		removeTarget(m_targetHandles[i]);
+	}
+
+	if (m_removedCount * 2 > m_senderEvents.size())
+	{
+		compactRemoved();
+	}
+}
+
+void ProjectilePool::compactRemoved()
+{
+	compact(m_senderEvents, m_removed);
+	compact(m_positions.x, m_removed);
+	compact(m_positions.y, m_removed);
+	compact(m_positions.z, m_removed);
+	compact(m_previousPositions.x, m_removed);
+	compact(m_previousPositions.y, m_removed);
+	compact(m_previousPositions.z, m_removed);
+	compact(m_destinations.x, m_removed);
+	compact(m_destinations.y, m_removed);
+	compact(m_destinations.z, m_removed);
+	compact(m_targetHandles, m_removed);
+	m_removed.assign(m_senderEvents.size(), false);
+	m_removedCount = 0;
+}
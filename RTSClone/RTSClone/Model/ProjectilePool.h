@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Events/GameEvents.h"
+#include "glm/glm.hpp"
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+//Every projectile in flight, held as parallel arrays of components so the per tick pass moving them and
+//testing them against their targets runs over contiguous floats. Each projectile holds a handle to its target
+//shared with every other projectile fired at it - targets are looked up once a tick, however many projectiles
+//are on their way to them, and their AABB read from there in the same pass as the move.
+//Projectiles that hit or arrive are only marked and dropped together once they make up half the pool, keeping
+//the order the rest were fired in as hits are raised in that order.
+struct Model;
+class ShaderHandler;
+class FactionHandler;
+class ProjectilePool
+{
+public:
+	ProjectilePool();
+	ProjectilePool(const ProjectilePool&) = delete;
+	ProjectilePool& operator=(const ProjectilePool&) = delete;
+	ProjectilePool(ProjectilePool&&) noexcept = default;
+	ProjectilePool& operator=(ProjectilePool&&) noexcept = default;
+
+	size_t getSize() const;
+
+	void add(const SpawnProjectileEvent& gameEvent);
+	void update(float deltaTime, const FactionHandler& factionHandler, std::vector<TakeDamageEvent>& hits);
+	void render(ShaderHandler& shaderHandler, float interpolation) const;
+
+private:
+	struct Components
+	{
+		std::vector<float> x = {};
+		std::vector<float> y = {};
+		std::vector<float> z = {};
+	};
+
+	struct Bounds
+	{
+		std::vector<float> left		= {};
+		std::vector<float> right	= {};
+		std::vector<float> bottom	= {};
+		std::vector<float> top		= {};
+		std::vector<float> back		= {};
+		std::vector<float> forward	= {};
+	};
+
+	struct Target
+	{
+		eFactionController faction	= eFactionController::None;
+		int ID						= 0;
+		int projectileCount			= 0;
+	};
+
+	std::vector<SpawnProjectileEvent> m_senderEvents;
+	Components m_positions;
+	Components m_previousPositions;
+	Components m_destinations;
+	std::vector<int> m_targetHandles;
+	std::vector<Target> m_targets;
+	Bounds m_targetBounds;
+	std::unordered_map<int, int> m_targetHandlesByID;
+	std::vector<int> m_freeTargetHandles;
+	std::vector<uint8_t> m_hits;
+	std::vector<uint8_t> m_removals;
+	std::vector<uint8_t> m_removed;
+	size_t m_removedCount;
+	mutable std::vector<glm::vec3> m_renderPositions;
+	mutable std::vector<glm::mat4> m_renderModelMatrices;
+	const Model* m_model;
+
+	int addTarget(const SpawnProjectileEvent& gameEvent);
+	void removeTarget(int targetHandle);
+	void gatherTargets(const FactionHandler& factionHandler);
+	void move(float deltaTime);
+	void remove(std::vector<TakeDamageEvent>& hits);
+	void compactRemoved();
+};